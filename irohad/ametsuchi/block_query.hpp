@@ -29,6 +29,17 @@
 namespace iroha {
 
   namespace ametsuchi {
+    /**
+     * Page of account transactions history, transactions are ordered by
+     * their position in the ledger
+     */
+    struct TxPagination {
+      /// maximal number of transactions, 0 for the whole history
+      size_t page_size = 0;
+      /// hash of the last transaction of the previous page
+      boost::optional<shared_model::crypto::Hash> last_tx_hash;
+    };
+
     /**
      * Public interface for queries on blocks and transactions
      */
@@ -36,27 +47,32 @@ namespace iroha {
     protected:
       using wTransaction =
           std::shared_ptr<shared_model::interface::Transaction>;
-      using wBlock = std::shared_ptr<shared_model::interface::Block>;
+      // blocks may be shared with cache, so they are never modified
+      using wBlock = std::shared_ptr<const shared_model::interface::Block>;
 
      public:
       virtual ~BlockQuery() = default;
       /**
-       * Get all transactions of an account.
+       * Get transactions of an account.
        * @param account_id - account_id (accountName@domainName)
+       * @param pagination - page of history to retrieve
        * @return observable of Model Transaction
        */
       virtual rxcpp::observable<wTransaction> getAccountTransactions(
-          const shared_model::interface::types::AccountIdType &account_id) = 0;
+          const shared_model::interface::types::AccountIdType &account_id,
+          const TxPagination &pagination) = 0;
 
       /**
        * Get asset transactions of an account.
        * @param account_id - account_id (accountName@domainName)
        * @param asset_id - asset_id (assetName#domainName)
+       * @param pagination - page of history to retrieve
        * @return observable of Model Transaction
        */
       virtual rxcpp::observable<wTransaction> getAccountAssetTransactions(
           const shared_model::interface::types::AccountIdType &account_id,
-          const shared_model::interface::types::AssetIdType &asset_id) = 0;
+          const shared_model::interface::types::AssetIdType &asset_id,
+          const TxPagination &pagination) = 0;
 
       /**
        * Get transactions from transactions' hashes
@@ -89,6 +105,14 @@ namespace iroha {
        */
       virtual rxcpp::observable<wBlock> getTopBlocks(uint32_t count) = 0;
 
+      /**
+       * Synchronously gets block by its hash
+       * @param hash - hash of block to search
+       * @return block or boost::none
+       */
+      virtual boost::optional<wBlock> getBlockByHashSync(
+          const shared_model::crypto::Hash &hash) = 0;
+
       /**
        * Synchronously gets transaction by its hash
        * @param hash - hash to search
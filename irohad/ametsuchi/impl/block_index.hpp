@@ -38,8 +38,9 @@ namespace iroha {
       /**
        * Add block to index
        * @param block to be indexed
+       * @return true if all index rows of the block have been written
        */
-      virtual void index(const shared_model::interface::Block &) = 0;
+      virtual bool index(const shared_model::interface::Block &) = 0;
     };
   }  // namespace ametsuchi
 }  // namespace iroha
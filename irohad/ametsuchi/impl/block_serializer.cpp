@@ -0,0 +1,111 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/block_serializer.hpp"
+
+#include <algorithm>
+
+#include "backend/protobuf/from_old_model.hpp"
+#include "model/converters/json_common.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    const std::vector<uint8_t> BlockSerializer::kMagic = {'I', 'R', 'B', 'K'};
+    const uint32_t BlockSerializer::kVersion;
+    const size_t BlockSerializer::kHeaderSize;
+
+    namespace {
+      bool hasHeader(const uint8_t *data, size_t size) {
+        return size >= BlockSerializer::kHeaderSize
+            and std::equal(BlockSerializer::kMagic.begin(),
+                           BlockSerializer::kMagic.end(),
+                           data);
+      }
+
+      uint32_t readVersion(const uint8_t *data) {
+        const auto offset = BlockSerializer::kMagic.size();
+        uint32_t version = 0;
+        for (size_t i = 0; i < sizeof(version); ++i) {
+          version |= static_cast<uint32_t>(data[offset + i]) << (8 * i);
+        }
+        return version;
+      }
+    }  // namespace
+
+    BlockSerializer::BlockSerializer()
+        : log_(logger::log("BlockSerializer")) {}
+
+    std::vector<uint8_t> BlockSerializer::serialize(
+        const shared_model::interface::Block &block) const {
+      const auto &blob = block.blob().blob();
+      std::vector<uint8_t> result;
+      result.reserve(kHeaderSize + blob.size());
+      result.insert(result.end(), kMagic.begin(), kMagic.end());
+      for (size_t i = 0; i < sizeof(kVersion); ++i) {
+        result.push_back(static_cast<uint8_t>(kVersion >> (8 * i)));
+      }
+      result.insert(result.end(), blob.begin(), blob.end());
+      return result;
+    }
+
+    boost::optional<shared_model::proto::Block> BlockSerializer::deserialize(
+        const uint8_t *data, size_t size) const {
+      if (not hasHeader(data, size)) {
+        return deserializeLegacy(data, size);
+      }
+
+      auto version = readVersion(data);
+      if (version != kVersion) {
+        log_->error("Unsupported block format version {}", version);
+        return boost::none;
+      }
+
+      iroha::protocol::Block block;
+      if (not block.ParseFromArray(data + kHeaderSize,
+                                   static_cast<int>(size - kHeaderSize))) {
+        log_->error("Cannot parse block from binary record");
+        return boost::none;
+      }
+      return shared_model::proto::Block(std::move(block));
+    }
+
+    boost::optional<shared_model::proto::Block> BlockSerializer::deserialize(
+        const std::vector<uint8_t> &bytes) const {
+      return deserialize(bytes.data(), bytes.size());
+    }
+
+    bool BlockSerializer::isLegacy(const std::vector<uint8_t> &bytes) {
+      return not hasHeader(bytes.data(), bytes.size());
+    }
+
+    boost::optional<shared_model::proto::Block>
+    BlockSerializer::deserializeLegacy(const uint8_t *data,
+                                       size_t size) const {
+      return model::converters::stringToJson(
+                 std::string(reinterpret_cast<const char *>(data), size))
+          | [this](const auto &json) {
+              return json_factory_.deserialize(json);
+            }
+      | [](const auto &block) {
+          return boost::optional<shared_model::proto::Block>(
+              shared_model::proto::from_old(block));
+        };
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
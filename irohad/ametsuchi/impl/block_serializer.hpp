@@ -0,0 +1,96 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_BLOCK_SERIALIZER_HPP
+#define IROHA_BLOCK_SERIALIZER_HPP
+
+#include <boost/optional.hpp>
+#include <vector>
+
+#include "backend/protobuf/block.hpp"
+#include "logger/logger.hpp"
+#include "model/converters/json_block_factory.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Converts blocks to and from the representation kept in the block store.
+     * Stored record consists of a fixed-size header (magic and format
+     * version) followed by serialized iroha.protocol.Block.
+     * Records without the header are treated as legacy JSON blocks
+     */
+    class BlockSerializer {
+     public:
+      /**
+       * Magic bytes which start every binary block record
+       */
+      static const std::vector<uint8_t> kMagic;
+
+      /**
+       * Current version of the binary block format
+       */
+      static const uint32_t kVersion = 1;
+
+      /**
+       * Size of magic and version header in bytes
+       */
+      static const size_t kHeaderSize = 8;
+
+      BlockSerializer();
+
+      /**
+       * Serialize block to the binary block store format
+       * @param block - block to serialize
+       * @return bytes of the record
+       */
+      std::vector<uint8_t> serialize(
+          const shared_model::interface::Block &block) const;
+
+      /**
+       * Deserialize block from the block store record. Both binary and legacy
+       * JSON records are supported
+       * @param data - pointer to the first byte of the record
+       * @param size - size of the record
+       * @return block if record is valid, boost::none otherwise
+       */
+      boost::optional<shared_model::proto::Block> deserialize(
+          const uint8_t *data, size_t size) const;
+
+      /**
+       * @see deserialize(const uint8_t *, size_t)
+       */
+      boost::optional<shared_model::proto::Block> deserialize(
+          const std::vector<uint8_t> &bytes) const;
+
+      /**
+       * @param bytes - block store record
+       * @return true if record is in the legacy JSON format
+       */
+      static bool isLegacy(const std::vector<uint8_t> &bytes);
+
+     private:
+      boost::optional<shared_model::proto::Block> deserializeLegacy(
+          const uint8_t *data, size_t size) const;
+
+      mutable model::converters::JsonBlockFactory json_factory_;
+      logger::Logger log_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_BLOCK_SERIALIZER_HPP
@@ -0,0 +1,151 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/block_store_migration.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/format.hpp>
+
+#include "ametsuchi/impl/block_serializer.hpp"
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    expected::Result<size_t, std::string> migrateBlockStore(
+        const std::string &block_store_dir) {
+      namespace fs = boost::filesystem;
+      auto log = logger::log("BlockStoreMigration");
+
+      if (not fs::is_directory(block_store_dir)) {
+        return expected::makeError(
+            (boost::format("Block store %s does not exist") % block_store_dir)
+                .str());
+      }
+
+      auto source_path = fs::path{block_store_dir};
+      if (source_path.filename() == ".") {
+        // path with trailing separator
+        source_path = source_path.parent_path();
+      }
+      const auto target_path = fs::path{source_path.string() + ".migration"};
+      const auto backup_path = fs::path{source_path.string() + ".legacy"};
+      boost::system::error_code err;
+      if (fs::exists(backup_path, err)) {
+        return expected::makeError(
+            (boost::format("Backup %s of the previous migration exists, "
+                           "remove it first")
+             % backup_path.string())
+                .str());
+      }
+      fs::remove_all(target_path, err);
+
+      // blocks of the one-file-per-block layout are read directly, since
+      // FlatFile does not open such storage anymore
+      const bool legacy_layout = FlatFile::has_legacy_layout(block_store_dir);
+      boost::optional<std::unique_ptr<FlatFile>> source;
+      if (not legacy_layout) {
+        source = FlatFile::create(source_path.string());
+      }
+      auto target = FlatFile::create(target_path.string());
+      if ((not legacy_layout and not source) or not target) {
+        return expected::makeError(std::string("Cannot open block store"));
+      }
+
+      auto read = [&](FlatFile::Identifier id)
+          -> boost::optional<std::vector<uint8_t>> {
+        if (not legacy_layout) {
+          return (*source)->get(id);
+        }
+        const auto path = source_path / FlatFile::id_to_name(id);
+        boost::system::error_code err;
+        if (not fs::is_regular_file(path, err)) {
+          return boost::none;
+        }
+        std::vector<uint8_t> bytes(fs::file_size(path));
+        fs::ifstream file(path, std::ifstream::binary);
+        file.read(reinterpret_cast<char *>(bytes.data()), bytes.size());
+        if (not file) {
+          return boost::none;
+        }
+        return bytes;
+      };
+      auto has_next = [&](FlatFile::Identifier id) {
+        return legacy_layout
+            ? fs::exists(source_path / FlatFile::id_to_name(id))
+            : id <= (*source)->last_id();
+      };
+
+      BlockSerializer serializer;
+      size_t converted = 0;
+      FlatFile::Identifier id = 1;
+      for (; has_next(id); ++id) {
+        auto bytes = read(id);
+        if (not bytes) {
+          return expected::makeError(
+              (boost::format("Cannot read block %d") % id).str());
+        }
+        if (BlockSerializer::isLegacy(*bytes)) {
+          auto block = serializer.deserialize(*bytes);
+          if (not block) {
+            return expected::makeError(
+                (boost::format("Cannot parse legacy block %d") % id).str());
+          }
+          *bytes = serializer.serialize(*block);
+          ++converted;
+        }
+        if (not(*target)->add(id, *bytes)) {
+          return expected::makeError(
+              (boost::format("Cannot write block %d") % id).str());
+        }
+      }
+      log->info("{} of {} blocks converted", converted, id - 1);
+
+      // release file handles before directories are swapped
+      if (source) {
+        source->reset();
+      }
+      target->reset();
+
+      // original store is kept as backup until it is removed by user
+      fs::rename(source_path, backup_path, err);
+      if (err) {
+        return expected::makeError(
+            (boost::format("Cannot move block store to %s: %s")
+             % backup_path.string() % err.message())
+                .str());
+      }
+      fs::rename(target_path, source_path, err);
+      if (err) {
+        auto message = (boost::format("Cannot move migrated block store to "
+                                      "%s: %s")
+                        % source_path.string() % err.message())
+                           .str();
+        fs::rename(backup_path, source_path, err);
+        return expected::makeError(message);
+      }
+      log->info("Original block store is kept in {}, remove it when the "
+                "migrated one is verified",
+                backup_path.string());
+
+      return expected::Value<size_t>{converted};
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
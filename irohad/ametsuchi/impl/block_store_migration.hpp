@@ -0,0 +1,44 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_BLOCK_STORE_MIGRATION_HPP
+#define IROHA_BLOCK_STORE_MIGRATION_HPP
+
+#include <string>
+
+#include "common/result.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Rewrite block store in the current binary block format and segmented
+     * layout. Stores in the legacy one-file-per-block layout are supported.
+     * Blocks are written to a sibling directory first, which then replaces
+     * the original one, so an interrupted migration leaves the original
+     * store untouched. The original store is kept in a sibling ".legacy"
+     * directory, which must be removed before the next migration
+     * @param block_store_dir - folder of block store to migrate
+     * @return number of blocks converted from the legacy JSON format or error
+     */
+    expected::Result<size_t, std::string> migrateBlockStore(
+        const std::string &block_store_dir);
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_BLOCK_STORE_MIGRATION_HPP
@@ -0,0 +1,102 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/cached_wsv_query.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    using shared_model::interface::types::AccountIdType;
+    using shared_model::interface::types::AssetIdType;
+    using shared_model::interface::types::DomainIdType;
+    using shared_model::interface::types::PermissionNameType;
+    using shared_model::interface::types::PubkeyType;
+    using shared_model::interface::types::RoleIdType;
+
+    CachedWsvQuery::CachedWsvQuery(std::shared_ptr<WsvQuery> wsv,
+                                   std::shared_ptr<WsvCache> cache)
+        : wsv_(std::move(wsv)), cache_(std::move(cache)) {}
+
+    boost::optional<std::vector<RoleIdType>> CachedWsvQuery::getAccountRoles(
+        const AccountIdType &account_id) {
+      return cached(cache_->account_roles, account_id, [&] {
+        return wsv_->getAccountRoles(account_id);
+      });
+    }
+
+    boost::optional<std::vector<PermissionNameType>>
+    CachedWsvQuery::getRolePermissions(const RoleIdType &role_name) {
+      return cached(cache_->role_permissions, role_name, [&] {
+        return wsv_->getRolePermissions(role_name);
+      });
+    }
+
+    boost::optional<std::shared_ptr<shared_model::interface::Account>>
+    CachedWsvQuery::getAccount(const AccountIdType &account_id) {
+      return cached(cache_->accounts, account_id, [&] {
+        return wsv_->getAccount(account_id);
+      });
+    }
+
+    boost::optional<std::string> CachedWsvQuery::getAccountDetail(
+        const AccountIdType &account_id) {
+      return wsv_->getAccountDetail(account_id);
+    }
+
+    boost::optional<std::vector<PubkeyType>> CachedWsvQuery::getSignatories(
+        const AccountIdType &account_id) {
+      return cached(cache_->signatories, account_id, [&] {
+        return wsv_->getSignatories(account_id);
+      });
+    }
+
+    boost::optional<std::shared_ptr<shared_model::interface::Asset>>
+    CachedWsvQuery::getAsset(const AssetIdType &asset_id) {
+      return cached(
+          cache_->assets, asset_id, [&] { return wsv_->getAsset(asset_id); });
+    }
+
+    boost::optional<std::shared_ptr<shared_model::interface::AccountAsset>>
+    CachedWsvQuery::getAccountAsset(const AccountIdType &account_id,
+                                    const AssetIdType &asset_id) {
+      return wsv_->getAccountAsset(account_id, asset_id);
+    }
+
+    boost::optional<std::vector<std::shared_ptr<shared_model::interface::Peer>>>
+    CachedWsvQuery::getPeers() {
+      return wsv_->getPeers();
+    }
+
+    boost::optional<std::vector<RoleIdType>> CachedWsvQuery::getRoles() {
+      return wsv_->getRoles();
+    }
+
+    boost::optional<std::shared_ptr<shared_model::interface::Domain>>
+    CachedWsvQuery::getDomain(const DomainIdType &domain_id) {
+      return wsv_->getDomain(domain_id);
+    }
+
+    bool CachedWsvQuery::hasAccountGrantablePermission(
+        const AccountIdType &permitee_account_id,
+        const AccountIdType &account_id,
+        const PermissionNameType &permission_id) {
+      return wsv_->hasAccountGrantablePermission(
+          permitee_account_id, account_id, permission_id);
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
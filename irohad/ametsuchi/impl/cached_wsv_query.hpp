@@ -0,0 +1,103 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_CACHED_WSV_QUERY_HPP
+#define IROHA_CACHED_WSV_QUERY_HPP
+
+#include "ametsuchi/wsv_query.hpp"
+
+#include "ametsuchi/impl/wsv_cache.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Wsv query which serves accounts, assets, signatories, account roles
+     * and role permissions from the cache, reading them from the underlying
+     * query on cache miss
+     */
+    class CachedWsvQuery : public WsvQuery {
+     public:
+      CachedWsvQuery(std::shared_ptr<WsvQuery> wsv,
+                     std::shared_ptr<WsvCache> cache);
+
+      boost::optional<std::vector<shared_model::interface::types::RoleIdType>>
+      getAccountRoles(const shared_model::interface::types::AccountIdType
+                          &account_id) override;
+
+      boost::optional<
+          std::vector<shared_model::interface::types::PermissionNameType>>
+      getRolePermissions(
+          const shared_model::interface::types::RoleIdType &role_name) override;
+
+      boost::optional<std::shared_ptr<shared_model::interface::Account>>
+      getAccount(const shared_model::interface::types::AccountIdType
+                     &account_id) override;
+      boost::optional<std::string> getAccountDetail(
+          const shared_model::interface::types::AccountIdType &account_id)
+          override;
+      boost::optional<std::vector<shared_model::interface::types::PubkeyType>>
+      getSignatories(const shared_model::interface::types::AccountIdType
+                         &account_id) override;
+      boost::optional<std::shared_ptr<shared_model::interface::Asset>> getAsset(
+          const shared_model::interface::types::AssetIdType &asset_id) override;
+      boost::optional<std::shared_ptr<shared_model::interface::AccountAsset>>
+      getAccountAsset(
+          const shared_model::interface::types::AccountIdType &account_id,
+          const shared_model::interface::types::AssetIdType &asset_id) override;
+      boost::optional<
+          std::vector<std::shared_ptr<shared_model::interface::Peer>>>
+      getPeers() override;
+      boost::optional<std::vector<shared_model::interface::types::RoleIdType>>
+      getRoles() override;
+      boost::optional<std::shared_ptr<shared_model::interface::Domain>>
+      getDomain(const shared_model::interface::types::DomainIdType &domain_id)
+          override;
+      bool hasAccountGrantablePermission(
+          const shared_model::interface::types::AccountIdType
+              &permitee_account_id,
+          const shared_model::interface::types::AccountIdType &account_id,
+          const shared_model::interface::types::PermissionNameType
+              &permission_id) override;
+
+     private:
+      /**
+       * Get value from the table, or read it with the given function and
+       * store it in the table if it is present
+       */
+      template <typename ValueType, typename Read>
+      boost::optional<ValueType> cached(WsvCache::Table<ValueType> &table,
+                                        const std::string &key,
+                                        Read &&read) {
+        if (auto value = table.get(key)) {
+          return value;
+        }
+        auto value = read();
+        if (value) {
+          table.load(key, *value);
+        }
+        return value;
+      }
+
+      std::shared_ptr<WsvQuery> wsv_;
+      std::shared_ptr<WsvCache> cache_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_CACHED_WSV_QUERY_HPP
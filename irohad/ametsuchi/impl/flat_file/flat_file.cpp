@@ -16,17 +16,411 @@
  */
 
 #include "ametsuchi/impl/flat_file/flat_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <boost/crc.hpp>
 #include <boost/filesystem.hpp>
-#include <boost/range/adaptor/indexed.hpp>
-#include <boost/range/algorithm/find_if.hpp>
 #include <iomanip>
-#include <iostream>
+#include <mutex>
 #include <sstream>
 #include "common/files.hpp"
 
 using namespace iroha::ametsuchi;
 using Identifier = FlatFile::Identifier;
 
+namespace {
+  const char *kSegmentExtension = ".seg";
+  const char *kIndexExtension = ".idx";
+
+  /**
+   * Header written in segment before every entity
+   */
+  struct RecordHeader {
+    uint32_t size;
+    uint32_t crc;
+  };
+
+  /**
+   * Location of entity in segment
+   */
+  struct IndexEntry {
+    uint64_t offset;
+    uint32_t size;
+    uint32_t crc;
+  };
+
+  static_assert(sizeof(IndexEntry) == 16, "Index entry must not be padded");
+
+  uint32_t checksum(const uint8_t *data, size_t size) {
+    boost::crc_32_type crc;
+    crc.process_bytes(data, size);
+    return crc.checksum();
+  }
+
+  boost::filesystem::path segmentPath(const std::string &dump_dir,
+                                      Identifier first_id) {
+    return boost::filesystem::path{dump_dir}
+    / (FlatFile::id_to_name(first_id) + kSegmentExtension);
+  }
+
+  boost::filesystem::path indexPath(const std::string &dump_dir,
+                                    Identifier first_id) {
+    return boost::filesystem::path{dump_dir}
+    / (FlatFile::id_to_name(first_id) + kIndexExtension);
+  }
+
+  bool readAll(int fd, void *data, size_t size, uint64_t offset) {
+    auto buf = static_cast<char *>(data);
+    while (size > 0) {
+      auto res = ::pread(fd, buf, size, offset);
+      if (res <= 0) {
+        return false;
+      }
+      buf += res;
+      size -= res;
+      offset += res;
+    }
+    return true;
+  }
+
+  bool writeAll(int fd, const void *data, size_t size) {
+    auto buf = static_cast<const char *>(data);
+    while (size > 0) {
+      auto res = ::write(fd, buf, size);
+      if (res <= 0) {
+        return false;
+      }
+      buf += res;
+      size -= res;
+    }
+    return true;
+  }
+
+  void closeDescriptors(int fd, int index_fd) {
+    for (auto descriptor : {fd, index_fd}) {
+      if (descriptor >= 0) {
+        ::close(descriptor);
+      }
+    }
+  }
+
+  /**
+   * Map part of file to memory for reading
+   * @param fd - file descriptor
+   * @param offset - offset of the first mapped byte, aligned to page size
+   * @param size - number of mapped bytes
+   * @return mapping which is unmapped when the last reference is released
+   */
+  std::shared_ptr<const void> mapFile(int fd, uint64_t offset, size_t size) {
+    auto mapped = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, offset);
+    if (mapped == MAP_FAILED) {
+      return nullptr;
+    }
+    return std::shared_ptr<const void>(mapped, [size](const void *ptr) {
+      ::munmap(const_cast<void *>(ptr), size);
+    });
+  }
+
+  template <typename T>
+  void appendBytes(std::vector<uint8_t> &dst, const T &value) {
+    auto begin = reinterpret_cast<const uint8_t *>(&value);
+    dst.insert(dst.end(), begin, begin + sizeof(T));
+  }
+
+  /**
+   * Check that the record at index entry is completely written
+   * @param fd - descriptor of segment file
+   * @param segment_size - size of segment file
+   * @param entry - index entry of record
+   * @param verify_data - whether payload checksum should be verified
+   * @return true if record is valid
+   */
+  bool validRecord(int fd,
+                   uint64_t segment_size,
+                   const IndexEntry &entry,
+                   bool verify_data) {
+    RecordHeader header{};
+    if (entry.offset + sizeof(header) + entry.size > segment_size
+        or not readAll(fd, &header, sizeof(header), entry.offset)
+        or header.size != entry.size or header.crc != entry.crc) {
+      return false;
+    }
+    if (not verify_data) {
+      return true;
+    }
+    std::vector<uint8_t> payload(entry.size);
+    return readAll(fd, payload.data(), payload.size(),
+                   entry.offset + sizeof(header))
+        and checksum(payload.data(), payload.size()) == entry.crc;
+  }
+
+  /**
+   * Rebuild index of segment by scanning its records
+   * @param fd - descriptor of segment file
+   * @param segment_size - size of segment file
+   * @return entries of valid records from the beginning of segment
+   */
+  std::vector<IndexEntry> scanSegment(int fd, uint64_t segment_size) {
+    std::vector<IndexEntry> entries;
+    uint64_t offset = 0;
+    RecordHeader header{};
+    while (readAll(fd, &header, sizeof(header), offset)) {
+      IndexEntry entry{offset, header.size, header.crc};
+      if (not validRecord(fd, segment_size, entry, true)) {
+        break;
+      }
+      entries.push_back(entry);
+      offset += sizeof(header) + header.size;
+    }
+    return entries;
+  }
+
+  /**
+   * Bring segment and its index to consistent state: drop index entries
+   * which point to torn records, rebuild missing index and truncate segment
+   * after the last indexed record
+   * @param segment - segment file
+   * @param index - index file
+   * @return number of records in segment
+   */
+  boost::optional<Identifier> recoverSegment(
+      const boost::filesystem::path &segment,
+      const boost::filesystem::path &index) {
+    auto fd = ::open(segment.c_str(), O_RDWR);
+    if (fd < 0) {
+      return boost::none;
+    }
+    const auto segment_size = boost::filesystem::file_size(segment);
+
+    std::vector<IndexEntry> rebuilt;
+    uint64_t count = 0;
+    if (boost::filesystem::exists(index)) {
+      count = boost::filesystem::file_size(index) / sizeof(IndexEntry);
+    } else {
+      rebuilt = scanSegment(fd, segment_size);
+      count = rebuilt.size();
+    }
+
+    auto idx = ::open(index.c_str(), O_RDWR | O_CREAT, 0644);
+    if (idx < 0) {
+      ::close(fd);
+      return boost::none;
+    }
+    if (not rebuilt.empty()) {
+      writeAll(idx, rebuilt.data(), rebuilt.size() * sizeof(IndexEntry));
+    }
+
+    // only the tail may be torn, so checking from the end is O(1) normally
+    IndexEntry last{};
+    while (count > 0) {
+      readAll(idx, &last, sizeof(last), (count - 1) * sizeof(IndexEntry));
+      if (validRecord(fd, segment_size, last, true)) {
+        break;
+      }
+      --count;
+    }
+    auto data_end = count > 0 ? last.offset + sizeof(RecordHeader) + last.size
+                              : uint64_t{0};
+
+    auto res = ::ftruncate(idx, count * sizeof(IndexEntry)) == 0
+        and ::ftruncate(fd, data_end) == 0;
+    ::close(idx);
+    ::close(fd);
+    if (not res) {
+      return boost::none;
+    }
+    return count;
+  }
+
+  /**
+   * @return first keys of all segments in folder in ascending order
+   */
+  std::vector<Identifier> listSegments(const std::string &dump_dir) {
+    std::vector<Identifier> ids;
+    for (const auto &entry :
+         boost::filesystem::directory_iterator{dump_dir}) {
+      const auto &path = entry.path();
+      if (path.extension() == kSegmentExtension) {
+        try {
+          ids.push_back(std::stoul(path.stem().string()));
+        } catch (const std::exception &) {
+          // not a segment of this storage
+        }
+      }
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  }
+}  // namespace
+
+/**
+ * Open segment with descriptor for reads and its index. Descriptors of the
+ * last segment are opened for appending and kept open until it is sealed
+ */
+class FlatFile::Segment {
+ public:
+  Segment(Identifier first_id, int fd, int index_fd)
+      : first_id(first_id), fd_(fd), index_fd_(index_fd) {}
+
+  ~Segment() {
+    unmap();
+    ::close(fd_);
+    if (index_fd_ >= 0) {
+      ::close(index_fd_);
+    }
+  }
+
+  Segment(const Segment &) = delete;
+  Segment &operator=(const Segment &) = delete;
+
+  /**
+   * Read index into memory, so it can be appended
+   */
+  bool loadIndex(Identifier count) {
+    entries_.resize(count);
+    return count == 0
+        or readAll(index_fd_,
+                   entries_.data(),
+                   entries_.size() * sizeof(IndexEntry),
+                   0);
+  }
+
+  /**
+   * Map index file to memory, no more entities are appended after that
+   * @param count - number of entries in index
+   */
+  bool seal(Identifier count) {
+    if (count > 0) {
+      auto mapped = ::mmap(nullptr,
+                           count * sizeof(IndexEntry),
+                           PROT_READ,
+                           MAP_SHARED,
+                           index_fd_,
+                           0);
+      if (mapped == MAP_FAILED) {
+        return false;
+      }
+      mapped_ = static_cast<const IndexEntry *>(mapped);
+      mapped_count_ = count;
+    }
+    sealed_ = true;
+    entries_.clear();
+    entries_.shrink_to_fit();
+    ::close(index_fd_);
+    index_fd_ = -1;
+    return true;
+  }
+
+  Identifier size() const {
+    return mapped_ ? mapped_count_ : entries_.size();
+  }
+
+  const IndexEntry &entry(Identifier id) const {
+    auto pos = id - first_id;
+    return mapped_ ? mapped_[pos] : entries_[pos];
+  }
+
+  uint64_t end() const {
+    if (size() == 0) {
+      return 0;
+    }
+    const auto &last = entry(first_id + size() - 1);
+    return last.offset + sizeof(RecordHeader) + last.size;
+  }
+
+  /**
+   * Append record and its index entry. Segment is synced before the entry
+   * is written, so that index never points to data lost on crash
+   * @param record - header and data of entity
+   * @param entry - index entry of record
+   * @return true if both files are written and synced
+   */
+  bool append(const std::vector<uint8_t> &record, const IndexEntry &entry) {
+    if (writeAll(fd_, record.data(), record.size()) and ::fdatasync(fd_) == 0
+        and writeAll(index_fd_, &entry, sizeof(entry))
+        and ::fdatasync(index_fd_) == 0) {
+      entries_.push_back(entry);
+      return true;
+    }
+    // drop partially written data, so that the next record is placed at the
+    // indexed end
+    if (::ftruncate(fd_, entry.offset) != 0
+        or ::ftruncate(index_fd_, size() * sizeof(IndexEntry)) != 0) {
+      // torn tail is truncated by check_consistency on restart
+    }
+    return false;
+  }
+
+  int fd() const {
+    return fd_;
+  }
+
+  /**
+   * Get record of entity in memory. Sealed segment is mapped, while records
+   * of the active one are read into buffer, since the file still grows
+   * @param entry - index entry of record
+   * @return owner of memory and pointer to the first byte of entity in it,
+   * null owner if reading fails
+   */
+  std::pair<std::shared_ptr<const void>, const uint8_t *> map(
+      const IndexEntry &entry) const {
+    const auto data_offset = entry.offset + sizeof(RecordHeader);
+    if (sealed_) {
+      // sealed segment does not change, so it is mapped once as a whole
+      std::lock_guard<std::mutex> lock(mapping_mutex_);
+      if (not mapping_) {
+        mapping_ = mapFile(fd_, 0, end());
+      }
+      return {mapping_,
+              static_cast<const uint8_t *>(mapping_.get()) + data_offset};
+    }
+    auto buffer = std::make_shared<std::vector<uint8_t>>(entry.size);
+    if (not readAll(fd_, buffer->data(), buffer->size(), data_offset)) {
+      return {nullptr, nullptr};
+    }
+    const auto data = buffer->data();
+    return {std::shared_ptr<const void>(std::move(buffer), data), data};
+  }
+
+  const Identifier first_id;
+
+ private:
+  void unmap() {
+    if (mapped_) {
+      ::munmap(const_cast<IndexEntry *>(mapped_),
+               mapped_count_ * sizeof(IndexEntry));
+      mapped_ = nullptr;
+    }
+  }
+
+  int fd_;
+  int index_fd_;
+  std::vector<IndexEntry> entries_;
+  const IndexEntry *mapped_{nullptr};
+  Identifier mapped_count_{0};
+  bool sealed_{false};
+  mutable std::mutex mapping_mutex_;
+  mutable std::shared_ptr<const void> mapping_;
+};
+
+// ----------| BlobView |----------
+
+FlatFile::BlobView::BlobView(std::shared_ptr<const void> mapping,
+                             const uint8_t *data,
+                             size_t size)
+    : mapping_(std::move(mapping)), data_(data), size_(size) {}
+
+const uint8_t *FlatFile::BlobView::data() const {
+  return data_;
+}
+
+size_t FlatFile::BlobView::size() const {
+  return size_;
+}
+
 // ----------| public API |----------
 
 std::string FlatFile::id_to_name(Identifier id) {
@@ -36,7 +430,7 @@ std::string FlatFile::id_to_name(Identifier id) {
 }
 
 boost::optional<std::unique_ptr<FlatFile>> FlatFile::create(
-    const std::string &path) {
+    const std::string &path, uint64_t segment_size) {
   auto log_ = logger::log("FlatFile::create()");
 
   boost::system::error_code err;
@@ -46,64 +440,118 @@ boost::optional<std::unique_ptr<FlatFile>> FlatFile::create(
     return boost::none;
   }
 
+  if (has_legacy_layout(path)) {
+    log_->error(
+        "Storage in {} uses one file per block layout, "
+        "run iroha_migrate_block_store first",
+        path);
+    return boost::none;
+  }
+
   auto res = FlatFile::check_consistency(path);
-  return std::make_unique<FlatFile>(*res, path, private_tag{});
+  if (not res) {
+    return boost::none;
+  }
+  auto store =
+      std::make_unique<FlatFile>(*res, path, segment_size, private_tag{});
+  if (not store->load()) {
+    log_->error("Cannot open segments of storage {}", path);
+    return boost::none;
+  }
+  return boost::optional<std::unique_ptr<FlatFile>>(std::move(store));
 }
 
 bool FlatFile::add(Identifier id, const std::vector<uint8_t> &block) {
   // TODO(x3medima17): Change bool to generic Result return type
 
+  std::unique_lock<std::shared_timed_mutex> lock(segments_mutex_);
+
   if (id != current_id_ + 1) {
     log_->warn("Cannot append non-consecutive block");
     return false;
   }
 
-  auto next_id = id;
-  const auto file_name = boost::filesystem::path{dump_dir_} / id_to_name(id);
+  const RecordHeader header{static_cast<uint32_t>(block.size()),
+                            checksum(block.data(), block.size())};
 
-  // Write block to binary file
-  if (boost::filesystem::exists(file_name)) {
-    // File already exist
-    log_->warn("insertion for {} failed, because file already exists", id);
-    return false;
-  }
-  // New file will be created
-  boost::filesystem::ofstream file(file_name.native(), std::ofstream::binary);
-  if (not file.is_open()) {
-    log_->warn("Cannot open file by index {} for writing", id);
-    return false;
+  if (segments_.empty()
+      or (segments_.rbegin()->second->size() > 0
+          and segments_.rbegin()->second->end() + sizeof(header)
+                  + block.size()
+              > segment_size_)) {
+    if (not startSegment(id)) {
+      log_->warn("Cannot create segment for index {}", id);
+      return false;
+    }
   }
+  auto &segment = *segments_.rbegin()->second;
+  const IndexEntry entry{segment.end(), header.size, header.crc};
 
-  auto val_size =
-      sizeof(std::remove_reference<decltype(block)>::type::value_type);
+  std::vector<uint8_t> record;
+  record.reserve(sizeof(header) + block.size());
+  appendBytes(record, header);
+  record.insert(record.end(), block.begin(), block.end());
 
-  file.write(reinterpret_cast<const char *>(block.data()),
-             block.size() * val_size);
+  // record is written before its index entry, so torn writes are detected by
+  // check_consistency
+  if (not segment.append(record, entry)) {
+    log_->warn("Cannot write block with index {}", id);
+    return false;
+  }
 
   // Update internals, release lock
-  current_id_ = next_id;
+  current_id_ = id;
   return true;
 }
 
 boost::optional<std::vector<uint8_t>> FlatFile::get(Identifier id) const {
-  const auto filename =
-      boost::filesystem::path{dump_dir_} / FlatFile::id_to_name(id);
-  if (not boost::filesystem::exists(filename)) {
-    log_->info("get({}) file not found", id);
+  std::shared_lock<std::shared_timed_mutex> lock(segments_mutex_);
+
+  if (id == 0 or id > current_id_) {
+    log_->info("get({}) block not found", id);
     return boost::none;
   }
-  const auto fileSize = boost::filesystem::file_size(filename);
-  std::vector<uint8_t> buf;
-  buf.resize(fileSize);
-  boost::filesystem::ifstream file(filename, std::ifstream::binary);
-  if (not file.is_open()) {
-    log_->info("get({}) problem with opening file", id);
+  const auto &segment = *std::prev(segments_.upper_bound(id))->second;
+  const auto &entry = segment.entry(id);
+
+  std::vector<uint8_t> buf(entry.size);
+  if (not readAll(
+          segment.fd(), buf.data(), buf.size(), entry.offset + sizeof(RecordHeader))) {
+    log_->info("get({}) problem with reading segment", id);
+    return boost::none;
+  }
+  if (checksum(buf.data(), buf.size()) != entry.crc) {
+    log_->error("get({}) checksum mismatch", id);
     return boost::none;
   }
-  file.read(reinterpret_cast<char *>(buf.data()), fileSize);
   return buf;
 }
 
+boost::optional<FlatFile::BlobView> FlatFile::getView(Identifier id) const {
+  std::shared_lock<std::shared_timed_mutex> lock(segments_mutex_);
+
+  if (id == 0 or id > current_id_) {
+    log_->info("getView({}) block not found", id);
+    return boost::none;
+  }
+  const auto &segment = *std::prev(segments_.upper_bound(id))->second;
+  const auto &entry = segment.entry(id);
+  if (entry.size == 0) {
+    return BlobView(nullptr, nullptr, 0);
+  }
+
+  auto mapped = segment.map(entry);
+  if (not mapped.first) {
+    log_->info("getView({}) problem with reading segment", id);
+    return boost::none;
+  }
+  if (checksum(mapped.second, entry.size) != entry.crc) {
+    log_->error("getView({}) checksum mismatch", id);
+    return boost::none;
+  }
+  return BlobView(std::move(mapped.first), mapped.second, entry.size);
+}
+
 std::string FlatFile::directory() const {
   return dump_dir_;
 }
@@ -113,21 +561,100 @@ Identifier FlatFile::last_id() const {
 }
 
 void FlatFile::dropAll() {
+  std::unique_lock<std::shared_timed_mutex> lock(segments_mutex_);
+  segments_.clear();
   iroha::remove_dir_contents(dump_dir_);
   auto res = FlatFile::check_consistency(dump_dir_);
   current_id_.store(*res);
 }
 
+bool FlatFile::has_legacy_layout(const std::string &dump_dir) {
+  boost::system::error_code err;
+  if (not boost::filesystem::is_directory(dump_dir, err)) {
+    return false;
+  }
+  return std::any_of(
+      boost::filesystem::directory_iterator{dump_dir},
+      boost::filesystem::directory_iterator{},
+      [](const boost::filesystem::directory_entry &entry) {
+        auto name = entry.path().filename().string();
+        return name.size() == DIGIT_CAPACITY
+            and std::all_of(name.begin(), name.end(), ::isdigit);
+      });
+}
+
 // ----------| private API |----------
 
 FlatFile::FlatFile(Identifier current_id,
                    const std::string &path,
+                   uint64_t segment_size,
                    FlatFile::private_tag)
-    : dump_dir_(path) {
+    : dump_dir_(path), segment_size_(segment_size) {
   log_ = logger::log("FlatFile");
   current_id_.store(current_id);
 }
 
+FlatFile::~FlatFile() = default;
+
+bool FlatFile::load() {
+  const auto ids = listSegments(dump_dir_);
+  for (auto first_id : ids) {
+    // only the last segment is appended
+    const auto flags =
+        first_id == ids.back() ? O_RDWR | O_APPEND : O_RDONLY;
+    auto fd = ::open(segmentPath(dump_dir_, first_id).c_str(), flags);
+    auto index_fd = ::open(indexPath(dump_dir_, first_id).c_str(), flags);
+    if (fd < 0 or index_fd < 0) {
+      closeDescriptors(fd, index_fd);
+      return false;
+    }
+    segments_.emplace(first_id,
+                      std::make_unique<Segment>(first_id, fd, index_fd));
+  }
+
+  // all segments except the last one are never appended again
+  for (auto it = segments_.begin(); it != segments_.end(); ++it) {
+    auto next = std::next(it);
+    auto count = (next == segments_.end() ? current_id_ + 1 : next->first)
+        - it->first;
+    auto loaded = next == segments_.end() ? it->second->loadIndex(count)
+                                          : it->second->seal(count);
+    if (not loaded) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool FlatFile::startSegment(Identifier first_id) {
+  const auto segment = segmentPath(dump_dir_, first_id);
+  const auto index = indexPath(dump_dir_, first_id);
+  auto create = [](const boost::filesystem::path &path) {
+    return ::open(path.c_str(), O_RDWR | O_APPEND | O_CREAT | O_EXCL, 0644);
+  };
+  auto fd = create(segment);
+  if (fd < 0) {
+    return false;
+  }
+  auto index_fd = create(index);
+  if (index_fd < 0) {
+    ::close(fd);
+    boost::system::error_code err;
+    boost::filesystem::remove(segment, err);
+    return false;
+  }
+  if (not segments_.empty()) {
+    auto &last = *segments_.rbegin()->second;
+    if (not last.seal(last.size())) {
+      closeDescriptors(fd, index_fd);
+      return false;
+    }
+  }
+  segments_.emplace(first_id,
+                    std::make_unique<Segment>(first_id, fd, index_fd));
+  return true;
+}
+
 boost::optional<Identifier> FlatFile::check_consistency(
     const std::string &dump_dir) {
   auto log = logger::log("FLAT_FILE");
@@ -137,24 +664,27 @@ boost::optional<Identifier> FlatFile::check_consistency(
     return boost::none;
   }
 
-  auto const files = [&dump_dir] {
-    std::vector<boost::filesystem::path> ps;
-    std::copy(boost::filesystem::directory_iterator{dump_dir},
-              boost::filesystem::directory_iterator{},
-              std::back_inserter(ps));
-    std::sort(ps.begin(), ps.end(), std::less<boost::filesystem::path>());
-    return ps;
-  }();
-
-  auto const missing = boost::range::find_if(
-      files | boost::adaptors::indexed(1), [](const auto &it) {
-        return FlatFile::id_to_name(it.index()) != it.value().filename();
-      });
-
-  std::for_each(
-      missing.get(), files.cend(), [](const boost::filesystem::path &p) {
-        boost::filesystem::remove(p);
-      });
-
-  return missing.get() - files.cbegin();
+  Identifier last_id = 0;
+  bool consistent = true;
+  for (auto first_id : listSegments(dump_dir)) {
+    const auto segment = segmentPath(dump_dir, first_id);
+    const auto index = indexPath(dump_dir, first_id);
+    if (consistent and first_id == last_id + 1) {
+      if (auto count = recoverSegment(segment, index)) {
+        if (*count > 0) {
+          last_id += *count;
+          continue;
+        }
+      } else {
+        log->error("check_consistency({}), cannot recover segment {}",
+                   dump_dir,
+                   segment.string());
+      }
+    }
+    // everything after a gap is unreachable
+    consistent = false;
+    boost::filesystem::remove(segment);
+    boost::filesystem::remove(index);
+  }
+  return last_id;
 }
@@ -19,8 +19,10 @@
 #define IROHA_FLAT_FILE_HPP
 
 #include <atomic>
+#include <map>
 #include <memory>
 #include <boost/optional.hpp>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
@@ -30,7 +32,11 @@ namespace iroha {
   namespace ametsuchi {
 
     /**
-     * Solid storage based on raw files
+     * Solid storage based on raw files.
+     * Entities are appended to segment files of bounded size. Every segment
+     * has an index file with fixed-size (offset, size, checksum) entries, so
+     * entity lookup does not touch the file system and startup time depends
+     * on the number of segments only
      */
     class FlatFile {
       /**
@@ -49,6 +55,33 @@ namespace iroha {
 
       static const uint32_t DIGIT_CAPACITY = 16;
 
+      /**
+       * Read-only view of entity data placed in memory-mapped storage file,
+       * or in a buffer for the segment which is still appended. Memory is
+       * reference counted, so the data stays valid as long as the view
+       * exists, even if the storage is destroyed
+       */
+      class BlobView {
+       public:
+        BlobView(std::shared_ptr<const void> mapping,
+                 const uint8_t *data,
+                 size_t size);
+
+        const uint8_t *data() const;
+
+        size_t size() const;
+
+       private:
+        std::shared_ptr<const void> mapping_;
+        const uint8_t *data_;
+        size_t size_;
+      };
+
+      /**
+       * Default upper bound of segment file size in bytes
+       */
+      static const uint64_t DEFAULT_SEGMENT_SIZE = 256 * 1024 * 1024;
+
       /**
        * Convert id to a string representation. The string representation is
        * always DIGIT_CAPACITY-character width regardless of the value of `id`.
@@ -66,10 +99,12 @@ namespace iroha {
       /**
        * Create storage in paths
        * @param path - target path for creating
+       * @param segment_size - size after which new segment is started
        * @return created storage
        */
       static boost::optional<std::unique_ptr<FlatFile>> create(
-          const std::string &path);
+          const std::string &path,
+          uint64_t segment_size = DEFAULT_SEGMENT_SIZE);
 
       /**
        * Add entity with binary data
@@ -85,6 +120,14 @@ namespace iroha {
        */
       boost::optional<std::vector<uint8_t>> get(Identifier id) const;
 
+      /**
+       * Get data associated with key, data of sealed segments is not copied
+       * from storage file
+       * @param id - reference key
+       * @return - view of blob, if exists
+       */
+      boost::optional<BlobView> getView(Identifier id) const;
+
       /**
        * @return folder of storage
        */
@@ -97,14 +140,23 @@ namespace iroha {
 
       /**
        * Checking consistency of storage for provided folder
-       * If some block in the middle is missing all blocks following it are
-       * deleted
+       * Torn or corrupted records at the tail of a segment are truncated.
+       * If some segment in the middle is missing all segments following it
+       * are deleted
        * @param dump_dir - folder of storage
        * @return - last available identifier
        */
       static boost::optional<Identifier> check_consistency(
           const std::string &dump_dir);
 
+      /**
+       * Check whether folder contains storage written in the previous
+       * one-file-per-entity layout
+       * @param dump_dir - folder of storage
+       * @return true if at least one file of the legacy layout is present
+       */
+      static bool has_legacy_layout(const std::string &dump_dir);
+
       void dropAll();
 
       // ----------| modify operations |----------
@@ -123,12 +175,29 @@ namespace iroha {
        * Create storage in path with respect to last key
        * @param last_id - maximal key written in storage
        * @param path - folder of storage
+       * @param segment_size - size after which new segment is started
        */
       FlatFile(Identifier last_id,
                const std::string &path,
+               uint64_t segment_size,
                FlatFile::private_tag);
 
      private:
+      class Segment;
+
+      /**
+       * Open segments of consistent storage
+       * @return true if all segments were opened
+       */
+      bool load();
+
+      /**
+       * Start new segment with given first key
+       * @param first_id - key of the first entity in segment
+       * @return true if segment files were created
+       */
+      bool startSegment(Identifier first_id);
+
       // ----------| private fields |----------
 
       /**
@@ -141,10 +210,19 @@ namespace iroha {
        */
       const std::string dump_dir_;
 
+      const uint64_t segment_size_;
+
+      /**
+       * Segments by key of their first entity
+       */
+      std::map<Identifier, std::unique_ptr<Segment>> segments_;
+
+      mutable std::shared_timed_mutex segments_mutex_;
+
       logger::Logger log_;
 
      public:
-      ~FlatFile() = default;
+      ~FlatFile();
     };
   }  // namespace ametsuchi
 }  // namespace iroha
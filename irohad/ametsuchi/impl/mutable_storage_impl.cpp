@@ -20,9 +20,11 @@
 #include <boost/variant/apply_visitor.hpp>
 
 #include "ametsuchi/impl/postgres_block_index.hpp"
-#include "ametsuchi/impl/postgres_wsv_command.hpp"
+#include "ametsuchi/impl/cached_wsv_query.hpp"
+#include "ametsuchi/impl/postgres_overlay_storage.hpp"
 #include "ametsuchi/impl/postgres_wsv_query.hpp"
-#include "ametsuchi/wsv_command.hpp"
+#include "ametsuchi/impl/postgres_wsv_writer.hpp"
+#include "ametsuchi/impl/wsv_overlay.hpp"
 #include "backend/protobuf/from_old_model.hpp"
 #include "model/sha3_hash.hpp"
 
@@ -30,23 +32,45 @@ namespace iroha {
   namespace ametsuchi {
     MutableStorageImpl::MutableStorageImpl(
         shared_model::interface::types::HashType top_hash,
-        std::unique_ptr<pqxx::lazyconnection> connection,
+        PooledConnection connection,
         std::unique_ptr<pqxx::nontransaction> transaction)
         : top_hash_(top_hash),
           connection_(std::move(connection)),
           transaction_(std::move(transaction)),
-          wsv_(std::make_unique<PostgresWsvQuery>(*transaction_)),
-          executor_(std::make_unique<PostgresWsvCommand>(*transaction_)),
+          cache_(std::make_shared<WsvCache>()),
+          // changes of a block are kept in memory and written at once
+          wsv_(std::make_shared<WsvOverlay>(
+              std::make_shared<CachedWsvQuery>(
+                  std::make_shared<PostgresWsvQuery>(*transaction_), cache_),
+              std::make_shared<PostgresOverlayStorage>(*transaction_))),
+          writer_(std::make_unique<PostgresWsvWriter>(*transaction_)),
           block_index_(std::make_unique<PostgresBlockIndex>(*transaction_)),
+          command_executor_(std::make_shared<CommandExecutor>(wsv_, wsv_)),
           committed(false),
           log_(logger::log("MutableStorage")) {
-      auto query = std::make_shared<PostgresWsvQuery>(*transaction_);
-      auto command = std::make_shared<PostgresWsvCommand>(*transaction_);
-      command_executor_ =
-          std::make_shared<CommandExecutor>(CommandExecutor(query, command));
       transaction_->exec("BEGIN;");
     }
 
+    void MutableStorageImpl::updateCache(const WsvOverlay::Layer &changes) {
+      // accounts are read again, so that cache holds json data in the form
+      // returned by the storage
+      for (const auto &account : changes.accounts) {
+        cache_->accounts.invalidate(account.first);
+      }
+      for (const auto &asset : changes.assets) {
+        cache_->assets.write(asset.first, asset.second);
+      }
+      for (const auto &signatories : changes.signatories) {
+        cache_->signatories.write(signatories.first, signatories.second);
+      }
+      for (const auto &roles : changes.account_roles) {
+        cache_->account_roles.write(roles.first, roles.second);
+      }
+      for (const auto &permissions : changes.role_permissions) {
+        cache_->role_permissions.write(permissions.first, permissions.second);
+      }
+    }
+
     bool MutableStorageImpl::apply(
         const shared_model::interface::Block &block,
         std::function<bool(const shared_model::interface::Block &,
@@ -69,24 +93,45 @@ namespace iroha {
                            execute_command);
       };
 
-      transaction_->exec("SAVEPOINT savepoint_;");
+      // write set and index of the block are undone together, so that
+      // storage does not contain a partially applied block. The savepoint is
+      // sent in the same round trip as the changes, and another round trip
+      // is made only to roll back a failed block
+      auto write_block = [this, &block] {
+        std::string statements = "SAVEPOINT apply_block_;\n";
+        writer_->appendStatements(wsv_->changes(), statements);
+        block_index_->appendStatements(block, statements);
+        statements += "RELEASE SAVEPOINT apply_block_;";
+        try {
+          transaction_->exec(statements);
+          return true;
+        } catch (const std::exception &e) {
+          log_->error(
+              "failed to apply block {}: {}", block.height(), e.what());
+          transaction_->exec("ROLLBACK TO SAVEPOINT apply_block_;");
+          return false;
+        }
+      };
+
+      // changes of the block are kept in overlay, and written with a single
+      // batch of statements only if the block is applied
       auto result = function(block, *wsv_, top_hash_)
           and std::all_of(block.transactions().begin(),
                           block.transactions().end(),
-                          execute_transaction);
+                          execute_transaction)
+          and write_block();
+      if (not result) {
+        wsv_->discardChanges();
+        return false;
+      }
+      // storage now contains the changes, so they are served by cache
+      updateCache(wsv_->changes());
+      wsv_->commitChanges();
 
-      if (result) {
-        block_store_.insert(std::make_pair(
-            block.height(),
-            clone(block)));
-        block_index_->index(block);
+      block_store_.insert(std::make_pair(block.height(), clone(block)));
 
-        top_hash_ = block.hash();
-        transaction_->exec("RELEASE SAVEPOINT savepoint_;");
-      } else {
-        transaction_->exec("ROLLBACK TO SAVEPOINT savepoint_;");
-      }
-      return result;
+      top_hash_ = block.hash();
+      return true;
     }
 
     MutableStorageImpl::~MutableStorageImpl() {
@@ -22,6 +22,9 @@
 #include <pqxx/connection>
 #include <pqxx/nontransaction>
 
+#include "ametsuchi/impl/postgres_connection_pool.hpp"
+#include "ametsuchi/impl/wsv_cache.hpp"
+#include "ametsuchi/impl/wsv_overlay.hpp"
 #include "ametsuchi/mutable_storage.hpp"
 #include "execution/command_executor.hpp"
 #include "logger/logger.hpp"
@@ -30,8 +33,8 @@ namespace iroha {
 
   namespace ametsuchi {
 
-    class BlockIndex;
-    class WsvCommand;
+    class PostgresBlockIndex;
+    class PostgresWsvWriter;
 
     class MutableStorageImpl : public MutableStorage {
       friend class StorageImpl;
@@ -39,7 +42,7 @@ namespace iroha {
      public:
       MutableStorageImpl(
           shared_model::interface::types::HashType top_hash,
-          std::unique_ptr<pqxx::lazyconnection> connection,
+          PooledConnection connection,
           std::unique_ptr<pqxx::nontransaction> transaction);
 
       bool apply(
@@ -52,17 +55,25 @@ namespace iroha {
       ~MutableStorageImpl() override;
 
      private:
+      /**
+       * Put written entities to cache of committed state, or drop them to be
+       * read from the storage
+       * @param changes - entities written to the storage
+       */
+      void updateCache(const WsvOverlay::Layer &changes);
+
       shared_model::interface::types::HashType top_hash_;
       // ordered collection is used to enforce block insertion order in
       // StorageImpl::commit
       std::map<uint32_t, std::shared_ptr<shared_model::interface::Block>>
           block_store_;
 
-      std::unique_ptr<pqxx::lazyconnection> connection_;
+      PooledConnection connection_;
       std::unique_ptr<pqxx::nontransaction> transaction_;
-      std::unique_ptr<WsvQuery> wsv_;
-      std::unique_ptr<WsvCommand> executor_;
-      std::unique_ptr<BlockIndex> block_index_;
+      std::shared_ptr<WsvCache> cache_;
+      std::shared_ptr<WsvOverlay> wsv_;
+      std::unique_ptr<PostgresWsvWriter> writer_;
+      std::unique_ptr<PostgresBlockIndex> block_index_;
       std::shared_ptr<CommandExecutor> command_executor_;
 
       bool committed;
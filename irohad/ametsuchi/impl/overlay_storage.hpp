@@ -0,0 +1,114 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_OVERLAY_STORAGE_HPP
+#define IROHA_OVERLAY_STORAGE_HPP
+
+#include <boost/optional.hpp>
+#include <string>
+#include <vector>
+
+#include "common/result.hpp"
+#include "interfaces/common_objects/account.hpp"
+#include "interfaces/common_objects/peer.hpp"
+#include "interfaces/common_objects/types.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Rows and functions of the storage, which are not observable through
+     * WsvQuery, but are required by WsvOverlay to apply commands exactly as
+     * the storage does. Rows are read as they are stored, without stateless
+     * validation
+     */
+    class OverlayStorage {
+     public:
+      template <typename T>
+      using Result = expected::Result<T, std::string>;
+
+      virtual ~OverlayStorage() = default;
+
+      /**
+       * @return stored account, none if there is no such account
+       */
+      virtual Result<
+          boost::optional<std::shared_ptr<shared_model::interface::Account>>>
+      getAccount(
+          const shared_model::interface::types::AccountIdType &account_id) = 0;
+
+      /**
+       * @return true if asset is stored
+       */
+      virtual Result<bool> hasAsset(
+          const shared_model::interface::types::AssetIdType &asset_id) = 0;
+
+      /**
+       * @return true if domain is stored
+       */
+      virtual Result<bool> hasDomain(
+          const shared_model::interface::types::DomainIdType &domain_id) = 0;
+
+      /**
+       * @return true if signatory table contains the public key
+       */
+      virtual Result<bool> hasSignatory(
+          const shared_model::interface::types::PubkeyType &signatory) = 0;
+
+      /**
+       * @return accounts which have the signatory
+       */
+      virtual Result<std::vector<shared_model::interface::types::AccountIdType>>
+      getSignatoryAccounts(
+          const shared_model::interface::types::PubkeyType &signatory) = 0;
+
+      /**
+       * @return all stored peers
+       */
+      virtual Result<std::vector<std::shared_ptr<shared_model::interface::Peer>>>
+      getPeers() = 0;
+
+      /**
+       * Convert json data of account to the form returned by the storage
+       * @param json_data - json data to store
+       * @return stored json data, error if storage does not accept it
+       */
+      virtual Result<std::string> normalizeJson(
+          const std::string &json_data) = 0;
+
+      /**
+       * Evaluate json data of account after SetAccountDetail
+       * @param json_data - current data, none if account does not exist, in
+       * which case only the arguments are checked
+       * @param creator_account_id - account which sets the detail
+       * @param key - detail key
+       * @param val - detail value
+       * @return new json data, empty if account does not exist, error if
+       * storage does not accept the arguments
+       */
+      virtual Result<std::string> setAccountDetail(
+          const boost::optional<std::string> &json_data,
+          const shared_model::interface::types::AccountIdType
+              &creator_account_id,
+          const std::string &key,
+          const std::string &val) = 0;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_OVERLAY_STORAGE_HPP
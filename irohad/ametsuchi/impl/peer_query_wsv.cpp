@@ -18,17 +18,22 @@
 #include <numeric>
 
 #include "ametsuchi/impl/peer_query_wsv.hpp"
+#include "ametsuchi/storage.hpp"
 #include "ametsuchi/wsv_query.hpp"
 #include "builders/protobuf/common_objects/proto_peer_builder.hpp"
 
 namespace iroha {
   namespace ametsuchi {
 
-    PeerQueryWsv::PeerQueryWsv(std::shared_ptr<WsvQuery> wsv)
-        : wsv_(std::move(wsv)) {}
+    PeerQueryWsv::PeerQueryWsv(std::shared_ptr<Storage> storage)
+        : storage_(std::move(storage)) {}
 
     boost::optional<std::vector<PeerQuery::wPeer>> PeerQueryWsv::getLedgerPeers() {
-      auto peers = wsv_->getPeers();
+      auto wsv = storage_->getWsvQuery();
+      if (not wsv) {
+        return boost::none;
+      }
+      auto peers = (*wsv)->getPeers();
       if (peers) {
         return boost::make_optional(peers.value());
       } else {
@@ -26,14 +26,16 @@
 namespace iroha {
   namespace ametsuchi {
 
-    class WsvQuery;
+    class Storage;
 
     /**
-     * Implementation of PeerQuery interface based on WsvQuery fetching
+     * Implementation of PeerQuery interface based on WsvQuery fetching. WSV
+     * query is created for every request, so that no database connection is
+     * held between requests
      */
     class PeerQueryWsv : public PeerQuery {
      public:
-      explicit PeerQueryWsv(std::shared_ptr<WsvQuery> wsv);
+      explicit PeerQueryWsv(std::shared_ptr<Storage> storage);
 
       /**
        * Fetch peers stored in ledger
@@ -42,7 +44,7 @@ namespace iroha {
       boost::optional<std::vector<wPeer>> getLedgerPeers() override;
 
      private:
-      std::shared_ptr<WsvQuery> wsv_;
+      std::shared_ptr<Storage> storage_;
     };
 
   }  // namespace ametsuchi
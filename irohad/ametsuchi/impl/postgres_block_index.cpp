@@ -19,13 +19,10 @@
 #include <boost/range/adaptor/indexed.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/algorithm/for_each.hpp>
-#include <boost/range/numeric.hpp>
-#include <unordered_set>
 
 #include "ametsuchi/impl/postgres_block_index.hpp"
 #include "common/types.hpp"
 #include "common/visitor.hpp"
-#include "cryptography/ed25519_sha3_impl/internal/sha3_hash.hpp"
 #include "interfaces/commands/transfer_asset.hpp"
 #include "interfaces/iroha_internal/block.hpp"
 
@@ -33,94 +30,117 @@ namespace iroha {
   namespace ametsuchi {
 
     PostgresBlockIndex::PostgresBlockIndex(pqxx::nontransaction &transaction)
-        : transaction_(transaction),
-          log_(logger::log("PostgresBlockIndex")),
-          execute_{makeExecuteOptional(transaction_, log_)} {}
+        : transaction_(transaction), log_(logger::log("PostgresBlockIndex")) {}
 
-    auto PostgresBlockIndex::indexAccountIdHeight(const std::string &account_id,
-                                                  const std::string &height) {
-      return this->execute(
-          "INSERT INTO height_by_account_set(account_id, height) "
-          "VALUES ("
-          + transaction_.quote(account_id) + ", " + transaction_.quote(height)
-          + ");");
+    std::string PostgresBlockIndex::quoteArray(
+        const std::vector<std::string> &values) const {
+      return transaction_.quote(makeArrayLiteral(values));
     }
 
-    auto PostgresBlockIndex::indexAccountAssets(
+    void PostgresBlockIndex::indexAccountAssets(
         const std::string &account_id,
-        const std::string &height,
         const std::string &index,
-        const shared_model::interface::Transaction::CommandsType &commands) {
+        const shared_model::interface::Transaction::CommandsType &commands,
+        BlockRows &rows) const {
       // flat map abstract commands to transfers
+      boost::for_each(commands, [&](const auto &cmd) {
+        visit_in_place(
+            cmd->get(),
+            [&](const shared_model::detail::PolymorphicWrapper<
+                shared_model::interface::TransferAsset> &command) {
+              rows.accounts.insert(command->srcAccountId());
+              rows.accounts.insert(command->destAccountId());
 
-      return std::accumulate(
-          commands.begin(),
-          commands.end(),
-          true,
-          [&](auto &status, const auto &cmd) {
-            return visit_in_place(
-                cmd->get(),
-                [&](const shared_model::detail::PolymorphicWrapper<
-                    shared_model::interface::TransferAsset> &command) {
-                  status &= this->indexAccountIdHeight(command->srcAccountId(),
-                                                       height)
-                      & this->indexAccountIdHeight(command->destAccountId(),
-                                                   height);
-
-                  auto ids = {account_id,
-                              command->srcAccountId(),
-                              command->destAccountId()};
-                  // flat map accounts to unindexed keys
-                  boost::for_each(ids, [&](const auto &id) {
-                    auto res = execute_(
-                        "INSERT INTO index_by_id_height_asset(id, "
-                        "height, asset_id, "
-                        "index) "
-                        "VALUES ("
-                        + transaction_.quote(id) + ", "
-                        + transaction_.quote(height) + ", "
-                        + transaction_.quote(command->assetId()) + ", "
-                        + transaction_.quote(index) + ");");
-                    status &= res != boost::none;
-                  });
-                  return status;
-                },
-                [&](const auto &command) { return true; });
-
-          });
+              auto ids = {account_id,
+                          command->srcAccountId(),
+                          command->destAccountId()};
+              // flat map accounts to unindexed keys
+              boost::for_each(ids, [&](const auto &id) {
+                rows.asset_account_ids.push_back(id);
+                rows.asset_ids.push_back(command->assetId());
+                rows.asset_indexes.push_back(index);
+              });
+            },
+            [&](const auto &command) {});
+      });
     }
 
-    void PostgresBlockIndex::index(
-        const shared_model::interface::Block &block) {
-      const auto &height = std::to_string(block.height());
+    void PostgresBlockIndex::appendStatements(
+        const shared_model::interface::Block &block,
+        std::string &statements) const {
+      auto append = [&statements](const std::string &statement) {
+        statements += statement;
+        statements += ";\n";
+      };
+      const auto height = transaction_.quote(block.height());
+
+      BlockRows rows;
       boost::for_each(
           block.transactions() | boost::adaptors::indexed(0),
           [&](const auto &tx) {
             const auto &creator_id = tx.value()->creatorAccountId();
-            const auto &hash = tx.value()->hash().blob();
             const auto &index = std::to_string(tx.index());
 
             // tx hash -> block where hash is stored
-            this->execute("INSERT INTO height_by_hash(hash, height) VALUES ("
-                          + transaction_.quote(
-                                pqxx::binarystring(hash.data(), hash.size()))
-                          + ", " + transaction_.quote(height) + ");");
+            rows.tx_hashes.push_back(tx.value()->hash().hex());
 
-            this->indexAccountIdHeight(creator_id, height);
+            rows.accounts.insert(creator_id);
 
             // to make index account_id:height -> list of tx indexes
             // (where tx is placed in the block)
-            execute_(
-                "INSERT INTO index_by_creator_height(creator_id, "
-                "height, index) "
-                "VALUES ("
-                + transaction_.quote(creator_id) + ", "
-                + transaction_.quote(height) + ", " + transaction_.quote(index)
-                + ");");
+            rows.creator_ids.push_back(creator_id);
+            rows.creator_indexes.push_back(index);
 
             this->indexAccountAssets(
-                creator_id, height, index, tx.value()->commands());
+                creator_id, index, tx.value()->commands(), rows);
           });
+
+      // block hash -> height of the block
+      append("INSERT INTO height_by_block_hash(hash, height) VALUES (decode("
+             + transaction_.quote(block.hash().hex()) + ", 'hex'), " + height
+             + ")");
+      if (not rows.tx_hashes.empty()) {
+        append("INSERT INTO height_by_hash(hash, height) "
+               "SELECT decode(hash, 'hex'), "
+               + height + " FROM unnest(" + quoteArray(rows.tx_hashes)
+               + "::text[]) AS hash");
+        append("INSERT INTO height_by_account_set(account_id, height) "
+               "SELECT account_id, "
+               + height + " FROM unnest("
+               + quoteArray(std::vector<std::string>(rows.accounts.begin(),
+                                                     rows.accounts.end()))
+               + "::text[]) AS account_id");
+        append("INSERT INTO index_by_creator_height(creator_id, height, "
+               "index) SELECT t.creator_id, "
+               + height + ", t.index FROM unnest("
+               + quoteArray(rows.creator_ids) + "::text[], "
+               + quoteArray(rows.creator_indexes)
+               + "::bigint[]) AS t(creator_id, index)");
+      }
+      if (not rows.asset_ids.empty()) {
+        append("INSERT INTO index_by_id_height_asset(id, height, asset_id, "
+               "index) SELECT t.id, "
+               + height + ", t.asset_id, t.index FROM unnest("
+               + quoteArray(rows.asset_account_ids) + "::text[], "
+               + quoteArray(rows.asset_ids) + "::text[], "
+               + quoteArray(rows.asset_indexes)
+               + "::bigint[]) AS t(id, asset_id, index)");
+      }
+    }
+
+    bool PostgresBlockIndex::index(
+        const shared_model::interface::Block &block) {
+      std::string statements;
+      appendStatements(block, statements);
+      // a failed statement aborts the enclosing transaction, so the rest is
+      // not executed
+      try {
+        transaction_.exec(statements);
+        return true;
+      } catch (const std::exception &e) {
+        log_->error("failed to index block {}: {}", block.height(), e.what());
+        return false;
+      }
     }
   }  // namespace ametsuchi
 }  // namespace iroha
@@ -18,8 +18,8 @@
 #ifndef IROHA_POSTGRES_BLOCK_INDEX_HPP
 #define IROHA_POSTGRES_BLOCK_INDEX_HPP
 
-#include <boost/format.hpp>
 #include <pqxx/nontransaction>
+#include <set>
 
 #include "ametsuchi/impl/block_index.hpp"
 #include "ametsuchi/impl/postgres_wsv_common.hpp"
@@ -28,45 +28,64 @@
 
 namespace iroha {
   namespace ametsuchi {
+    /**
+     * Indexes blocks in Postgres. All index rows of a block are collected
+     * first and written with a few multi-row statements, which are sent in
+     * a single round trip, possibly together with other changes of the block
+     */
     class PostgresBlockIndex : public BlockIndex {
      public:
       explicit PostgresBlockIndex(pqxx::nontransaction &transaction);
 
-      void index(const shared_model::interface::Block &block) override;
+      bool index(const shared_model::interface::Block &block) override;
+
+      /**
+       * Append statements which write index rows of block. A failed
+       * statement aborts the enclosing transaction
+       * @param block - block to index
+       * @param statements - batch to append to
+       */
+      void appendStatements(const shared_model::interface::Block &block,
+                            std::string &statements) const;
 
      private:
       /**
-       * Make index account_id -> list of blocks where his txs exist
-       * @param account_id of transaction creator
-       * @param height of block
+       * Index rows of a single block
        */
-      auto indexAccountIdHeight(const std::string &account_id,
-                                const std::string &height);
+      struct BlockRows {
+        /// account_id -> list of blocks where its txs exist
+        std::set<std::string> accounts;
+        /// hashes of txs in hex
+        std::vector<std::string> tx_hashes;
+        /// creator_id:height -> list of tx indexes
+        std::vector<std::string> creator_ids, creator_indexes;
+        /// account_id:height:asset_id -> list of tx indexes
+        std::vector<std::string> asset_account_ids, asset_ids, asset_indexes;
+      };
 
       /**
        * Collect all assets belonging to creator, sender, and receiver
        * to make account_id:height:asset_id -> list of tx indexes (where
        * tx with certain asset is placed in the block)
        * @param account_id of transaction creator
-       * @param height of block
        * @param index of transaction in the block
        * @param commands in the transaction
+       * @param rows to append collected rows to
        */
-      auto indexAccountAssets(
+      void indexAccountAssets(
           const std::string &account_id,
-          const std::string &height,
           const std::string &index,
-          const shared_model::interface::Transaction::CommandsType &commands);
+          const shared_model::interface::Transaction::CommandsType &commands,
+          BlockRows &rows) const;
+
+      /**
+       * @param values - elements of array
+       * @return quoted SQL literal of text array
+       */
+      std::string quoteArray(const std::vector<std::string> &values) const;
 
       pqxx::nontransaction &transaction_;
       logger::Logger log_;
-      using ExecuteType = decltype(makeExecuteOptional(transaction_, log_));
-      ExecuteType execute_;
-
-      // TODO: refactor to return Result when it is introduced IR-775
-      bool execute(const std::string &statement) noexcept {
-        return static_cast<bool>(execute_(statement));
-      }
     };
   }  // namespace ametsuchi
 }  // namespace iroha
@@ -16,16 +16,42 @@
  */
 
 #include "ametsuchi/impl/postgres_block_query.hpp"
-#include <boost/range/adaptor/transformed.hpp>
-#include <boost/range/algorithm/for_each.hpp>
-#include "backend/protobuf/from_old_model.hpp"
 
 namespace iroha {
   namespace ametsuchi {
 
-    PostgresBlockQuery::PostgresBlockQuery(pqxx::nontransaction &transaction,
-                                           FlatFile &file_store)
+    std::shared_ptr<const shared_model::proto::Block> shareBlock(
+        std::shared_ptr<const shared_model::proto::Block> block) {
+      auto share_signatures = [](const auto &signatures) {
+        for (const auto &signature : signatures) {
+          signature->publicKey();
+          signature->signedData();
+        }
+      };
+      block->hash();
+      block->prevHash();
+      block->blob();
+      share_signatures(block->signatures());
+      for (const auto &transaction : block->transactions()) {
+        transaction->hash();
+        transaction->blob();
+        share_signatures(transaction->signatures());
+        for (const auto &command : transaction->commands()) {
+          command->get();
+        }
+      }
+      return block;
+    }
+
+    const size_t PostgresBlockQuery::kDefaultBlockCacheSize;
+    const size_t PostgresBlockQuery::kTxChunkSize;
+
+    PostgresBlockQuery::PostgresBlockQuery(
+        pqxx::nontransaction &transaction,
+        FlatFile &file_store,
+        std::shared_ptr<BlockCache> block_cache)
         : block_store_(file_store),
+          block_cache_(std::move(block_cache)),
           transaction_(transaction),
           log_(logger::log("PostgresBlockIndex")),
           execute_{makeExecuteOptional(transaction_, log_)} {}
@@ -39,17 +65,7 @@ namespace iroha {
         return rxcpp::observable<>::empty<wBlock>();
       }
       return rxcpp::observable<>::range(height, to).flat_map([this](auto i) {
-        // TODO IR-975 victordrobny 12.02.2018 convert directly to
-        // shared_model::proto::Block after FlatFile will be reworked to new
-        // model
-        auto block = block_store_.get(i) | [](const auto &bytes) {
-          return model::converters::stringToJson(bytesToString(bytes));
-        } | [this](const auto &d) {
-          return serializer_.deserialize(d);
-        } | [](const auto &block_old) {
-          return std::make_shared<shared_model::proto::Block>(
-              shared_model::proto::from_old(block_old));
-        };
+        wBlock block = this->getBlock(i);
         return rxcpp::observable<>::create<PostgresBlockQuery::wBlock>(
             [block{std::move(block)}](auto s) {
               if (block) {
@@ -72,21 +88,22 @@ namespace iroha {
       return getBlocks(last_id - count + 1, count);
     }
 
-    std::vector<shared_model::interface::types::HeightType>
-    PostgresBlockQuery::getBlockIds(
-        const shared_model::interface::types::AccountIdType &account_id) {
-      return execute_(
-                 "SELECT DISTINCT height FROM height_by_account_set WHERE "
-                 "account_id = "
-                 + transaction_.quote(account_id) + ";")
-                 | [&](const auto &result)
-                 -> std::vector<shared_model::interface::types::HeightType> {
-        return transform<shared_model::interface::types::HeightType>(
-            result, [&](const auto &row) {
-              return row.at("height")
-                  .template as<shared_model::interface::types::HeightType>();
-            });
+    std::shared_ptr<const shared_model::proto::Block>
+    PostgresBlockQuery::getBlock(
+        shared_model::interface::types::HeightType height) {
+      if (auto cached = block_cache_->findItem(height)) {
+        return *cached;
+      }
+      auto block = block_store_.getView(height) | [this](const auto &view) {
+        return serializer_.deserialize(view.data(), view.size());
+      } | [](auto &block) {
+        return shareBlock(
+            std::make_shared<shared_model::proto::Block>(std::move(block)));
       };
+      if (block) {
+        block_cache_->addItem(height, block);
+      }
+      return block;
     }
 
     boost::optional<shared_model::interface::types::HeightType>
@@ -108,77 +125,143 @@ namespace iroha {
       };
     }
 
-    std::function<void(pqxx::result &result)> PostgresBlockQuery::callback(
-        const rxcpp::subscriber<wTransaction> &subscriber, uint64_t block_id) {
-      return [this, &subscriber, block_id](pqxx::result &result) {
-        auto block = block_store_.get(block_id) | [this](auto bytes) {
-          // TODO IR-975 victordrobny 12.02.2018 convert directly to
-          // shared_model::proto::Block after FlatFile will be reworked to new
-          // model
-          return boost::optional<shared_model::proto::Block>(
-              shared_model::proto::from_old(*serializer_.deserialize(
-                  *model::converters::stringToJson(bytesToString(bytes)))));
-        };
-        boost::for_each(
-            result | boost::adaptors::transformed([](const auto &x) {
-              return x.at("index").template as<size_t>();
-            }),
-            [&](auto x) {
-              subscriber.on_next(PostgresBlockQuery::wTransaction(
-                  clone(*block->transactions().at(x))));
-            });
+    boost::optional<shared_model::interface::types::HeightType>
+    PostgresBlockQuery::getBlockHeight(const shared_model::crypto::Hash &hash) {
+      return execute_("SELECT height FROM height_by_block_hash WHERE hash = "
+                      + transaction_.quote(pqxx::binarystring(
+                            hash.blob().data(), hash.blob().size()))
+                      + ";")
+                 | [&](const auto &result)
+                 -> boost::optional<
+                     shared_model::interface::types::HeightType> {
+        if (result.size() == 0) {
+          return boost::none;
+        }
+        return result[0]
+            .at("height")
+            .template as<shared_model::interface::types::HeightType>();
       };
     }
 
-    rxcpp::observable<BlockQuery::wTransaction>
-    PostgresBlockQuery::getAccountTransactions(
-        const shared_model::interface::types::AccountIdType &account_id) {
-      return rxcpp::observable<>::create<wTransaction>(
-          [this, account_id](auto subscriber) {
-            auto block_ids = this->getBlockIds(account_id);
-            if (block_ids.empty()) {
-              subscriber.on_completed();
-              return;
-            }
+    boost::optional<PostgresBlockQuery::TxPosition>
+    PostgresBlockQuery::getTxPosition(const shared_model::crypto::Hash &hash) {
+      auto height = getBlockId(hash);
+      auto block = height | [this](auto id) { return this->getBlock(id); };
+      if (not block) {
+        return boost::none;
+      }
 
-            for (const auto &block_id : block_ids) {
-              execute_(
-                  "SELECT DISTINCT index FROM index_by_creator_height WHERE "
-                  "creator_id = "
-                  + transaction_.quote(account_id)
-                  + " AND height = " + transaction_.quote(block_id) + ";")
-                  | this->callback(subscriber, block_id);
-            }
-            subscriber.on_completed();
-          });
+      const auto &transactions = block->transactions();
+      auto it = std::find_if(transactions.begin(),
+                             transactions.end(),
+                             [&hash](auto tx) { return tx->hash() == hash; });
+      if (it == transactions.end()) {
+        return boost::none;
+      }
+      return TxPosition(*height, std::distance(transactions.begin(), it));
     }
 
     rxcpp::observable<BlockQuery::wTransaction>
-    PostgresBlockQuery::getAccountAssetTransactions(
-        const shared_model::interface::types::AccountIdType &account_id,
-        const shared_model::interface::types::AssetIdType &asset_id) {
+    PostgresBlockQuery::getTransactionsPage(const std::string &table,
+                                            const std::string &condition,
+                                            const TxPagination &pagination) {
       return rxcpp::observable<>::create<wTransaction>([this,
-                                                        account_id,
-                                                        asset_id](
+                                                        table,
+                                                        condition,
+                                                        pagination](
                                                            auto subscriber) {
-        auto block_ids = this->getBlockIds(account_id);
-        if (block_ids.empty()) {
-          subscriber.on_completed();
-          return;
+        // transactions following this position are returned
+        boost::optional<TxPosition> position;
+        if (pagination.last_tx_hash) {
+          position = this->getTxPosition(*pagination.last_tx_hash);
+          if (not position) {
+            log_->info("Cannot find transaction {}",
+                       pagination.last_tx_hash->hex());
+            subscriber.on_completed();
+            return;
+          }
         }
 
-        for (const auto &block_id : block_ids) {
-          execute_(
-              "SELECT DISTINCT index FROM index_by_id_height_asset WHERE id = "
-              + transaction_.quote(account_id)
-              + " AND height = " + transaction_.quote(block_id)
-              + " AND asset_id = " + transaction_.quote(asset_id) + ";")
-              | this->callback(subscriber, block_id);
+        auto remaining = pagination.page_size;
+        shared_model::interface::types::HeightType block_height = 0;
+        std::shared_ptr<const shared_model::proto::Block> block;
+        while (subscriber.is_subscribed()) {
+          auto limit = remaining == 0 ? kTxChunkSize
+                                      : std::min(remaining, kTxChunkSize);
+          auto after = position
+              ? " AND (height, index) > (" + transaction_.quote(position->first)
+                  + ", " + transaction_.quote(position->second) + ")"
+              : "";
+          auto result = execute_("SELECT DISTINCT height, index FROM " + table
+                                 + " WHERE " + condition + after
+                                 + " ORDER BY height, index LIMIT "
+                                 + transaction_.quote(limit) + ";");
+          if (not result) {
+            break;
+          }
+
+          for (const auto &row : *result) {
+            position = TxPosition(
+                row.at("height")
+                    .template as<shared_model::interface::types::HeightType>(),
+                row.at("index").template as<size_t>());
+            // rows are ordered by height, so every block is loaded once
+            if (not block or block_height != position->first) {
+              block_height = position->first;
+              block = this->getBlock(block_height);
+            }
+            if (not block) {
+              log_->error("Cannot load block {}", block_height);
+              continue;
+            }
+            const auto &transactions =
+                block->getTransport().payload().transactions();
+            if (position->second >= static_cast<size_t>(transactions.size())) {
+              log_->error("No transaction {} in block {}",
+                          position->second,
+                          block_height);
+              continue;
+            }
+            subscriber.on_next(
+                std::make_shared<shared_model::proto::Transaction>(
+                    iroha::protocol::Transaction(
+                        transactions.Get(position->second))));
+          }
+
+          if (remaining != 0) {
+            remaining -= result->size();
+          }
+          if (result->size() < limit or (pagination.page_size != 0
+                                         and remaining == 0)) {
+            break;
+          }
         }
         subscriber.on_completed();
       });
     }
 
+    rxcpp::observable<BlockQuery::wTransaction>
+    PostgresBlockQuery::getAccountTransactions(
+        const shared_model::interface::types::AccountIdType &account_id,
+        const TxPagination &pagination) {
+      return getTransactionsPage(
+          "index_by_creator_height",
+          "creator_id = " + transaction_.quote(account_id),
+          pagination);
+    }
+
+    rxcpp::observable<BlockQuery::wTransaction>
+    PostgresBlockQuery::getAccountAssetTransactions(
+        const shared_model::interface::types::AccountIdType &account_id,
+        const shared_model::interface::types::AssetIdType &asset_id,
+        const TxPagination &pagination) {
+      return getTransactionsPage(
+          "index_by_id_height_asset",
+          "id = " + transaction_.quote(account_id)
+              + " AND asset_id = " + transaction_.quote(asset_id),
+          pagination);
+    }
+
     rxcpp::observable<boost::optional<BlockQuery::wTransaction>>
     PostgresBlockQuery::getTransactions(
         const std::vector<shared_model::crypto::Hash> &tx_hashes) {
@@ -196,30 +279,31 @@ namespace iroha {
     boost::optional<BlockQuery::wTransaction>
     PostgresBlockQuery::getTxByHashSync(
         const shared_model::crypto::Hash &hash) {
-      return getBlockId(hash) |
-          [this](auto blockId) { return block_store_.get(blockId); } |
-          [](auto bytes) {
-            // TODO IR-975 victordrobny 12.02.2018 convert directly to
-            // shared_model::proto::Block after FlatFile will be reworked to new
-            // model
-            return model::converters::stringToJson(bytesToString(bytes));
-          }
-      | [&](const auto &json) { return serializer_.deserialize(json); } |
-          [](const auto &block) {
-            return boost::optional<shared_model::proto::Block>(
-                shared_model::proto::from_old(block));
-          }
-      | [&](const auto &block) {
-          boost::optional<PostgresBlockQuery::wTransaction> result;
-          auto it =
-              std::find_if(block.transactions().begin(),
-                           block.transactions().end(),
-                           [&hash](auto tx) { return tx->hash() == hash; });
-          if (it != block.transactions().end()) {
-            result = boost::optional<PostgresBlockQuery::wTransaction>(clone(**it));
-          }
-          return result;
-        };
+      auto block = getBlockId(hash) |
+          [this](auto blockId) { return this->getBlock(blockId); };
+      if (not block) {
+        return boost::none;
+      }
+
+      const auto &transactions = block->transactions();
+      auto it = std::find_if(transactions.begin(),
+                             transactions.end(),
+                             [&hash](auto tx) { return tx->hash() == hash; });
+      if (it == transactions.end()) {
+        return boost::none;
+      }
+      // only the found transaction is copied out of the shared block
+      return boost::optional<PostgresBlockQuery::wTransaction>(clone(**it));
+    }
+
+    boost::optional<BlockQuery::wBlock> PostgresBlockQuery::getBlockByHashSync(
+        const shared_model::crypto::Hash &hash) {
+      auto block = getBlockHeight(hash) |
+          [this](auto height) { return this->getBlock(height); };
+      if (not block) {
+        return boost::none;
+      }
+      return boost::optional<wBlock>(block);
     }
 
   }  // namespace ametsuchi
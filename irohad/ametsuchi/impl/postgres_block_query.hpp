@@ -22,9 +22,10 @@
 #include <pqxx/nontransaction>
 
 #include "ametsuchi/block_query.hpp"
+#include "ametsuchi/impl/block_serializer.hpp"
 #include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "cache/lru_cache.hpp"
 #include "logger/logger.hpp"
-#include "model/converters/json_block_factory.hpp"
 #include "postgres_wsv_common.hpp"
 
 namespace iroha {
@@ -32,21 +33,50 @@ namespace iroha {
 
     class FlatFile;
 
+    /**
+     * Cache of deserialized blocks by their height.
+     * Cached blocks are shared between threads without copying, so they are
+     * added only after shareBlock initializes their lazy fields
+     */
+    using BlockCache =
+        cache::LruCache<shared_model::interface::types::HeightType,
+                        std::shared_ptr<const shared_model::proto::Block>>;
+
+    /**
+     * Initialize lazy fields of block, its signatures and transactions, so
+     * that the block can be read by several threads at once. Fields of
+     * separate commands stay lazy, so they are read from a copy of
+     * transaction
+     * @param block - block which is not modified anymore
+     * @return the same block
+     */
+    std::shared_ptr<const shared_model::proto::Block> shareBlock(
+        std::shared_ptr<const shared_model::proto::Block> block);
+
     /**
      * Class which implements BlockQuery with a Postgres backend.
      */
     class PostgresBlockQuery : public BlockQuery {
      public:
+      /**
+       * Default number of blocks kept in cache
+       */
+      static const size_t kDefaultBlockCacheSize = 128;
+
       PostgresBlockQuery(pqxx::nontransaction &transaction_,
-                         FlatFile &file_store);
+                         FlatFile &file_store,
+                         std::shared_ptr<BlockCache> block_cache =
+                             std::make_shared<BlockCache>(
+                                 kDefaultBlockCacheSize));
 
       rxcpp::observable<wTransaction> getAccountTransactions(
-          const shared_model::interface::types::AccountIdType &account_id)
-          override;
+          const shared_model::interface::types::AccountIdType &account_id,
+          const TxPagination &pagination) override;
 
       rxcpp::observable<wTransaction> getAccountAssetTransactions(
           const shared_model::interface::types::AccountIdType &account_id,
-          const shared_model::interface::types::AssetIdType &asset_id) override;
+          const shared_model::interface::types::AssetIdType &asset_id,
+          const TxPagination &pagination) override;
 
       rxcpp::observable<boost::optional<wTransaction>> getTransactions(
           const std::vector<shared_model::crypto::Hash> &tx_hashes) override;
@@ -63,14 +93,17 @@ namespace iroha {
 
       rxcpp::observable<wBlock> getTopBlocks(uint32_t count) override;
 
+      boost::optional<wBlock> getBlockByHashSync(
+          const shared_model::crypto::Hash &hash) override;
+
      private:
       /**
-       * Returns all blocks' ids containing given account id
-       * @param account_id
-       * @return vector of block ids
+       * Returns block from cache or reads it from block store
+       * @param height - height of block
+       * @return block or nullptr if it cannot be read
        */
-      std::vector<shared_model::interface::types::HeightType> getBlockIds(
-          const shared_model::interface::types::AccountIdType &account_id);
+      std::shared_ptr<const shared_model::proto::Block> getBlock(
+          shared_model::interface::types::HeightType height);
 
       /**
        * Returns block id which contains transaction with a given hash
@@ -81,21 +114,55 @@ namespace iroha {
           const shared_model::crypto::Hash &hash);
 
       /**
-       * creates callback to lrange query to Postgres to supply result to
-       * subscriber s
-       * @param s
-       * @param block_id
-       * @return
+       * Returns height of block with a given hash
+       * @param hash - hash of block
+       * @return block height or boost::none
+       */
+      boost::optional<shared_model::interface::types::HeightType>
+      getBlockHeight(const shared_model::crypto::Hash &hash);
+
+      /**
+       * Position of transaction in the ledger: block height and index of
+       * transaction in the block
+       */
+      using TxPosition =
+          std::pair<shared_model::interface::types::HeightType, size_t>;
+
+      /**
+       * Returns position of transaction with a given hash
+       * @param hash - hash of transaction
+       * @return position or boost::none
+       */
+      boost::optional<TxPosition> getTxPosition(
+          const shared_model::crypto::Hash &hash);
+
+      /**
+       * Streams transactions at positions selected by query. Positions are
+       * read in chunks ordered by height and index, so the whole history is
+       * never loaded at once
+       * @param table - index table with height and index columns
+       * @param condition - SQL condition on index table which selects
+       * positions of requested transactions
+       * @param pagination - page of history to retrieve
+       * @return observable of transactions
+       */
+      rxcpp::observable<wTransaction> getTransactionsPage(
+          const std::string &table,
+          const std::string &condition,
+          const TxPagination &pagination);
+
+      /**
+       * Maximal number of transaction positions read by one query
        */
-      std::function<void(pqxx::result &result)> callback(
-          const rxcpp::subscriber<wTransaction> &s, uint64_t block_id);
+      static const size_t kTxChunkSize = 1000;
 
       FlatFile &block_store_;
+      std::shared_ptr<BlockCache> block_cache_;
       pqxx::nontransaction &transaction_;
       logger::Logger log_;
       using ExecuteType = decltype(makeExecuteOptional(transaction_, log_));
       ExecuteType execute_;
-      model::converters::JsonBlockFactory serializer_;
+      BlockSerializer serializer_;
     };
   }  // namespace ametsuchi
 }  // namespace iroha
@@ -0,0 +1,194 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/postgres_connection_pool.hpp"
+
+#include <boost/format.hpp>
+#include <pqxx/nontransaction>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    std::shared_ptr<PostgresConnectionPool> PostgresConnectionPool::create(
+        std::string postgres_options,
+        size_t capacity,
+        std::chrono::milliseconds checkout_timeout,
+        std::chrono::milliseconds health_check_interval) {
+      return std::shared_ptr<PostgresConnectionPool>(
+          new PostgresConnectionPool(std::move(postgres_options),
+                                     capacity,
+                                     checkout_timeout,
+                                     health_check_interval));
+    }
+
+    PostgresConnectionPool::PostgresConnectionPool(
+        std::string postgres_options,
+        size_t capacity,
+        std::chrono::milliseconds checkout_timeout,
+        std::chrono::milliseconds health_check_interval)
+        : postgres_options_(std::move(postgres_options)),
+          capacity_(capacity),
+          checkout_timeout_(checkout_timeout),
+          health_check_interval_(health_check_interval),
+          log_(logger::log("PostgresConnectionPool")) {
+      statistics_.capacity = capacity_;
+    }
+
+    expected::Result<PooledConnection, std::string>
+    PostgresConnectionPool::checkout() {
+      const auto start = Clock::now();
+      bool waited = false;
+      std::unique_lock<std::mutex> lock(mutex_);
+
+      auto checked_out = [&](auto connection) {
+        ++statistics_.checkouts;
+        ++statistics_.in_use;
+        statistics_.peak_in_use =
+            std::max(statistics_.peak_in_use, statistics_.in_use);
+        if (waited) {
+          auto wait = std::chrono::duration_cast<std::chrono::microseconds>(
+              Clock::now() - start);
+          ++statistics_.waits;
+          statistics_.total_wait += wait;
+          statistics_.max_wait = std::max(statistics_.max_wait, wait);
+        }
+        return expected::makeValue(this->wrap(std::move(connection)));
+      };
+
+      while (true) {
+        while (not idle_.empty()) {
+          auto idle = std::move(idle_.back());
+          idle_.pop_back();
+          // health check is a round trip, so other threads are not blocked
+          lock.unlock();
+          auto healthy = this->isHealthy(idle);
+          lock.lock();
+          if (healthy) {
+            return checked_out(std::move(idle.connection));
+          }
+          --statistics_.opened;
+        }
+
+        if (statistics_.opened < capacity_) {
+          // slot is reserved before the connection is opened without lock
+          ++statistics_.opened;
+          lock.unlock();
+          auto connection =
+              std::make_unique<pqxx::lazyconnection>(postgres_options_);
+          try {
+            connection->activate();
+          } catch (const pqxx::broken_connection &e) {
+            lock.lock();
+            --statistics_.opened;
+            returned_.notify_one();
+            return expected::makeError(
+                (boost::format("Connection to PostgreSQL broken: %s")
+                 % e.what())
+                    .str());
+          }
+          lock.lock();
+          return checked_out(std::move(connection));
+        }
+
+        waited = true;
+        if (not returned_.wait_until(
+                lock, start + checkout_timeout_, [this] {
+                  return not idle_.empty() or statistics_.opened < capacity_;
+                })) {
+          ++statistics_.timeouts;
+          log_->error("no connection was returned in {} ms, {} in use",
+                      checkout_timeout_.count(),
+                      statistics_.in_use);
+          return expected::makeError(
+              std::string("Connection pool is exhausted"));
+        }
+      }
+    }
+
+    PostgresConnectionPool::Statistics PostgresConnectionPool::statistics()
+        const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return statistics_;
+    }
+
+    bool PostgresConnectionPool::isHealthy(const IdleConnection &idle) const {
+      if (not idle.connection->is_open()) {
+        return false;
+      }
+      if (Clock::now() - idle.returned < health_check_interval_) {
+        return true;
+      }
+      try {
+        pqxx::nontransaction check(*idle.connection);
+        check.exec("SELECT 1;");
+        return true;
+      } catch (const std::exception &e) {
+        log_->warn("idle connection is broken: {}", e.what());
+        return false;
+      }
+    }
+
+    bool PostgresConnectionPool::reset(
+        pqxx::lazyconnection &connection) const {
+      if (not connection.is_open()) {
+        return false;
+      }
+      try {
+        pqxx::nontransaction reset(connection);
+        // rollback outside of a transaction only issues a warning
+        reset.exec("ROLLBACK;");
+        // DISCARD ALL without DEALLOCATE ALL
+        reset.exec(
+            "RESET ALL; CLOSE ALL; UNLISTEN *; "
+            "SELECT pg_advisory_unlock_all(); "
+            "DISCARD SEQUENCES; DISCARD TEMP;");
+        return true;
+      } catch (const std::exception &e) {
+        log_->warn("returned connection cannot be reset: {}", e.what());
+        return false;
+      }
+    }
+
+    void PostgresConnectionPool::giveBack(pqxx::lazyconnection *connection) {
+      std::unique_ptr<pqxx::lazyconnection> owned(connection);
+      // reset is a round trip, so it is done without lock
+      auto reusable = this->reset(*owned);
+      std::lock_guard<std::mutex> lock(mutex_);
+      --statistics_.in_use;
+      if (reusable) {
+        idle_.push_back(IdleConnection{std::move(owned), Clock::now()});
+      } else {
+        --statistics_.opened;
+      }
+      returned_.notify_one();
+    }
+
+    PooledConnection PostgresConnectionPool::wrap(
+        std::unique_ptr<pqxx::lazyconnection> connection) {
+      std::weak_ptr<PostgresConnectionPool> pool = shared_from_this();
+      return PooledConnection(connection.release(),
+                              [pool](pqxx::lazyconnection *connection) {
+                                if (auto alive = pool.lock()) {
+                                  alive->giveBack(connection);
+                                } else {
+                                  delete connection;
+                                }
+                              });
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,161 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_POSTGRES_CONNECTION_POOL_HPP
+#define IROHA_POSTGRES_CONNECTION_POOL_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <pqxx/connection>
+#include <vector>
+
+#include "common/result.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Connection checked out of the pool, it is returned to the pool on
+     * destruction
+     */
+    using PooledConnection =
+        std::unique_ptr<pqxx::lazyconnection,
+                        std::function<void(pqxx::lazyconnection *)>>;
+
+    /**
+     * Bounded pool of Postgres connections. Connections are opened on
+     * demand up to the pool size, reset and reused after they are returned,
+     * and checked before reuse if they stayed idle for a while
+     */
+    class PostgresConnectionPool
+        : public std::enable_shared_from_this<PostgresConnectionPool> {
+     public:
+      /**
+       * Pool usage metrics
+       */
+      struct Statistics {
+        /// number of successful checkouts
+        uint64_t checkouts;
+        /// number of checkouts which waited for a connection to be returned
+        uint64_t waits;
+        /// number of checkouts failed since no connection was returned in
+        /// time
+        uint64_t timeouts;
+        /// total and maximal time spent waiting for a connection
+        std::chrono::microseconds total_wait;
+        std::chrono::microseconds max_wait;
+        /// number of connections currently checked out
+        size_t in_use;
+        /// maximal number of simultaneously checked out connections
+        size_t peak_in_use;
+        /// number of opened connections
+        size_t opened;
+        /// maximal number of connections
+        size_t capacity;
+      };
+
+      /**
+       * Create pool
+       * @param postgres_options - connection options
+       * @param capacity - maximal number of opened connections
+       * @param checkout_timeout - maximal time to wait for a connection
+       * @param health_check_interval - idle time after which connection is
+       * checked before reuse
+       */
+      static std::shared_ptr<PostgresConnectionPool> create(
+          std::string postgres_options,
+          size_t capacity,
+          std::chrono::milliseconds checkout_timeout =
+              std::chrono::seconds(10),
+          std::chrono::milliseconds health_check_interval =
+              std::chrono::seconds(30));
+
+      /**
+       * Take connection from the pool, open a new one if there are no idle
+       * connections, or wait for a connection to be returned if the pool is
+       * saturated
+       * @return connection or error message
+       */
+      expected::Result<PooledConnection, std::string> checkout();
+
+      /**
+       * @return pool usage metrics
+       */
+      Statistics statistics() const;
+
+     private:
+      PostgresConnectionPool(std::string postgres_options,
+                             size_t capacity,
+                             std::chrono::milliseconds checkout_timeout,
+                             std::chrono::milliseconds health_check_interval);
+
+      using Clock = std::chrono::steady_clock;
+
+      struct IdleConnection {
+        std::unique_ptr<pqxx::lazyconnection> connection;
+        Clock::time_point returned;
+      };
+
+      /**
+       * Check that idle connection can still be used
+       * @param idle - connection to check
+       * @return true if connection is alive
+       */
+      bool isHealthy(const IdleConnection &idle) const;
+
+      /**
+       * Bring returned connection to the state of a new one: open
+       * transaction is rolled back and session state is discarded, except
+       * for prepared statements, which are tracked by pqxx
+       * @param connection - connection to reset
+       * @return true if connection can be reused
+       */
+      bool reset(pqxx::lazyconnection &connection) const;
+
+      /**
+       * Put connection back to the pool, connections which are broken or
+       * cannot be reset are closed
+       * @param connection - connection to return
+       */
+      void giveBack(pqxx::lazyconnection *connection);
+
+      /**
+       * Wrap connection so that it returns to the pool on destruction
+       */
+      PooledConnection wrap(std::unique_ptr<pqxx::lazyconnection> connection);
+
+      const std::string postgres_options_;
+      const size_t capacity_;
+      const std::chrono::milliseconds checkout_timeout_;
+      const std::chrono::milliseconds health_check_interval_;
+
+      mutable std::mutex mutex_;
+      std::condition_variable returned_;
+      std::vector<IdleConnection> idle_;
+      Statistics statistics_{};
+
+      logger::Logger log_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_POSTGRES_CONNECTION_POOL_HPP
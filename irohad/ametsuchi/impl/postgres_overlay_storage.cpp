@@ -0,0 +1,172 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/postgres_overlay_storage.hpp"
+
+#include "backend/protobuf/common_objects/account.hpp"
+#include "backend/protobuf/common_objects/peer.hpp"
+#include "builders/protobuf/common_objects/proto_account_builder.hpp"
+#include "builders/protobuf/common_objects/proto_peer_builder.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    using shared_model::interface::types::AccountIdType;
+    using shared_model::interface::types::AssetIdType;
+    using shared_model::interface::types::DomainIdType;
+    using shared_model::interface::types::PubkeyType;
+
+    PostgresOverlayStorage::PostgresOverlayStorage(
+        pqxx::nontransaction &transaction)
+        : transaction_(transaction),
+          execute_{makeExecuteResult(transaction_)} {}
+
+    std::string PostgresOverlayStorage::quote(
+        const PubkeyType &public_key) const {
+      return transaction_.quote(
+          pqxx::binarystring(public_key.blob().data(), public_key.size()));
+    }
+
+    OverlayStorage::Result<bool> PostgresOverlayStorage::exists(
+        const std::string &query) {
+      return execute_(query) |
+          [](const pqxx::result &result) -> Result<bool> {
+        return expected::makeValue(not result.empty());
+      };
+    }
+
+    OverlayStorage::Result<std::string> PostgresOverlayStorage::evaluate(
+        const std::string &expression) {
+      // failed statement aborts the whole transaction block, so only the
+      // savepoint is rolled back
+      auto result = execute_("SAVEPOINT overlay_storage_;\nSELECT ("
+                             + expression + ")::text;");
+      return result.match(
+          [this](expected::Value<pqxx::result> &v) -> Result<std::string> {
+            execute_("RELEASE SAVEPOINT overlay_storage_;");
+            const auto field = v.value.at(0).at(0);
+            return expected::makeValue(field.is_null()
+                                           ? std::string{}
+                                           : field.as<std::string>());
+          },
+          [this](expected::Error<std::string> &e) -> Result<std::string> {
+            execute_("ROLLBACK TO SAVEPOINT overlay_storage_;");
+            return expected::makeError(e.error);
+          });
+    }
+
+    OverlayStorage::Result<
+        boost::optional<std::shared_ptr<shared_model::interface::Account>>>
+    PostgresOverlayStorage::getAccount(const AccountIdType &account_id) {
+      using ReturnType = Result<
+          boost::optional<std::shared_ptr<shared_model::interface::Account>>>;
+      return execute_("SELECT * FROM account WHERE account_id = "
+                      + transaction_.quote(account_id) + ";")
+                 | [](const pqxx::result &result) -> ReturnType {
+        boost::optional<std::shared_ptr<shared_model::interface::Account>>
+            account;
+        if (not result.empty()) {
+          const auto &row = result.at(0);
+          auto data = row.at("data");
+          account = std::make_shared<shared_model::proto::Account>(
+              shared_model::proto::AccountBuilder()
+                  .accountId(row.at("account_id").as<std::string>())
+                  .domainId(row.at("domain_id").as<std::string>())
+                  .quorum(row.at("quorum")
+                              .as<shared_model::interface::types::QuorumType>())
+                  .jsonData(data.is_null() ? std::string{}
+                                           : data.as<std::string>())
+                  .build());
+        }
+        return expected::makeValue(std::move(account));
+      };
+    }
+
+    OverlayStorage::Result<bool> PostgresOverlayStorage::hasAsset(
+        const AssetIdType &asset_id) {
+      return exists("SELECT 1 FROM asset WHERE asset_id = "
+                    + transaction_.quote(asset_id) + ";");
+    }
+
+    OverlayStorage::Result<bool> PostgresOverlayStorage::hasDomain(
+        const DomainIdType &domain_id) {
+      return exists("SELECT 1 FROM domain WHERE domain_id = "
+                    + transaction_.quote(domain_id) + ";");
+    }
+
+    OverlayStorage::Result<bool> PostgresOverlayStorage::hasSignatory(
+        const PubkeyType &signatory) {
+      return exists("SELECT 1 FROM signatory WHERE public_key = "
+                    + quote(signatory) + ";");
+    }
+
+    OverlayStorage::Result<std::vector<AccountIdType>>
+    PostgresOverlayStorage::getSignatoryAccounts(const PubkeyType &signatory) {
+      return execute_(
+                 "SELECT account_id FROM account_has_signatory WHERE "
+                 "public_key = "
+                 + quote(signatory) + ";")
+                 | [](const pqxx::result &result)
+                 -> Result<std::vector<AccountIdType>> {
+        return expected::makeValue(
+            transform<AccountIdType>(result, [](const auto &row) {
+              return row.at("account_id").template as<std::string>();
+            }));
+      };
+    }
+
+    OverlayStorage::Result<
+        std::vector<std::shared_ptr<shared_model::interface::Peer>>>
+    PostgresOverlayStorage::getPeers() {
+      using PeerPtr = std::shared_ptr<shared_model::interface::Peer>;
+      return execute_("SELECT * FROM peer;")
+                 | [](const pqxx::result &result)
+                 -> Result<std::vector<PeerPtr>> {
+        return expected::makeValue(
+            transform<PeerPtr>(result, [](const auto &row) -> PeerPtr {
+              pqxx::binarystring public_key(row.at("public_key"));
+              return std::make_shared<shared_model::proto::Peer>(
+                  shared_model::proto::PeerBuilder()
+                      .pubkey(PubkeyType(public_key.str()))
+                      .address(row.at("address").template as<std::string>())
+                      .build());
+            }));
+      };
+    }
+
+    OverlayStorage::Result<std::string> PostgresOverlayStorage::normalizeJson(
+        const std::string &json_data) {
+      return evaluate("CAST(" + transaction_.quote(json_data) + " AS jsonb)");
+    }
+
+    OverlayStorage::Result<std::string>
+    PostgresOverlayStorage::setAccountDetail(
+        const boost::optional<std::string> &json_data,
+        const AccountIdType &creator_account_id,
+        const std::string &key,
+        const std::string &val) {
+      // jsonb_set is strict, so for null data only the arguments are parsed,
+      // as for an update which matches no rows
+      auto data = json_data
+          ? "CAST(" + transaction_.quote(*json_data) + " AS jsonb)"
+          : std::string("CAST(NULL AS jsonb)");
+      return evaluate(
+          makeSetAccountDetail(transaction_, data, creator_account_id, key, val));
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,90 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_POSTGRES_OVERLAY_STORAGE_HPP
+#define IROHA_POSTGRES_OVERLAY_STORAGE_HPP
+
+#include "ametsuchi/impl/overlay_storage.hpp"
+#include "ametsuchi/impl/postgres_wsv_common.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Reads rows and evaluates json data in a Postgres transaction block.
+     * Json data is evaluated with the same SQL expressions as
+     * PostgresWsvCommand uses, in a savepoint, so that an error does not
+     * abort the transaction
+     */
+    class PostgresOverlayStorage : public OverlayStorage {
+     public:
+      explicit PostgresOverlayStorage(pqxx::nontransaction &transaction);
+
+      Result<boost::optional<std::shared_ptr<shared_model::interface::Account>>>
+      getAccount(const shared_model::interface::types::AccountIdType
+                     &account_id) override;
+
+      Result<bool> hasAsset(
+          const shared_model::interface::types::AssetIdType &asset_id) override;
+
+      Result<bool> hasDomain(const shared_model::interface::types::DomainIdType
+                                 &domain_id) override;
+
+      Result<bool> hasSignatory(
+          const shared_model::interface::types::PubkeyType &signatory) override;
+
+      Result<std::vector<shared_model::interface::types::AccountIdType>>
+      getSignatoryAccounts(
+          const shared_model::interface::types::PubkeyType &signatory) override;
+
+      Result<std::vector<std::shared_ptr<shared_model::interface::Peer>>>
+      getPeers() override;
+
+      Result<std::string> normalizeJson(const std::string &json_data) override;
+
+      Result<std::string> setAccountDetail(
+          const boost::optional<std::string> &json_data,
+          const shared_model::interface::types::AccountIdType
+              &creator_account_id,
+          const std::string &key,
+          const std::string &val) override;
+
+     private:
+      std::string quote(
+          const shared_model::interface::types::PubkeyType &public_key) const;
+
+      /**
+       * @return true if query returns any row
+       */
+      Result<bool> exists(const std::string &query);
+
+      /**
+       * Evaluate SQL expression in a savepoint
+       * @return text of the expression value, empty if it is null
+       */
+      Result<std::string> evaluate(const std::string &expression);
+
+      pqxx::nontransaction &transaction_;
+
+      using ExecuteType = decltype(makeExecuteResult(transaction_));
+      ExecuteType execute_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_POSTGRES_OVERLAY_STORAGE_HPP
@@ -380,14 +380,10 @@ namespace iroha {
         const std::string &key,
         const std::string &val) {
       auto result = execute_(
-          "UPDATE account SET data = jsonb_set(CASE WHEN data ?"
-          + transaction_.quote(creator_account_id)
-          + " THEN data ELSE jsonb_set(data, "
-          + transaction_.quote("{" + creator_account_id + "}") + ","
-          + transaction_.quote("{}") + ") END,"
-          + transaction_.quote("{" + creator_account_id + ", " + key + "}")
-          + "," + transaction_.quote("\"" + val + "\"")
-          + ") WHERE account_id=" + transaction_.quote(account_id) + ";");
+          "UPDATE account SET data = "
+          + makeSetAccountDetail(
+                transaction_, "data", creator_account_id, key, val)
+          + " WHERE account_id=" + transaction_.quote(account_id) + ";");
 
       auto message_gen = [&] {
         return (boost::format(
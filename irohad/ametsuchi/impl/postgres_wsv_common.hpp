@@ -69,6 +69,56 @@ namespace iroha {
       };
     }
 
+    /**
+     * Format strings as PostgreSQL array literal, which can be passed as a
+     * single parameter of prepared statement and expanded with unnest()
+     * @param values - array elements
+     * @return array literal, e.g. {"a","b"}
+     */
+    inline std::string makeArrayLiteral(const std::vector<std::string> &values) {
+      std::string literal = "{";
+      for (const auto &value : values) {
+        if (literal.size() > 1) {
+          literal += ',';
+        }
+        literal += '"';
+        for (auto c : value) {
+          if (c == '"' or c == '\\') {
+            literal += '\\';
+          }
+          literal += c;
+        }
+        literal += '"';
+      }
+      literal += '}';
+      return literal;
+    }
+
+    /**
+     * Make SQL expression of account json data after SetAccountDetail, so
+     * that stored and in-memory data are changed by the same expression
+     * @param transaction - transaction to quote arguments
+     * @param data - SQL expression of the current jsonb data
+     * @param creator_account_id - account which sets the detail
+     * @param key - detail key
+     * @param val - detail value
+     * @return jsonb expression with data[creator_account_id][key] = val
+     */
+    inline std::string makeSetAccountDetail(
+        pqxx::nontransaction &transaction,
+        const std::string &data,
+        const std::string &creator_account_id,
+        const std::string &key,
+        const std::string &val) {
+      return "jsonb_set(CASE WHEN " + data + " ?"
+          + transaction.quote(creator_account_id) + " THEN " + data
+          + " ELSE jsonb_set(" + data + ", "
+          + transaction.quote("{" + creator_account_id + "}") + ","
+          + transaction.quote("{}") + ") END,"
+          + transaction.quote("{" + creator_account_id + ", " + key + "}")
+          + "," + transaction.quote("\"" + val + "\"") + ")";
+    }
+
     /**
      * Transforms pqxx::result to vector of Ts by applying transform_func
      * @tparam T - type to transform to
@@ -41,7 +41,7 @@ namespace iroha {
           execute_{makeExecuteOptional(transaction_, log_)} {}
 
     PostgresWsvQuery::PostgresWsvQuery(
-        std::unique_ptr<pqxx::lazyconnection> connection,
+        PooledConnection connection,
         std::unique_ptr<pqxx::nontransaction> transaction)
         : connection_ptr_(std::move(connection)),
           transaction_ptr_(std::move(transaction)),
@@ -22,6 +22,7 @@
 
 #include <pqxx/connection>
 
+#include "ametsuchi/impl/postgres_connection_pool.hpp"
 #include "postgres_wsv_common.hpp"
 
 namespace iroha {
@@ -29,7 +30,7 @@ namespace iroha {
     class PostgresWsvQuery : public WsvQuery {
      public:
       explicit PostgresWsvQuery(pqxx::nontransaction &transaction);
-      PostgresWsvQuery(std::unique_ptr<pqxx::lazyconnection> connection,
+      PostgresWsvQuery(PooledConnection connection,
                        std::unique_ptr<pqxx::nontransaction> transaction);
       boost::optional<std::vector<shared_model::interface::types::RoleIdType>>
       getAccountRoles(const shared_model::interface::types::AccountIdType
@@ -71,7 +72,7 @@ namespace iroha {
               &permission_id) override;
 
      private:
-      std::unique_ptr<pqxx::lazyconnection> connection_ptr_;
+      PooledConnection connection_ptr_;
       std::unique_ptr<pqxx::nontransaction> transaction_ptr_;
 
       pqxx::nontransaction &transaction_;
@@ -0,0 +1,185 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/postgres_wsv_writer.hpp"
+
+#include <boost/format.hpp>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    PostgresWsvWriter::PostgresWsvWriter(pqxx::nontransaction &transaction)
+        : transaction_(transaction),
+          execute_{makeExecuteResult(transaction_)} {}
+
+    std::string PostgresWsvWriter::quote(
+        const shared_model::interface::types::PubkeyType &public_key) const {
+      return transaction_.quote(
+          pqxx::binarystring(public_key.blob().data(), public_key.size()));
+    }
+
+    std::string PostgresWsvWriter::quoteHex(const std::string &hex) const {
+      return quote(shared_model::interface::types::PubkeyType(
+          shared_model::crypto::Blob::fromHexString(hex)));
+    }
+
+    void PostgresWsvWriter::appendStatements(const WsvOverlay::Layer &changes,
+                                             std::string &statements) const {
+      auto append = [&statements](const std::string &statement) {
+        statements += statement;
+        statements += ";\n";
+      };
+
+      for (const auto &role : changes.roles) {
+        append("INSERT INTO role(role_id) VALUES (" + transaction_.quote(role)
+               + ")");
+      }
+      for (const auto &role : changes.role_permissions) {
+        const auto role_id = transaction_.quote(role.first);
+        append("DELETE FROM role_has_permissions WHERE role_id=" + role_id);
+        for (const auto &permission : role.second) {
+          append("INSERT INTO role_has_permissions(role_id, permission_id) "
+                 "VALUES ("
+                 + role_id + ", " + transaction_.quote(permission) + ")");
+        }
+      }
+      for (const auto &domain : changes.domains) {
+        append("INSERT INTO domain(domain_id, default_role) VALUES ("
+               + transaction_.quote(domain.second->domainId()) + ", "
+               + transaction_.quote(domain.second->defaultRole()) + ")");
+      }
+      for (const auto &row : changes.signatory_rows) {
+        if (row.second) {
+          append("INSERT INTO signatory(public_key) VALUES ("
+                 + quoteHex(row.first) + ") ON CONFLICT DO NOTHING");
+        }
+      }
+      for (const auto &entry : changes.accounts) {
+        const auto &account = *entry.second;
+        const auto account_id = transaction_.quote(account.accountId());
+        if (changes.created_accounts.count(entry.first) != 0) {
+          // the same row as PostgresWsvCommand::insertAccount writes, which
+          // fails on existing account
+          append("INSERT INTO account(account_id, domain_id, quorum, "
+                 "transaction_count, data) VALUES ("
+                 + account_id + ", " + transaction_.quote(account.domainId())
+                 + ", " + transaction_.quote(account.quorum()) + ", "
+                 + transaction_.quote(default_tx_counter) + ", "
+                 + transaction_.quote(account.jsonData()) + ")");
+          continue;
+        }
+        // data read from the storage is empty only if it is NULL, which
+        // account detail commands keep unchanged
+        auto data = account.jsonData().empty()
+            ? std::string()
+            : ", data = " + transaction_.quote(account.jsonData());
+        append("UPDATE account SET quorum = "
+               + transaction_.quote(account.quorum()) + data
+               + " WHERE account_id = " + account_id);
+      }
+      for (const auto &entry : changes.assets) {
+        const auto &asset = *entry.second;
+        uint32_t precision = asset.precision();
+        append("INSERT INTO asset(asset_id, domain_id, \"precision\", data) "
+               "VALUES ("
+               + transaction_.quote(asset.assetId()) + ", "
+               + transaction_.quote(asset.domainId()) + ", "
+               + transaction_.quote(precision) + ", NULL)");
+      }
+      for (const auto &entry : changes.account_assets) {
+        const auto &asset = *entry.second;
+        append("INSERT INTO account_has_asset(account_id, asset_id, amount) "
+               "VALUES ("
+               + transaction_.quote(asset.accountId()) + ", "
+               + transaction_.quote(asset.assetId()) + ", "
+               + transaction_.quote(asset.balance().toStringRepr())
+               + ") ON CONFLICT (account_id, asset_id) DO UPDATE SET "
+                 "amount = EXCLUDED.amount");
+      }
+      for (const auto &account : changes.account_roles) {
+        const auto account_id = transaction_.quote(account.first);
+        append("DELETE FROM account_has_roles WHERE account_id="
+               + account_id);
+        for (const auto &role : account.second) {
+          append("INSERT INTO account_has_roles(account_id, role_id) VALUES ("
+                 + account_id + ", " + transaction_.quote(role) + ")");
+        }
+      }
+      for (const auto &account : changes.signatories) {
+        const auto account_id = transaction_.quote(account.first);
+        append("DELETE FROM account_has_signatory WHERE account_id="
+               + account_id);
+        for (const auto &signatory : account.second) {
+          append("INSERT INTO account_has_signatory(account_id, public_key) "
+                 "VALUES ("
+                 + account_id + ", " + quote(signatory) + ")");
+        }
+      }
+      for (const auto &permission : changes.grantable_permissions) {
+        const auto permittee_account_id =
+            transaction_.quote(std::get<0>(permission.first));
+        const auto account_id =
+            transaction_.quote(std::get<1>(permission.first));
+        const auto permission_id =
+            transaction_.quote(std::get<2>(permission.first));
+        if (permission.second) {
+          append("INSERT INTO account_has_grantable_permissions("
+                 "permittee_account_id, account_id, permission_id) VALUES ("
+                 + permittee_account_id + ", " + account_id + ", "
+                 + permission_id + ") ON CONFLICT DO NOTHING");
+        } else {
+          append("DELETE FROM account_has_grantable_permissions WHERE "
+                 "permittee_account_id="
+                 + permittee_account_id + " AND account_id=" + account_id
+                 + " AND permission_id=" + permission_id);
+        }
+      }
+      if (changes.peers) {
+        append("DELETE FROM peer");
+        for (const auto &peer : *changes.peers) {
+          append("INSERT INTO peer(public_key, address) VALUES ("
+                 + quote(peer->pubkey()) + ", "
+                 + transaction_.quote(peer->address()) + ")");
+        }
+      }
+      // overlay removes signatory only when no account and no peer has it
+      for (const auto &row : changes.signatory_rows) {
+        if (not row.second) {
+          append("DELETE FROM signatory WHERE public_key = "
+                 + quoteHex(row.first));
+        }
+      }
+    }
+
+    WsvCommandResult PostgresWsvWriter::write(
+        const WsvOverlay::Layer &changes) {
+      std::string statements;
+      appendStatements(changes, statements);
+
+      return execute_(statements).match(
+          [](expected::Value<pqxx::result> &) -> WsvCommandResult {
+            return {};
+          },
+          [](expected::Error<std::string> &e) -> WsvCommandResult {
+            return expected::makeError(
+                (boost::format("failed to write changes of block: %s")
+                 % e.error)
+                    .str());
+          });
+    }
+  }  // namespace ametsuchi
+}  // namespace iroha
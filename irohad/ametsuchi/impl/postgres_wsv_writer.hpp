@@ -0,0 +1,75 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_POSTGRES_WSV_WRITER_HPP
+#define IROHA_POSTGRES_WSV_WRITER_HPP
+
+#include <string>
+
+#include "ametsuchi/impl/postgres_wsv_common.hpp"
+#include "ametsuchi/impl/wsv_overlay.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Writes the write set of overlay to Postgres. Every entity is written
+     * in its final state: rows are inserted or updated as PostgresWsvCommand
+     * does, and lists are replaced, so that all changes of a block are sent
+     * in a single batch of statements
+     */
+    class PostgresWsvWriter {
+     public:
+      explicit PostgresWsvWriter(pqxx::nontransaction &transaction);
+
+      /**
+       * Write changes in a single round trip. A failed statement aborts the
+       * enclosing transaction, so callers which continue after failure
+       * write within a savepoint
+       * @param changes - final state of written entities
+       * @return error message if any statement fails
+       */
+      WsvCommandResult write(const WsvOverlay::Layer &changes);
+
+      /**
+       * Append statements of all changes in order satisfying foreign keys
+       * @param changes - entities to write
+       * @param statements - batch to append to
+       */
+      void appendStatements(const WsvOverlay::Layer &changes,
+                            std::string &statements) const;
+
+     private:
+      std::string quote(
+          const shared_model::interface::types::PubkeyType &public_key) const;
+
+      /**
+       * @param hex - hex string of public key
+       */
+      std::string quoteHex(const std::string &hex) const;
+
+      const size_t default_tx_counter = 0;
+
+      pqxx::nontransaction &transaction_;
+
+      using ExecuteType = decltype(makeExecuteResult(transaction_));
+      ExecuteType execute_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_POSTGRES_WSV_WRITER_HPP
@@ -0,0 +1,138 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/schema_migration.hpp"
+
+#include <boost/format.hpp>
+
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    namespace {
+      /**
+       * Migration steps, i-th step moves schema from version i + 1 to i + 2
+       */
+      const char *kMigrations[] = {
+          // 2: typed columns of index tables, indexes for block queries
+          R"(
+ALTER TABLE height_by_hash
+    ALTER COLUMN height TYPE bigint USING height::bigint;
+ALTER TABLE height_by_account_set
+    ALTER COLUMN height TYPE bigint USING height::bigint;
+ALTER TABLE index_by_creator_height
+    ALTER COLUMN height TYPE bigint USING height::bigint,
+    ALTER COLUMN index TYPE bigint USING index::bigint;
+ALTER TABLE index_by_id_height_asset
+    ALTER COLUMN height TYPE bigint USING height::bigint,
+    ALTER COLUMN index TYPE bigint USING index::bigint;
+CREATE INDEX IF NOT EXISTS height_by_hash_hash_index
+    ON height_by_hash USING hash (hash);
+CREATE INDEX IF NOT EXISTS height_by_account_set_account_id_height_index
+    ON height_by_account_set (account_id, height);
+CREATE INDEX IF NOT EXISTS index_by_creator_height_creator_id_height_index
+    ON index_by_creator_height (creator_id, height);
+CREATE INDEX IF NOT EXISTS index_by_id_height_asset_id_asset_id_height_index
+    ON index_by_id_height_asset (id, asset_id, height);
+)",
+          // 3: ordered account transactions history
+          R"(
+DROP INDEX IF EXISTS index_by_creator_height_creator_id_height_index;
+DROP INDEX IF EXISTS index_by_id_height_asset_id_asset_id_height_index;
+CREATE INDEX IF NOT EXISTS index_by_creator_height_creator_id_height_index_index
+    ON index_by_creator_height (creator_id, height, index);
+CREATE INDEX IF NOT EXISTS index_by_id_height_asset_id_asset_id_height_index_index
+    ON index_by_id_height_asset (id, asset_id, height, index);
+)",
+          // 4: block hash index, filled by data migration
+          R"(
+CREATE TABLE IF NOT EXISTS height_by_block_hash (
+    hash bytea,
+    height bigint NOT NULL,
+    PRIMARY KEY (hash)
+);
+)"};
+
+      static_assert(sizeof(kMigrations) / sizeof(*kMigrations)
+                        == kSchemaVersion - 1,
+                    "Every schema version must have a migration");
+    }  // namespace
+
+    expected::Result<int, std::string> migrateSchema(
+        pqxx::nontransaction &transaction,
+        const std::map<int, DataMigration> &data_migrations) {
+      auto log = logger::log("SchemaMigration");
+      try {
+        transaction.exec(
+            "CREATE TABLE IF NOT EXISTS schema_version ("
+            "version integer NOT NULL);");
+        auto result = transaction.exec("SELECT version FROM schema_version;");
+        int version;
+        if (result.empty()) {
+          // database is either empty, so current schema will be created,
+          // or it was created before the schema was versioned
+          version = transaction
+                  .exec(
+                      "SELECT to_regclass('height_by_hash') IS NOT NULL "
+                      "AS legacy;")[0]
+                  .at("legacy")
+                  .as<bool>()
+              ? 1
+              : kSchemaVersion;
+          transaction.exec("INSERT INTO schema_version(version) VALUES ("
+                           + transaction.quote(version) + ");");
+        } else {
+          version = result[0].at("version").as<int>();
+        }
+
+        if (version > kSchemaVersion) {
+          return expected::makeError(
+              (boost::format("Schema version %d is newer than supported %d")
+               % version % kSchemaVersion)
+                  .str());
+        }
+        if (version == kSchemaVersion) {
+          return expected::Value<int>{version};
+        }
+
+        transaction.exec("BEGIN;");
+        for (auto step = version; step < kSchemaVersion; ++step) {
+          log->info("migrate schema to version {}", step + 1);
+          transaction.exec(kMigrations[step - 1]);
+          auto data_migration = data_migrations.find(step + 1);
+          if (data_migration != data_migrations.end()) {
+            data_migration->second(transaction);
+          }
+        }
+        transaction.exec("UPDATE schema_version SET version = "
+                         + transaction.quote(kSchemaVersion) + ";");
+        transaction.exec("COMMIT;");
+        return expected::Value<int>{version};
+      } catch (const std::exception &e) {
+        try {
+          transaction.exec("ROLLBACK;");
+        } catch (const std::exception &) {
+          // connection is broken, nothing to roll back
+        }
+        return expected::makeError(
+            (boost::format("Schema migration failed: %s") % e.what()).str());
+      }
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
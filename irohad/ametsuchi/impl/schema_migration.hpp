@@ -0,0 +1,59 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_SCHEMA_MIGRATION_HPP
+#define IROHA_SCHEMA_MIGRATION_HPP
+
+#include <functional>
+#include <map>
+#include <pqxx/nontransaction>
+#include <string>
+
+#include "common/result.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Version of Postgres schema created by StorageImpl, stored in
+     * schema_version table
+     */
+    const int kSchemaVersion = 4;
+
+    /**
+     * Migration of data which is not derived from the database itself,
+     * e.g. rows built from the block store. It throws on failure
+     */
+    using DataMigration = std::function<void(pqxx::nontransaction &)>;
+
+    /**
+     * Bring schema of an existing database to kSchemaVersion. Databases
+     * created before the schema was versioned are treated as version 1.
+     * All migration steps are applied in a single transaction
+     * @param transaction - connection to the database
+     * @param data_migrations - version -> data migration, which is run right
+     * after the schema is migrated to that version
+     * @return schema version before migration or error
+     */
+    expected::Result<int, std::string> migrateSchema(
+        pqxx::nontransaction &transaction,
+        const std::map<int, DataMigration> &data_migrations = {});
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_SCHEMA_MIGRATION_HPP
@@ -16,13 +16,14 @@
  */
 
 #include "ametsuchi/impl/storage_impl.hpp"
+#include <boost/filesystem.hpp>
 #include <boost/format.hpp>
 #include "ametsuchi/impl/flat_file/flat_file.hpp"  // for FlatFile
 #include "ametsuchi/impl/mutable_storage_impl.hpp"
 #include "ametsuchi/impl/postgres_block_query.hpp"
 #include "ametsuchi/impl/postgres_wsv_query.hpp"
+#include "ametsuchi/impl/schema_migration.hpp"
 #include "ametsuchi/impl/temporary_wsv_impl.hpp"
-#include "model/converters/json_common.hpp"
 #include "postgres_ordering_service_persistent_state.hpp"
 
 // TODO: 14-02-2018 Alexey Chernyshov remove this after relocation to
@@ -35,6 +36,46 @@ namespace iroha {
     const char *kCommandExecutorError = "Cannot create CommandExecutorFactory";
     const char *kPsqlBroken = "Connection to PostgreSQL broken: %s";
     const char *kTmpWsv = "TemporaryWsv";
+    const size_t kConnectionPoolSize = 16;
+    const char *kSnapshotDirSuffix = "_snapshots";
+
+    namespace {
+      /**
+       * Index hashes of stored blocks which are missing in
+       * height_by_block_hash, for a ledger written before the table was
+       * introduced
+       * @param transaction - connection to the database
+       * @param block_store - stored blocks
+       * @throw std::runtime_error if a stored block cannot be read
+       */
+      void indexBlockHashes(pqxx::nontransaction &transaction,
+                            const FlatFile &block_store) {
+        BlockSerializer serializer;
+        auto indexed = transaction
+                           .exec(
+                               "SELECT COALESCE(MAX(height), 0) AS height "
+                               "FROM height_by_block_hash;")[0]
+                           .at("height")
+                           .as<shared_model::interface::types::HeightType>();
+        for (auto height = indexed + 1; height <= block_store.last_id();
+             ++height) {
+          auto block = block_store.getView(height) | [&](const auto &view) {
+            return serializer.deserialize(view.data(), view.size());
+          };
+          if (not block) {
+            throw std::runtime_error(
+                (boost::format("cannot index hash of block %d") % height)
+                    .str());
+          }
+          const auto &hash = block->hash().blob();
+          transaction.exec(
+              "INSERT INTO height_by_block_hash(hash, height) VALUES ("
+              + transaction.quote(pqxx::binarystring(hash.data(), hash.size()))
+              + ", " + transaction.quote(height)
+              + ") ON CONFLICT (hash) DO NOTHING;");
+        }
+      }
+    }  // namespace
 
     ConnectionContext::ConnectionContext(
         std::unique_ptr<FlatFile> block_store,
@@ -45,6 +86,9 @@ namespace iroha {
           pg_nontx(std::move(pg_nontx)) {}
 
     StorageImpl::~StorageImpl() {
+      if (snapshot_task_.valid()) {
+        snapshot_task_.wait();
+      }
       wsv_transaction_->commit();
       wsv_connection_->disconnect();
       log_->info("PostgresQL connection closed");
@@ -55,16 +99,31 @@ namespace iroha {
         std::string postgres_options,
         std::unique_ptr<FlatFile> block_store,
         std::unique_ptr<pqxx::lazyconnection> wsv_connection,
-        std::unique_ptr<pqxx::nontransaction> wsv_transaction)
+        std::unique_ptr<pqxx::nontransaction> wsv_transaction,
+        std::unique_ptr<WsvSnapshotStore> snapshots,
+        size_t snapshot_interval)
         : block_store_dir_(std::move(block_store_dir)),
           postgres_options_(std::move(postgres_options)),
           block_store_(std::move(block_store)),
           wsv_connection_(std::move(wsv_connection)),
           wsv_transaction_(std::move(wsv_transaction)),
           wsv_(std::make_shared<PostgresWsvQuery>(*wsv_transaction_)),
-          blocks_(std::make_shared<PostgresBlockQuery>(*wsv_transaction_,
-                                                       *block_store_)) {
+          connection_pool_(PostgresConnectionPool::create(
+              postgres_options_, kConnectionPoolSize)),
+          block_cache_(std::make_shared<BlockCache>(
+              PostgresBlockQuery::kDefaultBlockCacheSize)),
+          blocks_(std::make_shared<PostgresBlockQuery>(
+              *wsv_transaction_, *block_store_, block_cache_)),
+          snapshots_(std::move(snapshots)),
+          snapshot_interval_(snapshots_ ? snapshot_interval : 0),
+          last_snapshot_height_(0) {
       log_ = logger::log("StorageImpl");
+      if (snapshots_) {
+        auto heights = snapshots_->heights();
+        if (not heights.empty()) {
+          last_snapshot_height_ = heights.front();
+        }
+      }
 
       wsv_transaction_->exec(init_);
       wsv_transaction_->exec(
@@ -73,47 +132,43 @@ namespace iroha {
 
     expected::Result<std::unique_ptr<TemporaryWsv>, std::string>
     StorageImpl::createTemporaryWsv() {
-      auto postgres_connection =
-          std::make_unique<pqxx::lazyconnection>(postgres_options_);
-      try {
-        postgres_connection->activate();
-      } catch (const pqxx::broken_connection &e) {
-        return expected::makeError(
-            (boost::format(kPsqlBroken) % e.what()).str());
-      }
-      auto wsv_transaction =
-          std::make_unique<pqxx::nontransaction>(*postgres_connection, kTmpWsv);
-
-      return expected::makeValue<std::unique_ptr<TemporaryWsv>>(
-          std::make_unique<TemporaryWsvImpl>(std::move(postgres_connection),
-                                             std::move(wsv_transaction)));
+      expected::Result<std::unique_ptr<TemporaryWsv>, std::string> result;
+      connection_pool_->checkout().match(
+          [&](expected::Value<PooledConnection> &connection) {
+            auto wsv_transaction = std::make_unique<pqxx::nontransaction>(
+                *connection.value, kTmpWsv);
+            result = expected::makeValue<std::unique_ptr<TemporaryWsv>>(
+                std::make_unique<TemporaryWsvImpl>(std::move(connection.value),
+                                                   std::move(wsv_transaction),
+                                                   connection_pool_));
+          },
+          [&](expected::Error<std::string> &error) { result = error; });
+      return result;
     }
 
     expected::Result<std::unique_ptr<MutableStorage>, std::string>
     StorageImpl::createMutableStorage() {
-      auto postgres_connection =
-          std::make_unique<pqxx::lazyconnection>(postgres_options_);
-      try {
-        postgres_connection->activate();
-      } catch (const pqxx::broken_connection &e) {
-        return expected::makeError(
-            (boost::format(kPsqlBroken) % e.what()).str());
-      }
-      auto wsv_transaction =
-          std::make_unique<pqxx::nontransaction>(*postgres_connection, kTmpWsv);
-
       boost::optional<shared_model::interface::types::HashType> top_hash;
 
+      // block query emits synchronously, so no thread is needed
       blocks_->getTopBlocks(1)
-          .subscribe_on(rxcpp::observe_on_new_thread())
           .as_blocking()
           .subscribe([&top_hash](auto block) { top_hash = block->hash(); });
 
-      return expected::makeValue<std::unique_ptr<MutableStorage>>(
-          std::make_unique<MutableStorageImpl>(
-              top_hash.value_or(shared_model::interface::types::HashType("")),
-              std::move(postgres_connection),
-              std::move(wsv_transaction)));
+      expected::Result<std::unique_ptr<MutableStorage>, std::string> result;
+      connection_pool_->checkout().match(
+          [&](expected::Value<PooledConnection> &connection) {
+            auto wsv_transaction = std::make_unique<pqxx::nontransaction>(
+                *connection.value, kTmpWsv);
+            result = expected::makeValue<std::unique_ptr<MutableStorage>>(
+                std::make_unique<MutableStorageImpl>(
+                    top_hash.value_or(
+                        shared_model::interface::types::HashType("")),
+                    std::move(connection.value),
+                    std::move(wsv_transaction)));
+          },
+          [&](expected::Error<std::string> &error) { result = error; });
+      return result;
     }
 
     bool StorageImpl::insertBlock(const shared_model::interface::Block &block) {
@@ -166,6 +221,23 @@ namespace iroha {
 
     void StorageImpl::dropStorage() {
       log_->info("Drop ledger");
+      dropWsv();
+
+      // erase blocks
+      log_->info("drop block store");
+      block_store_->dropAll();
+      block_cache_->clear();
+
+      if (snapshots_) {
+        if (snapshot_task_.valid()) {
+          snapshot_task_.wait();
+        }
+        snapshots_->dropAll();
+        last_snapshot_height_ = 0;
+      }
+    }
+
+    void StorageImpl::dropWsv() {
       auto drop = R"(
 DROP TABLE IF EXISTS account_has_signatory;
 DROP TABLE IF EXISTS account_has_asset;
@@ -179,6 +251,7 @@ DROP TABLE IF EXISTS signatory;
 DROP TABLE IF EXISTS peer;
 DROP TABLE IF EXISTS role;
 DROP TABLE IF EXISTS height_by_hash;
+DROP TABLE IF EXISTS height_by_block_hash;
 DROP TABLE IF EXISTS height_by_account_set;
 DROP TABLE IF EXISTS index_by_creator_height;
 DROP TABLE IF EXISTS index_by_id_height_asset;
@@ -194,10 +267,71 @@ DROP TABLE IF EXISTS index_by_id_height_asset;
       pqxx::work init_txn(connection);
       init_txn.exec(init_);
       init_txn.commit();
+    }
 
-      // erase blocks
-      log_->info("drop block store");
-      block_store_->dropAll();
+    boost::optional<shared_model::interface::types::HeightType>
+    StorageImpl::restoreWsvSnapshot() {
+      if (not snapshots_) {
+        return boost::none;
+      }
+      if (snapshot_task_.valid()) {
+        snapshot_task_.wait();
+      }
+      for (auto height : snapshots_->heights()) {
+        // snapshot is usable only for the blocks which are stored
+        auto header = snapshots_->header(height);
+        if (not header or height > block_store_->last_id()) {
+          continue;
+        }
+        auto block = block_store_->getView(height) |
+            [this](const auto &view) {
+              return serializer_.deserialize(view.data(), view.size());
+            };
+        if (not block or block->hash() != header->top_hash) {
+          log_->warn("snapshot at height {} does not match block store",
+                     height);
+          continue;
+        }
+
+        dropWsv();
+        try {
+          pqxx::connection connection(postgres_options_);
+          pqxx::work txn(connection);
+          if (snapshots_->load(height, txn)) {
+            txn.commit();
+            log_->info("WSV restored from snapshot at height {}", height);
+            return height;
+          }
+        } catch (const std::exception &e) {
+          log_->error("Cannot load snapshot at height {}: {}",
+                      height,
+                      e.what());
+        }
+      }
+      return boost::none;
+    }
+
+    void StorageImpl::scheduleSnapshot(
+        shared_model::interface::types::HeightType height) {
+      if (snapshot_interval_ == 0
+          or height < last_snapshot_height_ + snapshot_interval_) {
+        return;
+      }
+      // skip the snapshot if the previous one is still being written
+      if (snapshot_task_.valid()
+          and snapshot_task_.wait_for(std::chrono::seconds(0))
+              != std::future_status::ready) {
+        return;
+      }
+      last_snapshot_height_ = height;
+      snapshot_task_ = std::async(std::launch::async, [this] {
+        try {
+          pqxx::connection connection(postgres_options_);
+          snapshots_->save(connection);
+        } catch (const std::exception &e) {
+          log_->error("Cannot save snapshot: {}", e.what());
+        }
+      });
     }
 
     expected::Result<ConnectionContext, std::string>
@@ -228,6 +362,30 @@ DROP TABLE IF EXISTS index_by_id_height_asset;
           *postgres_connection, "Storage");
       log_->info("transaction to PostgreSQL initialized");
 
+      // hashes of blocks stored before the block hash index are indexed once,
+      // together with creation of the index table
+      std::map<int, DataMigration> data_migrations{
+          {4, [&block_store](pqxx::nontransaction &transaction) {
+             indexBlockHashes(transaction, **block_store);
+           }}};
+
+      boost::optional<std::string> migration_error;
+      migrateSchema(*wsv_transaction, data_migrations)
+          .match(
+              [&](expected::Value<int> &version) {
+                if (version.value != kSchemaVersion) {
+                  log_->info("schema migrated from version {} to {}",
+                             version.value,
+                             kSchemaVersion);
+                }
+              },
+              [&](expected::Error<std::string> &error) {
+                migration_error = error.error;
+              });
+      if (migration_error) {
+        return expected::makeError(*migration_error);
+      }
+
       return expected::makeValue(
           ConnectionContext(std::move(*block_store),
                             std::move(postgres_connection),
@@ -236,7 +394,24 @@ DROP TABLE IF EXISTS index_by_id_height_asset;
 
     expected::Result<std::shared_ptr<StorageImpl>, std::string>
     StorageImpl::create(std::string block_store_dir,
-                        std::string postgres_options) {
+                        std::string postgres_options,
+                        size_t snapshot_interval) {
+      std::unique_ptr<WsvSnapshotStore> snapshots;
+      if (snapshot_interval > 0) {
+        auto snapshot_dir = boost::filesystem::path(block_store_dir)
+                                .remove_trailing_separator()
+                                .string()
+            + kSnapshotDirSuffix;
+        auto store = WsvSnapshotStore::create(snapshot_dir);
+        if (not store) {
+          return expected::makeError(
+              (boost::format("Cannot create snapshot store in %s")
+               % snapshot_dir)
+                  .str());
+        }
+        snapshots = std::move(*store);
+      }
+
       auto ctx_result = initConnections(block_store_dir, postgres_options);
       expected::Result<std::shared_ptr<StorageImpl>, std::string> storage;
       ctx_result.match(
@@ -246,7 +421,9 @@ DROP TABLE IF EXISTS index_by_id_height_asset;
                                 postgres_options,
                                 std::move(ctx.value.block_store),
                                 std::move(ctx.value.pg_lazy),
-                                std::move(ctx.value.pg_nontx))));
+                                std::move(ctx.value.pg_nontx),
+                                std::move(snapshots),
+                                snapshot_interval)));
           },
           [&](expected::Error<std::string> &error) { storage = error; });
       return storage;
@@ -257,33 +434,58 @@ DROP TABLE IF EXISTS index_by_id_height_asset;
       auto storage_ptr = std::move(mutableStorage);  // get ownership of storage
       auto storage = static_cast<MutableStorageImpl *>(storage_ptr.get());
       for (const auto &block : storage->block_store_) {
-        // TODO: rework to shared model converters once they are available
-        // IR-1084 Nikita Alekseev
-        auto old_block =
-            *std::unique_ptr<model::Block>(block.second->makeOldModel());
-        block_store_->add(block.first,
-                          stringToBytes(model::converters::jsonToString(
-                              serializer_.serialize(old_block))));
+        // blocks replayed from the block store are not appended again
+        if (block.first > block_store_->last_id()) {
+          block_store_->add(block.first,
+                            serializer_.serialize(*block.second));
+        }
+        // mutable storage is destroyed after commit, so the block is not
+        // modified anymore and can be shared by cache. Blocks of other
+        // implementations are read from the block store on the first query
+        if (auto proto_block =
+                std::dynamic_pointer_cast<shared_model::proto::Block>(
+                    block.second)) {
+          block_cache_->addItem(block.first,
+                                shareBlock(std::move(proto_block)));
+        }
       }
 
       storage->transaction_->exec("COMMIT;");
       storage->committed = true;
-    }
-
-    std::shared_ptr<WsvQuery> StorageImpl::getWsvQuery() const {
-      auto postgres_connection =
-          std::make_unique<pqxx::lazyconnection>(postgres_options_);
-      try {
-        postgres_connection->activate();
-      } catch (const pqxx::broken_connection &e) {
-        // TODO 29.03.2018 vdrobny IR-1184 Handle this exception
-        throw pqxx::broken_connection(e);
+      if (not storage->block_store_.empty()) {
+        scheduleSnapshot(storage->block_store_.rbegin()->first);
       }
-      auto wsv_transaction =
-          std::make_unique<pqxx::nontransaction>(*postgres_connection);
+      log_->debug("block cache hits: {}, misses: {}",
+                  block_cache_->hits(),
+                  block_cache_->misses());
+      auto pool = connection_pool_->statistics();
+      log_->debug(
+          "connection pool: {}/{} in use, peak {}, {} of {} checkouts waited "
+          "{} us in total, {} us at most, {} timed out",
+          pool.in_use,
+          pool.capacity,
+          pool.peak_in_use,
+          pool.waits,
+          pool.checkouts,
+          pool.total_wait.count(),
+          pool.max_wait.count(),
+          pool.timeouts);
+    }
 
-      return std::make_shared<PostgresWsvQuery>(std::move(postgres_connection),
-                                                std::move(wsv_transaction));
+    boost::optional<std::shared_ptr<WsvQuery>> StorageImpl::getWsvQuery()
+        const {
+      boost::optional<std::shared_ptr<WsvQuery>> wsv;
+      connection_pool_->checkout().match(
+          [&](expected::Value<PooledConnection> &connection) {
+            auto wsv_transaction =
+                std::make_unique<pqxx::nontransaction>(*connection.value);
+            wsv = std::make_shared<PostgresWsvQuery>(
+                std::move(connection.value), std::move(wsv_transaction));
+          },
+          [this](expected::Error<std::string> &error) {
+            log_->error("cannot create WSV query: {}", error.error);
+          });
+      return wsv;
     }
 
     std::shared_ptr<BlockQuery> StorageImpl::getBlockQuery() const {
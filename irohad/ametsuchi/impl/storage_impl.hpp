@@ -22,10 +22,14 @@
 
 #include <cmath>
 #include <boost/optional.hpp>
+#include <future>
 #include <pqxx/pqxx>
 #include <shared_mutex>
+#include "ametsuchi/impl/block_serializer.hpp"
+#include "ametsuchi/impl/postgres_connection_pool.hpp"
+#include "ametsuchi/impl/postgres_block_query.hpp"
+#include "ametsuchi/impl/wsv_snapshot_store.hpp"
 #include "logger/logger.hpp"
-#include "model/converters/json_block_factory.hpp"
 
 namespace iroha {
   namespace ametsuchi {
@@ -48,8 +52,18 @@ namespace iroha {
           std::string block_store_dir, std::string postgres_options);
 
      public:
+      /**
+       * Create storage
+       * @param block_store_dir - directory of block store
+       * @param postgres_connection - connection options of WSV database
+       * @param snapshot_interval - number of blocks between WSV snapshots,
+       * which are stored next to block store, 0 disables snapshots
+       * @return created storage or error message
+       */
       static expected::Result<std::shared_ptr<StorageImpl>, std::string> create(
-          std::string block_store_dir, std::string postgres_connection);
+          std::string block_store_dir,
+          std::string postgres_connection,
+          size_t snapshot_interval = 0);
 
       expected::Result<std::unique_ptr<TemporaryWsv>, std::string>
       createTemporaryWsv() override;
@@ -74,9 +88,14 @@ namespace iroha {
 
       virtual void dropStorage() override;
 
+      void dropWsv() override;
+
+      boost::optional<shared_model::interface::types::HeightType>
+      restoreWsvSnapshot() override;
+
       void commit(std::unique_ptr<MutableStorage> mutableStorage) override;
 
-      std::shared_ptr<WsvQuery> getWsvQuery() const override;
+      boost::optional<std::shared_ptr<WsvQuery>> getWsvQuery() const override;
 
       std::shared_ptr<BlockQuery> getBlockQuery() const override;
 
@@ -87,7 +106,9 @@ namespace iroha {
                   std::string postgres_options,
                   std::unique_ptr<FlatFile> block_store,
                   std::unique_ptr<pqxx::lazyconnection> wsv_connection,
-                  std::unique_ptr<pqxx::nontransaction> wsv_transaction);
+                  std::unique_ptr<pqxx::nontransaction> wsv_transaction,
+                  std::unique_ptr<WsvSnapshotStore> snapshots = nullptr,
+                  size_t snapshot_interval = 0);
 
       /**
        * Folder with raw blocks
@@ -98,6 +119,13 @@ namespace iroha {
       const std::string postgres_options_;
 
      private:
+      /**
+       * Start saving snapshot in background if enough blocks were committed
+       * since the last one
+       * @param height - height of the committed top block
+       */
+      void scheduleSnapshot(shared_model::interface::types::HeightType height);
+
       std::unique_ptr<FlatFile> block_store_;
 
       /**
@@ -109,9 +137,27 @@ namespace iroha {
 
       std::shared_ptr<WsvQuery> wsv_;
 
+      /**
+       * Connections for temporary wsv, mutable storage and wsv queries
+       */
+      std::shared_ptr<PostgresConnectionPool> connection_pool_;
+
+      /**
+       * Recently committed and read blocks, shared with block query
+       */
+      std::shared_ptr<BlockCache> block_cache_;
+
       std::shared_ptr<BlockQuery> blocks_;
 
-      model::converters::JsonBlockFactory serializer_;
+      BlockSerializer serializer_;
+
+      /**
+       * Periodic WSV snapshots, null if disabled
+       */
+      std::unique_ptr<WsvSnapshotStore> snapshots_;
+      const size_t snapshot_interval_;
+      shared_model::interface::types::HeightType last_snapshot_height_;
+      std::future<void> snapshot_task_;
 
       // Allows multiple readers and a single writer
       std::shared_timed_mutex rw_lock_;
@@ -182,24 +228,37 @@ CREATE TABLE IF NOT EXISTS account_has_grantable_permissions (
 );
 CREATE TABLE IF NOT EXISTS height_by_hash (
     hash bytea,
-    height text
+    height bigint
+);
+CREATE INDEX IF NOT EXISTS height_by_hash_hash_index
+    ON height_by_hash USING hash (hash);
+CREATE TABLE IF NOT EXISTS height_by_block_hash (
+    hash bytea,
+    height bigint NOT NULL,
+    PRIMARY KEY (hash)
 );
 CREATE TABLE IF NOT EXISTS height_by_account_set (
     account_id text,
-    height text
+    height bigint
 );
+CREATE INDEX IF NOT EXISTS height_by_account_set_account_id_height_index
+    ON height_by_account_set (account_id, height);
 CREATE TABLE IF NOT EXISTS index_by_creator_height (
     id serial,
     creator_id text,
-    height text,
-    index text
+    height bigint,
+    index bigint
 );
+CREATE INDEX IF NOT EXISTS index_by_creator_height_creator_id_height_index_index
+    ON index_by_creator_height (creator_id, height, index);
 CREATE TABLE IF NOT EXISTS index_by_id_height_asset (
     id text,
-    height text,
+    height bigint,
     asset_id text,
-    index text
+    index bigint
 );
+CREATE INDEX IF NOT EXISTS index_by_id_height_asset_id_asset_id_height_index_index
+    ON index_by_id_height_asset (id, asset_id, height, index);
 )";
     };
   }  // namespace ametsuchi
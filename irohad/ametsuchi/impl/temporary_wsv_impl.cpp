@@ -17,40 +17,55 @@
 
 #include "ametsuchi/impl/temporary_wsv_impl.hpp"
 
-#include "ametsuchi/impl/postgres_wsv_command.hpp"
+#include <atomic>
+#include <exception>
+#include <thread>
+
+#include "ametsuchi/impl/cached_wsv_query.hpp"
+#include "ametsuchi/impl/postgres_overlay_storage.hpp"
 #include "ametsuchi/impl/postgres_wsv_query.hpp"
 #include "amount/amount.hpp"
 
 namespace iroha {
   namespace ametsuchi {
+
+    const size_t TemporaryWsvImpl::kMaxThreads = 4;
+
     TemporaryWsvImpl::TemporaryWsvImpl(
-        std::unique_ptr<pqxx::lazyconnection> connection,
-        std::unique_ptr<pqxx::nontransaction> transaction)
+        PooledConnection connection,
+        std::unique_ptr<pqxx::nontransaction> transaction,
+        std::shared_ptr<PostgresConnectionPool> pool)
         : connection_(std::move(connection)),
           transaction_(std::move(transaction)),
-          wsv_(std::make_unique<PostgresWsvQuery>(*transaction_)),
-          executor_(std::make_unique<PostgresWsvCommand>(*transaction_)),
+          pool_(std::move(pool)),
+          // committed state is not modified, so its reads are cached
+          committed_(std::make_shared<CachedWsvQuery>(
+              std::make_shared<PostgresWsvQuery>(*transaction_),
+              std::make_shared<WsvCache>())),
+          storage_(std::make_shared<PostgresOverlayStorage>(*transaction_)),
+          wsv_(std::make_shared<WsvOverlay>(committed_, storage_)),
+          command_executor_(std::make_shared<CommandExecutor>(wsv_, wsv_)),
+          command_validator_(std::make_shared<CommandValidator>(wsv_)),
           log_(logger::log("TemporaryWSV")) {
-      auto query = std::make_shared<PostgresWsvQuery>(*transaction_);
-      auto command = std::make_shared<PostgresWsvCommand>(*transaction_);
-      command_executor_ = std::make_shared<CommandExecutor>(query, command);
-      command_validator_ = std::make_shared<CommandValidator>(query);
-      transaction_->exec("BEGIN;");
+      transaction_->exec("BEGIN ISOLATION LEVEL REPEATABLE READ READ ONLY;");
     }
 
-    bool TemporaryWsvImpl::apply(
+    bool TemporaryWsvImpl::execute(
         const shared_model::interface::Transaction &tx,
-        std::function<bool(const shared_model::interface::Transaction &,
-                           WsvQuery &)> apply_function) {
+        const std::function<bool(const shared_model::interface::Transaction &,
+                                 WsvQuery &)> &apply_function,
+        WsvOverlay &wsv,
+        CommandExecutor &command_executor,
+        CommandValidator &command_validator) {
       const auto &tx_creator = tx.creatorAccountId();
-      command_executor_->setCreatorAccountId(tx_creator);
-      command_validator_->setCreatorAccountId(tx_creator);
-      auto execute_command = [this, &tx_creator](auto command) {
-        auto account = wsv_->getAccount(tx_creator).value();
-        if (not boost::apply_visitor(*command_validator_, command->get())) {
+      command_executor.setCreatorAccountId(tx_creator);
+      command_validator.setCreatorAccountId(tx_creator);
+      auto execute_command = [&](auto command) {
+        auto account = wsv.getAccount(tx_creator).value();
+        if (not boost::apply_visitor(command_validator, command->get())) {
           return false;
         }
-        auto result = boost::apply_visitor(*command_executor_, command->get());
+        auto result = boost::apply_visitor(command_executor, command->get());
         return result.match([](expected::Value<void> &v) { return true; },
                             [this](expected::Error<ExecutionError> &e) {
                               log_->error(e.error.toString());
@@ -58,20 +73,163 @@ namespace iroha {
                             });
       };
 
-      transaction_->exec("SAVEPOINT savepoint_;");
+      wsv.savepoint();
       auto result =
-          apply_function(tx, *wsv_)
+          apply_function(tx, wsv)
           and std::all_of(
                   tx.commands().begin(), tx.commands().end(), execute_command);
       if (result) {
-        transaction_->exec("RELEASE SAVEPOINT savepoint_;");
+        wsv.release();
       } else {
-        transaction_->exec("ROLLBACK TO SAVEPOINT savepoint_;");
+        wsv.rollback();
+      }
+      return result;
+    }
+
+    bool TemporaryWsvImpl::apply(
+        const shared_model::interface::Transaction &tx,
+        std::function<bool(const shared_model::interface::Transaction &,
+                           WsvQuery &)> apply_function) {
+      return execute(tx,
+                     apply_function,
+                     *wsv_,
+                     *command_executor_,
+                     *command_validator_);
+    }
+
+    size_t TemporaryWsvImpl::prepareWorkers(size_t wanted) {
+      if (not pool_) {
+        return 0;
+      }
+      while (workers_.size() < wanted) {
+        // keep at least a half of the pool for block commits and queries
+        auto statistics = pool_->statistics();
+        if ((statistics.capacity - statistics.in_use) * 2
+            <= statistics.capacity) {
+          break;
+        }
+        Worker worker;
+        auto checked_out = pool_->checkout().match(
+            [&worker](expected::Value<PooledConnection> &connection) {
+              worker.connection = std::move(connection.value);
+              return true;
+            },
+            [this](expected::Error<std::string> &error) {
+              log_->warn("no connection for concurrent validation: {}",
+                         error.error);
+              return false;
+            });
+        if (not checked_out) {
+          break;
+        }
+        try {
+          if (not snapshot_id_) {
+            snapshot_id_ = transaction_->exec("SELECT pg_export_snapshot();")
+                               .at(0)
+                               .at(0)
+                               .as<std::string>();
+          }
+          worker.transaction = std::make_unique<pqxx::nontransaction>(
+              *worker.connection, "TemporaryWsvWorker");
+          worker.transaction->exec(
+              "BEGIN ISOLATION LEVEL REPEATABLE READ READ ONLY;");
+          worker.transaction->exec("SET TRANSACTION SNAPSHOT "
+                                   + worker.transaction->quote(*snapshot_id_)
+                                   + ";");
+        } catch (const std::exception &e) {
+          log_->warn("failed to share snapshot with worker: {}", e.what());
+          if (worker.transaction) {
+            try {
+              worker.transaction->exec("ROLLBACK;");
+            } catch (const std::exception &) {
+              // connection is checked by the pool before reuse
+            }
+          }
+          // further transactions of this proposal are applied sequentially
+          pool_.reset();
+          break;
+        }
+        worker.committed = std::make_shared<CachedWsvQuery>(
+            std::make_shared<PostgresWsvQuery>(*worker.transaction),
+            std::make_shared<WsvCache>());
+        worker.storage =
+            std::make_shared<PostgresOverlayStorage>(*worker.transaction);
+        workers_.push_back(std::move(worker));
+      }
+      return workers_.size();
+    }
+
+    std::vector<bool> TemporaryWsvImpl::applyIndependent(
+        const TransactionRefs &transactions,
+        std::function<bool(const shared_model::interface::Transaction &,
+                           WsvQuery &)> apply_function) {
+      auto threads = std::min<size_t>(
+          {transactions.size(),
+           kMaxThreads,
+           std::max(1u, std::thread::hardware_concurrency())});
+      // calling thread uses the main connection
+      auto workers = threads > 1 ? prepareWorkers(threads - 1) : 0;
+      if (workers == 0) {
+        return TemporaryWsv::applyIndependent(transactions, apply_function);
+      }
+      threads = std::min(threads, workers + 1);
+
+      // each transaction is applied in its own overlay above the current
+      // state, which is not modified until all of them are done
+      std::vector<std::shared_ptr<WsvOverlay>> overlays(transactions.size());
+      std::vector<uint8_t> applied(transactions.size(), false);
+      std::vector<std::exception_ptr> errors(threads);
+      std::atomic<size_t> next{0};
+      auto work = [&](size_t thread,
+                      std::shared_ptr<WsvQuery> committed,
+                      std::shared_ptr<OverlayStorage> storage) {
+        try {
+          for (size_t i; (i = next++) < transactions.size();) {
+            auto overlay =
+                std::make_shared<WsvOverlay>(committed, storage, *wsv_);
+            CommandExecutor command_executor(overlay, overlay);
+            CommandValidator command_validator(overlay);
+            applied[i] = execute(transactions[i],
+                                 apply_function,
+                                 *overlay,
+                                 command_executor,
+                                 command_validator);
+            overlays[i] = std::move(overlay);
+          }
+        } catch (...) {
+          errors[thread] = std::current_exception();
+        }
+      };
+
+      std::vector<std::thread> pool;
+      for (size_t thread = 1; thread < threads; ++thread) {
+        const auto &worker = workers_[thread - 1];
+        pool.emplace_back(work, thread, worker.committed, worker.storage);
+      }
+      work(0, committed_, storage_);
+      for (auto &thread : pool) {
+        thread.join();
+      }
+      for (const auto &error : errors) {
+        if (error) {
+          std::rethrow_exception(error);
+        }
+      }
+
+      std::vector<bool> result(transactions.size());
+      for (size_t i = 0; i < transactions.size(); ++i) {
+        result[i] = applied[i];
+        if (applied[i]) {
+          wsv_->merge(std::move(*overlays[i]));
+        }
       }
       return result;
     }
 
     TemporaryWsvImpl::~TemporaryWsvImpl() {
+      for (auto &worker : workers_) {
+        worker.transaction->exec("ROLLBACK;");
+      }
       transaction_->exec("ROLLBACK;");
     }
   }  // namespace ametsuchi
@@ -21,6 +21,8 @@
 #include <pqxx/connection>
 #include <pqxx/nontransaction>
 
+#include "ametsuchi/impl/postgres_connection_pool.hpp"
+#include "ametsuchi/impl/wsv_overlay.hpp"
 #include "ametsuchi/temporary_wsv.hpp"
 #include "execution/command_executor.hpp"
 #include "logger/logger.hpp"
@@ -28,23 +30,80 @@
 namespace iroha {
 
   namespace ametsuchi {
+    /**
+     * Temporary wsv which keeps changes of applied transactions in memory
+     * above a read-only snapshot of the committed state, nothing is written
+     * to the storage. Independent transactions are applied concurrently with
+     * additional connections which read the same snapshot
+     */
     class TemporaryWsvImpl : public TemporaryWsv {
      public:
-      TemporaryWsvImpl(std::unique_ptr<pqxx::lazyconnection> connection,
-                       std::unique_ptr<pqxx::nontransaction> transaction);
+      /**
+       * @param connection - connection to read the committed state
+       * @param transaction - transaction of connection
+       * @param pool - pool to take connections for concurrent application
+       * of transactions, transactions are applied sequentially if not set
+       */
+      TemporaryWsvImpl(
+          PooledConnection connection,
+          std::unique_ptr<pqxx::nontransaction> transaction,
+          std::shared_ptr<PostgresConnectionPool> pool = nullptr);
 
       bool apply(
           const shared_model::interface::Transaction &,
           std::function<bool(const shared_model::interface::Transaction &,
                              WsvQuery &)> function) override;
 
+      std::vector<bool> applyIndependent(
+          const TransactionRefs &transactions,
+          std::function<bool(const shared_model::interface::Transaction &,
+                             WsvQuery &)> function) override;
+
       ~TemporaryWsvImpl() override;
 
+      /// Maximal number of threads applying transactions concurrently
+      static const size_t kMaxThreads;
+
      private:
-      std::unique_ptr<pqxx::lazyconnection> connection_;
+      /**
+       * Additional connection, which reads the same snapshot of the
+       * committed state as the main one
+       */
+      struct Worker {
+        PooledConnection connection;
+        std::unique_ptr<pqxx::nontransaction> transaction;
+        std::shared_ptr<WsvQuery> committed;
+        std::shared_ptr<OverlayStorage> storage;
+      };
+
+      /**
+       * Apply transaction in a savepoint of overlay, changes are discarded
+       * if transaction fails
+       * @return true if transaction is applied
+       */
+      bool execute(
+          const shared_model::interface::Transaction &tx,
+          const std::function<bool(const shared_model::interface::Transaction &,
+                                   WsvQuery &)> &apply_function,
+          WsvOverlay &wsv,
+          CommandExecutor &command_executor,
+          CommandValidator &command_validator);
+
+      /**
+       * Open additional connections while the pool has enough idle ones
+       * @param wanted - number of required workers
+       * @return number of available workers
+       */
+      size_t prepareWorkers(size_t wanted);
+
+      PooledConnection connection_;
       std::unique_ptr<pqxx::nontransaction> transaction_;
-      std::unique_ptr<WsvQuery> wsv_;
-      std::unique_ptr<WsvCommand> executor_;
+      std::shared_ptr<PostgresConnectionPool> pool_;
+      std::shared_ptr<WsvQuery> committed_;
+      std::shared_ptr<OverlayStorage> storage_;
+      boost::optional<std::string> snapshot_id_;
+      std::vector<Worker> workers_;
+      std::shared_ptr<WsvOverlay> wsv_;
       std::shared_ptr<CommandExecutor> command_executor_;
       std::shared_ptr<CommandValidator> command_validator_;
 
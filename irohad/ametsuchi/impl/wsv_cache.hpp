@@ -0,0 +1,103 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_WSV_CACHE_HPP
+#define IROHA_WSV_CACHE_HPP
+
+#include <boost/optional.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "interfaces/common_objects/account.hpp"
+#include "interfaces/common_objects/asset.hpp"
+#include "interfaces/common_objects/types.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Cache of world state view entities read or written within a single
+     * storage transaction. The cache is not thread-safe, as well as the
+     * transaction it belongs to
+     */
+    class WsvCache {
+     public:
+      /**
+       * Entries of one kind of entities
+       * @tparam ValueType type of cached values
+       */
+      template <typename ValueType>
+      class Table {
+       public:
+        /**
+         * @param key - entity id
+         * @return cached value if present
+         */
+        boost::optional<ValueType> get(const std::string &key) const {
+          auto found = entries_.find(key);
+          if (found == entries_.end()) {
+            return boost::none;
+          }
+          return found->second;
+        }
+
+        /**
+         * Store value which has been read from the storage
+         * @param key - entity id
+         * @param value - value read
+         */
+        void load(const std::string &key, ValueType value) {
+          entries_[key] = std::move(value);
+        }
+
+        /**
+         * Store value which has been written to the storage
+         * @param key - entity id
+         * @param value - value written
+         */
+        void write(const std::string &key, ValueType value) {
+          entries_[key] = std::move(value);
+        }
+
+        /**
+         * Drop value which has been modified in the storage
+         * @param key - entity id
+         */
+        void invalidate(const std::string &key) {
+          entries_.erase(key);
+        }
+
+       private:
+        std::unordered_map<std::string, ValueType> entries_;
+      };
+
+      Table<std::shared_ptr<shared_model::interface::Account>> accounts;
+      Table<std::shared_ptr<shared_model::interface::Asset>> assets;
+      Table<std::vector<shared_model::interface::types::PubkeyType>>
+          signatories;
+      Table<std::vector<shared_model::interface::types::RoleIdType>>
+          account_roles;
+      Table<std::vector<shared_model::interface::types::PermissionNameType>>
+          role_permissions;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_WSV_CACHE_HPP
@@ -0,0 +1,816 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/wsv_overlay.hpp"
+
+#include <algorithm>
+#include <boost/format.hpp>
+#include <iterator>
+#include <limits>
+#include <unordered_set>
+
+#include "builders/protobuf/common_objects/proto_account_asset_builder.hpp"
+#include "builders/protobuf/common_objects/proto_account_builder.hpp"
+#include "builders/protobuf/common_objects/proto_asset_builder.hpp"
+#include "builders/protobuf/common_objects/proto_domain_builder.hpp"
+#include "builders/protobuf/common_objects/proto_peer_builder.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    using shared_model::interface::types::AccountIdType;
+    using shared_model::interface::types::AssetIdType;
+    using shared_model::interface::types::DomainIdType;
+    using shared_model::interface::types::PermissionNameType;
+    using shared_model::interface::types::PubkeyType;
+    using shared_model::interface::types::QuorumType;
+    using shared_model::interface::types::RoleIdType;
+
+    namespace {
+      // lengths of character varying columns of the storage schema
+      const size_t kRoleIdLength = 32;
+      const size_t kPermissionIdLength = 45;
+      const size_t kDomainIdLength = 255;
+      const size_t kAccountIdLength = 288;
+      const size_t kAssetIdLength = 288;
+      const size_t kAddressLength = 261;
+
+      WsvCommandResult success() {
+        return {};
+      }
+
+      WsvCommandResult failure(const boost::format &message) {
+        return expected::makeError(message.str());
+      }
+
+      template <typename T>
+      bool contains(const std::vector<T> &values, const T &value) {
+        return std::find(values.begin(), values.end(), value) != values.end();
+      }
+
+      /**
+       * @return value of storage result, none if it contains error
+       */
+      template <typename T>
+      boost::optional<T> valueOf(OverlayStorage::Result<T> result) {
+        boost::optional<T> value;
+        result.match([&value](expected::Value<T> &v) { value = v.value; },
+                     [](expected::Error<std::string> &) {});
+        return value;
+      }
+
+      /**
+       * Convert value as it is stored in character varying(length) column,
+       * which truncates excess spaces and rejects other excess characters
+       * @return stored value, none if value does not fit
+       */
+      boost::optional<std::string> toVarchar(const std::string &value,
+                                             size_t length) {
+        size_t characters = 0;
+        for (size_t i = 0; i < value.size(); ++i) {
+          // continuation bytes of UTF-8 sequence do not start a character
+          if ((static_cast<unsigned char>(value[i]) & 0xC0) != 0x80
+              and characters++ == length) {
+            if (value.find_first_not_of(' ', i) != std::string::npos) {
+              return boost::none;
+            }
+            return value.substr(0, i);
+          }
+        }
+        return value;
+      }
+
+      /**
+       * @return true if quorum fits int column of the storage
+       */
+      bool fitsInt(QuorumType quorum) {
+        return quorum <= static_cast<QuorumType>(
+                             std::numeric_limits<int32_t>::max());
+      }
+
+      std::shared_ptr<shared_model::interface::Account> buildAccount(
+          const AccountIdType &account_id,
+          const DomainIdType &domain_id,
+          QuorumType quorum,
+          const std::string &json_data) {
+        return std::make_shared<shared_model::proto::Account>(
+            shared_model::proto::AccountBuilder()
+                .accountId(account_id)
+                .domainId(domain_id)
+                .quorum(quorum)
+                .jsonData(json_data)
+                .build());
+      }
+    }  // namespace
+
+    void WsvOverlay::Layer::merge(Layer &&later) {
+      auto move_entries = [](auto &to, auto &from) {
+        for (auto &entry : from) {
+          to[entry.first] = std::move(entry.second);
+        }
+      };
+      move_entries(accounts, later.accounts);
+      created_accounts.insert(later.created_accounts.begin(),
+                              later.created_accounts.end());
+      move_entries(assets, later.assets);
+      move_entries(domains, later.domains);
+      move_entries(account_assets, later.account_assets);
+      move_entries(account_roles, later.account_roles);
+      move_entries(signatories, later.signatories);
+      move_entries(role_permissions, later.role_permissions);
+      move_entries(grantable_permissions, later.grantable_permissions);
+      move_entries(signatory_rows, later.signatory_rows);
+      roles.insert(roles.end(),
+                   std::make_move_iterator(later.roles.begin()),
+                   std::make_move_iterator(later.roles.end()));
+      if (later.peers) {
+        peers = std::move(later.peers);
+      }
+    }
+
+    WsvOverlay::WsvOverlay(std::shared_ptr<WsvQuery> committed,
+                           std::shared_ptr<OverlayStorage> storage)
+        : committed_(std::move(committed)),
+          storage_(std::move(storage)),
+          parent_(nullptr),
+          layers_(1) {}
+
+    WsvOverlay::WsvOverlay(std::shared_ptr<WsvQuery> committed,
+                           std::shared_ptr<OverlayStorage> storage,
+                           const WsvOverlay &parent)
+        : committed_(std::move(committed)),
+          storage_(std::move(storage)),
+          parent_(&parent),
+          committed_roles_(parent.committed_roles_),
+          layers_(1) {}
+
+    void WsvOverlay::savepoint() {
+      layers_.emplace_back();
+    }
+
+    void WsvOverlay::release() {
+      if (layers_.size() > 1) {
+        auto later = std::move(layers_.back());
+        layers_.pop_back();
+        layers_.back().merge(std::move(later));
+      }
+    }
+
+    void WsvOverlay::rollback() {
+      if (layers_.size() > 1) {
+        layers_.pop_back();
+      }
+    }
+
+    void WsvOverlay::merge(WsvOverlay &&child) {
+      for (auto &layer : child.layers_) {
+        layers_.back().merge(std::move(layer));
+      }
+      child.layers_.resize(1);
+      child.layers_.front() = Layer{};
+    }
+
+    const WsvOverlay::Layer &WsvOverlay::changes() const {
+      return layers_.front();
+    }
+
+    void WsvOverlay::commitChanges() {
+      auto &changes = layers_.front();
+      if (committed_roles_) {
+        committed_roles_->insert(committed_roles_->end(),
+                                 changes.roles.begin(),
+                                 changes.roles.end());
+      }
+      changes = Layer{};
+    }
+
+    void WsvOverlay::discardChanges() {
+      layers_.front() = Layer{};
+    }
+
+    template <typename Visit>
+    bool WsvOverlay::visitLayers(Visit &&visit) const {
+      for (auto layer = layers_.rbegin(); layer != layers_.rend(); ++layer) {
+        if (visit(*layer)) {
+          return true;
+        }
+      }
+      return parent_ and parent_->visitLayers(visit);
+    }
+
+    template <typename Table>
+    const typename Table::mapped_type *WsvOverlay::find(
+        Table Layer::*table, const typename Table::key_type &key) const {
+      const typename Table::mapped_type *result = nullptr;
+      visitLayers([&](const Layer &layer) {
+        const auto &entries = layer.*table;
+        auto found = entries.find(key);
+        if (found != entries.end()) {
+          result = &found->second;
+        }
+        return result != nullptr;
+      });
+      return result;
+    }
+
+    template <typename Table, typename Load>
+    typename Table::mapped_type &WsvOverlay::modify(
+        Table Layer::*table, const typename Table::key_type &key, Load &&load) {
+      auto &entries = layers_.back().*table;
+      auto found = entries.find(key);
+      if (found != entries.end()) {
+        return found->second;
+      }
+      auto written = find(table, key);
+      return entries[key] =
+                 written ? *written : load().value_or(
+                                          typename Table::mapped_type{});
+    }
+
+    bool WsvOverlay::roleExists(const RoleIdType &role) {
+      if (visitLayers([&role](const Layer &layer) {
+            return contains(layer.roles, role);
+          })) {
+        return true;
+      }
+      if (not committed_roles_) {
+        committed_roles_ = committed_->getRoles();
+      }
+      return committed_roles_ and contains(*committed_roles_, role);
+    }
+
+    OverlayStorage::Result<
+        boost::optional<std::shared_ptr<shared_model::interface::Account>>>
+    WsvOverlay::storedAccount(const AccountIdType &account_id) {
+      if (auto account = find(&Layer::accounts, account_id)) {
+        return expected::makeValue(boost::make_optional(*account));
+      }
+      if (auto account = committed_->getAccount(account_id)) {
+        return expected::makeValue(std::move(account));
+      }
+      // WsvQuery does not return rows which fail stateless validation
+      return storage_->getAccount(account_id);
+    }
+
+    boost::optional<bool> WsvOverlay::accountExists(
+        const AccountIdType &account_id) {
+      if (auto account = valueOf(storedAccount(account_id))) {
+        return bool(*account);
+      }
+      return boost::none;
+    }
+
+    boost::optional<bool> WsvOverlay::assetExists(const AssetIdType &asset_id) {
+      if (find(&Layer::assets, asset_id) or committed_->getAsset(asset_id)) {
+        return true;
+      }
+      return valueOf(storage_->hasAsset(asset_id));
+    }
+
+    boost::optional<bool> WsvOverlay::domainExists(
+        const DomainIdType &domain_id) {
+      if (find(&Layer::domains, domain_id) or committed_->getDomain(domain_id)) {
+        return true;
+      }
+      return valueOf(storage_->hasDomain(domain_id));
+    }
+
+    boost::optional<bool> WsvOverlay::signatoryExists(
+        const PubkeyType &signatory) {
+      if (auto row = find(&Layer::signatory_rows, signatory.hex())) {
+        return *row;
+      }
+      return valueOf(storage_->hasSignatory(signatory));
+    }
+
+    boost::optional<bool> WsvOverlay::signatoryUsed(
+        const PubkeyType &signatory) {
+      auto peers = storedPeers();
+      if (not peers) {
+        return boost::none;
+      }
+      if (std::any_of(peers->begin(), peers->end(), [&signatory](const auto &p) {
+            return p->pubkey() == signatory;
+          })) {
+        return true;
+      }
+      // signatories of accounts written to overlay hide the stored ones
+      std::unordered_set<AccountIdType> written;
+      if (visitLayers([&](const Layer &layer) {
+            for (const auto &account : layer.signatories) {
+              if (written.insert(account.first).second
+                  and contains(account.second, signatory)) {
+                return true;
+              }
+            }
+            return false;
+          })) {
+        return true;
+      }
+      auto accounts = valueOf(storage_->getSignatoryAccounts(signatory));
+      if (not accounts) {
+        return boost::none;
+      }
+      return std::any_of(
+          accounts->begin(), accounts->end(), [&written](const auto &account) {
+            return written.count(account) == 0;
+          });
+    }
+
+    boost::optional<std::vector<std::shared_ptr<shared_model::interface::Peer>>>
+    WsvOverlay::storedPeers() {
+      boost::optional<
+          std::vector<std::shared_ptr<shared_model::interface::Peer>>>
+          peers;
+      if (visitLayers([&peers](const Layer &layer) {
+            peers = layer.peers;
+            return bool(peers);
+          })) {
+        return peers;
+      }
+      // WsvQuery does not return rows which fail stateless validation
+      return valueOf(storage_->getPeers());
+    }
+
+    // ----------| WsvQuery |----------
+
+    bool WsvOverlay::hasAccountGrantablePermission(
+        const AccountIdType &permitee_account_id,
+        const AccountIdType &account_id,
+        const PermissionNameType &permission_id) {
+      if (auto granted = find(
+              &Layer::grantable_permissions,
+              GrantableKey{permitee_account_id, account_id, permission_id})) {
+        return *granted;
+      }
+      return committed_->hasAccountGrantablePermission(
+          permitee_account_id, account_id, permission_id);
+    }
+
+    boost::optional<std::shared_ptr<shared_model::interface::Domain>>
+    WsvOverlay::getDomain(const DomainIdType &domain_id) {
+      if (auto domain = find(&Layer::domains, domain_id)) {
+        return *domain;
+      }
+      return committed_->getDomain(domain_id);
+    }
+
+    boost::optional<std::vector<RoleIdType>> WsvOverlay::getAccountRoles(
+        const AccountIdType &account_id) {
+      if (auto roles = find(&Layer::account_roles, account_id)) {
+        return *roles;
+      }
+      return committed_->getAccountRoles(account_id);
+    }
+
+    boost::optional<std::vector<PermissionNameType>>
+    WsvOverlay::getRolePermissions(const RoleIdType &role_name) {
+      if (auto permissions = find(&Layer::role_permissions, role_name)) {
+        return *permissions;
+      }
+      return committed_->getRolePermissions(role_name);
+    }
+
+    boost::optional<std::vector<RoleIdType>> WsvOverlay::getRoles() {
+      auto roles = committed_->getRoles();
+      if (roles) {
+        // roles are listed in order of insertion
+        std::vector<const Layer *> layers;
+        visitLayers([&layers](const Layer &layer) {
+          layers.push_back(&layer);
+          return false;
+        });
+        for (auto layer = layers.rbegin(); layer != layers.rend(); ++layer) {
+          roles->insert(
+              roles->end(), (*layer)->roles.begin(), (*layer)->roles.end());
+        }
+      }
+      return roles;
+    }
+
+    boost::optional<std::shared_ptr<shared_model::interface::Account>>
+    WsvOverlay::getAccount(const AccountIdType &account_id) {
+      if (auto account = find(&Layer::accounts, account_id)) {
+        return *account;
+      }
+      return committed_->getAccount(account_id);
+    }
+
+    boost::optional<std::string> WsvOverlay::getAccountDetail(
+        const std::string &account_id) {
+      if (auto account = find(&Layer::accounts, account_id)) {
+        const auto &data = (*account)->jsonData();
+        if (data.empty()) {
+          return boost::none;
+        }
+        return data;
+      }
+      return committed_->getAccountDetail(account_id);
+    }
+
+    boost::optional<std::vector<PubkeyType>> WsvOverlay::getSignatories(
+        const AccountIdType &account_id) {
+      if (auto signatories = find(&Layer::signatories, account_id)) {
+        return *signatories;
+      }
+      return committed_->getSignatories(account_id);
+    }
+
+    boost::optional<std::shared_ptr<shared_model::interface::Asset>>
+    WsvOverlay::getAsset(const AssetIdType &asset_id) {
+      if (auto asset = find(&Layer::assets, asset_id)) {
+        return *asset;
+      }
+      return committed_->getAsset(asset_id);
+    }
+
+    boost::optional<std::shared_ptr<shared_model::interface::AccountAsset>>
+    WsvOverlay::getAccountAsset(const AccountIdType &account_id,
+                                const AssetIdType &asset_id) {
+      if (auto account_asset = find(&Layer::account_assets,
+                                    AccountAssetKey{account_id, asset_id})) {
+        return *account_asset;
+      }
+      return committed_->getAccountAsset(account_id, asset_id);
+    }
+
+    boost::optional<std::vector<std::shared_ptr<shared_model::interface::Peer>>>
+    WsvOverlay::getPeers() {
+      boost::optional<
+          std::vector<std::shared_ptr<shared_model::interface::Peer>>>
+          peers;
+      if (visitLayers([&peers](const Layer &layer) {
+            peers = layer.peers;
+            return bool(peers);
+          })) {
+        return peers;
+      }
+      return committed_->getPeers();
+    }
+
+    // ----------| WsvCommand |----------
+
+    WsvCommandResult WsvOverlay::insertRole(const RoleIdType &role_name) {
+      auto role = toVarchar(role_name, kRoleIdLength);
+      if (not role or roleExists(*role)) {
+        return failure(boost::format("failed to insert role: '%s'")
+                       % role_name);
+      }
+      layers_.back().roles.push_back(*role);
+      return success();
+    }
+
+    WsvCommandResult WsvOverlay::insertAccountRole(
+        const AccountIdType &account_id, const RoleIdType &role_name) {
+      auto message = boost::format(
+                         "failed to insert account role, account: '%s', "
+                         "role name: '%s'")
+          % account_id % role_name;
+      auto account = toVarchar(account_id, kAccountIdLength);
+      auto role = toVarchar(role_name, kRoleIdLength);
+      if (not account or not role or accountExists(*account) != true
+          or not roleExists(*role)) {
+        return failure(message);
+      }
+      auto &roles = modify(&Layer::account_roles, *account, [&] {
+        return committed_->getAccountRoles(*account);
+      });
+      if (contains(roles, *role)) {
+        return failure(message);
+      }
+      roles.push_back(*role);
+      return success();
+    }
+
+    WsvCommandResult WsvOverlay::deleteAccountRole(
+        const AccountIdType &account_id, const RoleIdType &role_name) {
+      auto &roles = modify(&Layer::account_roles, account_id, [&] {
+        return committed_->getAccountRoles(account_id);
+      });
+      roles.erase(std::remove(roles.begin(), roles.end(), role_name),
+                  roles.end());
+      return success();
+    }
+
+    WsvCommandResult WsvOverlay::insertRolePermissions(
+        const RoleIdType &role_id,
+        const std::set<PermissionNameType> &permissions) {
+      auto message =
+          boost::format("failed to insert role permissions, role id: '%s'")
+          % role_id;
+      // insertion of no rows is not a valid statement
+      auto role = toVarchar(role_id, kRoleIdLength);
+      if (permissions.empty() or not role or not roleExists(*role)) {
+        return failure(message);
+      }
+      std::vector<PermissionNameType> inserted;
+      for (const auto &permission_id : permissions) {
+        auto permission = toVarchar(permission_id, kPermissionIdLength);
+        if (not permission or contains(inserted, *permission)) {
+          return failure(message);
+        }
+        inserted.push_back(*permission);
+      }
+      auto &role_permissions = modify(&Layer::role_permissions, *role, [&] {
+        return committed_->getRolePermissions(*role);
+      });
+      if (std::any_of(inserted.begin(),
+                      inserted.end(),
+                      [&role_permissions](const auto &permission) {
+                        return contains(role_permissions, permission);
+                      })) {
+        return failure(message);
+      }
+      role_permissions.insert(
+          role_permissions.end(), inserted.begin(), inserted.end());
+      return success();
+    }
+
+    WsvCommandResult WsvOverlay::insertAccountGrantablePermission(
+        const AccountIdType &permittee_account_id,
+        const AccountIdType &account_id,
+        const PermissionNameType &permission_id) {
+      auto permittee = toVarchar(permittee_account_id, kAccountIdLength);
+      auto account = toVarchar(account_id, kAccountIdLength);
+      auto permission = toVarchar(permission_id, kPermissionIdLength);
+      if (not permittee or not account or not permission
+          or accountExists(*permittee) != true
+          or accountExists(*account) != true
+          or hasAccountGrantablePermission(
+                 *permittee, *account, *permission)) {
+        return failure(
+            boost::format("failed to insert account grantable permission, "
+                          "permittee account id: '%s', "
+                          "account id: '%s', "
+                          "permission id: '%s'")
+            % permittee_account_id % account_id % permission_id);
+      }
+      layers_.back().grantable_permissions[GrantableKey{
+          *permittee, *account, *permission}] = true;
+      return success();
+    }
+
+    WsvCommandResult WsvOverlay::deleteAccountGrantablePermission(
+        const AccountIdType &permittee_account_id,
+        const AccountIdType &account_id,
+        const PermissionNameType &permission_id) {
+      layers_.back().grantable_permissions[GrantableKey{
+          permittee_account_id, account_id, permission_id}] = false;
+      return success();
+    }
+
+    WsvCommandResult WsvOverlay::insertAccount(
+        const shared_model::interface::Account &account) {
+      auto message = boost::format("failed to insert account, "
+                                   "account id: '%s', "
+                                   "domain id: '%s'")
+          % account.accountId() % account.domainId();
+      auto account_id = toVarchar(account.accountId(), kAccountIdLength);
+      auto domain_id = toVarchar(account.domainId(), kDomainIdLength);
+      if (not account_id or not domain_id or not fitsInt(account.quorum())
+          or accountExists(*account_id) != false
+          or domainExists(*domain_id) != true) {
+        return failure(message);
+      }
+      // data is stored in the form returned by the storage
+      auto json_data = valueOf(storage_->normalizeJson(account.jsonData()));
+      if (not json_data) {
+        return failure(message);
+      }
+      layers_.back().accounts[*account_id] =
+          buildAccount(*account_id, *domain_id, account.quorum(), *json_data);
+      layers_.back().created_accounts.insert(*account_id);
+      return success();
+    }
+
+    WsvCommandResult WsvOverlay::updateAccount(
+        const shared_model::interface::Account &account) {
+      auto message = boost::format(
+                         "failed to update account, account id: '%s', "
+                         "quorum: '%s'")
+          % account.accountId() % account.quorum();
+      // quorum is rejected even if there is no account to update
+      if (not fitsInt(account.quorum())) {
+        return failure(message);
+      }
+      auto current = valueOf(storedAccount(account.accountId()));
+      if (not current) {
+        return failure(message);
+      }
+      if (not *current) {
+        // update of missing account does not change the state
+        return success();
+      }
+      const auto &stored = **current;
+      layers_.back().accounts[account.accountId()] =
+          buildAccount(stored->accountId(),
+                       stored->domainId(),
+                       account.quorum(),
+                       stored->jsonData());
+      return success();
+    }
+
+    WsvCommandResult WsvOverlay::setAccountKV(
+        const AccountIdType &account_id,
+        const AccountIdType &creator_account_id,
+        const std::string &key,
+        const std::string &val) {
+      auto message =
+          boost::format(
+              "failed to set account key-value, account id: '%s', "
+              "creator account id: '%s',\n key: '%s', value: '%s'")
+          % account_id % creator_account_id % key % val;
+      auto current = valueOf(storedAccount(account_id));
+      if (not current) {
+        return failure(message);
+      }
+      // arguments are checked by the storage even if there is no account
+      boost::optional<std::string> json_data;
+      if (*current and not (**current)->jsonData().empty()) {
+        json_data = (**current)->jsonData();
+      }
+      auto updated = valueOf(storage_->setAccountDetail(
+          json_data, creator_account_id, key, val));
+      if (not updated) {
+        return failure(message);
+      }
+      if (*current) {
+        const auto &stored = **current;
+        layers_.back().accounts[account_id] = buildAccount(stored->accountId(),
+                                                           stored->domainId(),
+                                                           stored->quorum(),
+                                                           *updated);
+      }
+      return success();
+    }
+
+    WsvCommandResult WsvOverlay::insertAsset(
+        const shared_model::interface::Asset &asset) {
+      auto asset_id = toVarchar(asset.assetId(), kAssetIdLength);
+      auto domain_id = toVarchar(asset.domainId(), kDomainIdLength);
+      if (not asset_id or not domain_id or assetExists(*asset_id) != false
+          or domainExists(*domain_id) != true) {
+        return failure(boost::format("failed to insert asset, asset id: '%s', "
+                                     "domain id: '%s'")
+                       % asset.assetId() % asset.domainId());
+      }
+      layers_.back().assets[*asset_id] =
+          std::make_shared<shared_model::proto::Asset>(
+              shared_model::proto::AssetBuilder()
+                  .assetId(*asset_id)
+                  .domainId(*domain_id)
+                  .precision(asset.precision())
+                  .build());
+      return success();
+    }
+
+    WsvCommandResult WsvOverlay::upsertAccountAsset(
+        const shared_model::interface::AccountAsset &asset) {
+      auto account_id = toVarchar(asset.accountId(), kAccountIdLength);
+      auto asset_id = toVarchar(asset.assetId(), kAssetIdLength);
+      if (not account_id or not asset_id or accountExists(*account_id) != true
+          or assetExists(*asset_id) != true) {
+        return failure(boost::format("failed to upsert account, account id: "
+                                     "'%s', asset id: '%s'")
+                       % asset.accountId() % asset.assetId());
+      }
+      layers_.back().account_assets[AccountAssetKey{*account_id, *asset_id}] =
+          std::make_shared<shared_model::proto::AccountAsset>(
+              shared_model::proto::AccountAssetBuilder()
+                  .accountId(*account_id)
+                  .assetId(*asset_id)
+                  .balance(asset.balance())
+                  .build());
+      return success();
+    }
+
+    WsvCommandResult WsvOverlay::insertSignatory(const PubkeyType &signatory) {
+      // existing row is kept
+      layers_.back().signatory_rows[signatory.hex()] = true;
+      return success();
+    }
+
+    WsvCommandResult WsvOverlay::insertAccountSignatory(
+        const AccountIdType &account_id, const PubkeyType &signatory) {
+      auto message = boost::format(
+                         "failed to insert account signatory, account id: "
+                         "'%s', signatory hex string: '%s'")
+          % account_id % signatory.hex();
+      auto account = toVarchar(account_id, kAccountIdLength);
+      if (not account or accountExists(*account) != true
+          or signatoryExists(signatory) != true) {
+        return failure(message);
+      }
+      auto &signatories = modify(&Layer::signatories, *account, [&] {
+        return committed_->getSignatories(*account);
+      });
+      if (contains(signatories, signatory)) {
+        return failure(message);
+      }
+      signatories.push_back(signatory);
+      return success();
+    }
+
+    WsvCommandResult WsvOverlay::deleteAccountSignatory(
+        const AccountIdType &account_id, const PubkeyType &signatory) {
+      auto &signatories = modify(&Layer::signatories, account_id, [&] {
+        return committed_->getSignatories(account_id);
+      });
+      signatories.erase(
+          std::remove(signatories.begin(), signatories.end(), signatory),
+          signatories.end());
+      return success();
+    }
+
+    WsvCommandResult WsvOverlay::deleteSignatory(const PubkeyType &signatory) {
+      auto used = signatoryUsed(signatory);
+      if (not used) {
+        return failure(
+            boost::format(
+                "failed to delete signatory, signatory hex string: '%s'")
+            % signatory.hex());
+      }
+      // signatory is removed only if no account and no peer has it
+      if (not *used) {
+        layers_.back().signatory_rows[signatory.hex()] = false;
+      }
+      return success();
+    }
+
+    WsvCommandResult WsvOverlay::insertPeer(
+        const shared_model::interface::Peer &peer) {
+      auto address = toVarchar(peer.address(), kAddressLength);
+      auto peers = storedPeers();
+      if (not address or not peers
+          or std::any_of(peers->begin(), peers->end(), [&](const auto &p) {
+               return p->pubkey() == peer.pubkey() or p->address() == *address;
+             })) {
+        return failure(boost::format("failed to insert peer, public key: '%s', "
+                                     "address: '%s'")
+                       % peer.pubkey().hex() % peer.address());
+      }
+      peers->push_back(std::make_shared<shared_model::proto::Peer>(
+          shared_model::proto::PeerBuilder()
+              .pubkey(peer.pubkey())
+              .address(*address)
+              .build()));
+      layers_.back().peers = std::move(peers);
+      return success();
+    }
+
+    WsvCommandResult WsvOverlay::deletePeer(
+        const shared_model::interface::Peer &peer) {
+      auto peers = storedPeers();
+      if (not peers) {
+        return failure(boost::format("failed to delete peer, public key: '%s', "
+                                     "address: '%s'")
+                       % peer.pubkey().hex() % peer.address());
+      }
+      peers->erase(
+          std::remove_if(peers->begin(),
+                         peers->end(),
+                         [&peer](const auto &p) {
+                           return p->pubkey() == peer.pubkey()
+                               and p->address() == peer.address();
+                         }),
+          peers->end());
+      layers_.back().peers = std::move(peers);
+      return success();
+    }
+
+    WsvCommandResult WsvOverlay::insertDomain(
+        const shared_model::interface::Domain &domain) {
+      auto domain_id = toVarchar(domain.domainId(), kDomainIdLength);
+      auto default_role = toVarchar(domain.defaultRole(), kRoleIdLength);
+      if (not domain_id or not default_role
+          or domainExists(*domain_id) != false
+          or not roleExists(*default_role)) {
+        return failure(boost::format("failed to insert domain, domain id: "
+                                     "'%s', default role: '%s'")
+                       % domain.domainId() % domain.defaultRole());
+      }
+      layers_.back().domains[*domain_id] =
+          std::make_shared<shared_model::proto::Domain>(
+              shared_model::proto::DomainBuilder()
+                  .domainId(*domain_id)
+                  .defaultRole(*default_role)
+                  .build());
+      return success();
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
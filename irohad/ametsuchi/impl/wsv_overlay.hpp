@@ -0,0 +1,378 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_WSV_OVERLAY_HPP
+#define IROHA_WSV_OVERLAY_HPP
+
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "ametsuchi/impl/overlay_storage.hpp"
+#include "ametsuchi/wsv_command.hpp"
+#include "ametsuchi/wsv_query.hpp"
+#include "interfaces/common_objects/peer.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * World state view which keeps written entities in memory above a
+     * read-only committed state.
+     *
+     * Every savepoint opens a new layer of changes, so rollback drops the
+     * layer and release merges it into the previous one without touching
+     * the storage. Lists of roles, signatories and permissions are copied to
+     * the layer on the first modification. Commands succeed and fail
+     * exactly as PostgresWsvCommand does: constraints of the storage schema
+     * are checked against the visible state, including stored rows which
+     * are not returned by WsvQuery, and json data is evaluated by the
+     * storage.
+     *
+     * Released changes form the write set, which can be written to the
+     * storage at once.
+     *
+     * Not thread-safe, as well as the storage transaction it belongs to
+     */
+    class WsvOverlay : public WsvQuery, public WsvCommand {
+     public:
+      using AccountAssetKey =
+          std::pair<shared_model::interface::types::AccountIdType,
+                    shared_model::interface::types::AssetIdType>;
+      using GrantableKey =
+          std::tuple<shared_model::interface::types::AccountIdType,
+                     shared_model::interface::types::AccountIdType,
+                     shared_model::interface::types::PermissionNameType>;
+
+      /**
+       * Entities written after a savepoint
+       */
+      struct Layer {
+        std::unordered_map<shared_model::interface::types::AccountIdType,
+                           std::shared_ptr<shared_model::interface::Account>>
+            accounts;
+        // accounts inserted rather than updated by the changes
+        std::unordered_set<shared_model::interface::types::AccountIdType>
+            created_accounts;
+        std::unordered_map<shared_model::interface::types::AssetIdType,
+                           std::shared_ptr<shared_model::interface::Asset>>
+            assets;
+        std::unordered_map<shared_model::interface::types::DomainIdType,
+                           std::shared_ptr<shared_model::interface::Domain>>
+            domains;
+        std::map<AccountAssetKey,
+                 std::shared_ptr<shared_model::interface::AccountAsset>>
+            account_assets;
+        std::unordered_map<
+            shared_model::interface::types::AccountIdType,
+            std::vector<shared_model::interface::types::RoleIdType>>
+            account_roles;
+        std::unordered_map<
+            shared_model::interface::types::AccountIdType,
+            std::vector<shared_model::interface::types::PubkeyType>>
+            signatories;
+        std::unordered_map<
+            shared_model::interface::types::RoleIdType,
+            std::vector<shared_model::interface::types::PermissionNameType>>
+            role_permissions;
+        // false marks a revoked permission
+        std::map<GrantableKey, bool> grantable_permissions;
+        std::vector<shared_model::interface::types::RoleIdType> roles;
+        boost::optional<
+            std::vector<std::shared_ptr<shared_model::interface::Peer>>>
+            peers;
+        // rows of signatory table keyed by hex of public key, false marks a
+        // removed row
+        std::unordered_map<std::string, bool> signatory_rows;
+
+        /**
+         * Move entities of the later layer to this one
+         */
+        void merge(Layer &&later);
+      };
+
+      /**
+       * @param committed - query to committed state, which is modified only
+       * by writing changes of the overlay
+       * @param storage - rows and functions of the committed state
+       */
+      WsvOverlay(std::shared_ptr<WsvQuery> committed,
+                 std::shared_ptr<OverlayStorage> storage);
+
+      /**
+       * Create overlay above the current state of another one, so that
+       * several transactions can be applied concurrently in their own
+       * overlays. Parent must outlive the overlay and must not be modified
+       * while the overlay exists
+       * @param committed - query to the committed state of parent, which can
+       * be used in another thread
+       * @param storage - rows and functions of the same committed state,
+       * which can be used in another thread
+       * @param parent - overlay with the earlier changes
+       */
+      WsvOverlay(std::shared_ptr<WsvQuery> committed,
+                 std::shared_ptr<OverlayStorage> storage,
+                 const WsvOverlay &parent);
+
+      /**
+       * Open new layer of changes
+       */
+      void savepoint();
+
+      /**
+       * Merge the last layer of changes into the previous one
+       */
+      void release();
+
+      /**
+       * Drop the last layer of changes
+       */
+      void rollback();
+
+      /**
+       * Move all changes of an overlay created above this one to the last
+       * layer
+       * @param child - overlay created with this one as parent
+       */
+      void merge(WsvOverlay &&child);
+
+      /**
+       * @return released changes, which are the final state of every
+       * written entity
+       */
+      const Layer &changes() const;
+
+      /**
+       * Drop released changes after they are written to the committed state
+       */
+      void commitChanges();
+
+      /**
+       * Drop released changes, which are not written to the committed state
+       */
+      void discardChanges();
+
+      // ----------| WsvQuery |----------
+
+      bool hasAccountGrantablePermission(
+          const shared_model::interface::types::AccountIdType
+              &permitee_account_id,
+          const shared_model::interface::types::AccountIdType &account_id,
+          const shared_model::interface::types::PermissionNameType
+              &permission_id) override;
+
+      boost::optional<std::shared_ptr<shared_model::interface::Domain>>
+      getDomain(const shared_model::interface::types::DomainIdType &domain_id)
+          override;
+
+      boost::optional<std::vector<shared_model::interface::types::RoleIdType>>
+      getAccountRoles(const shared_model::interface::types::AccountIdType
+                          &account_id) override;
+
+      boost::optional<
+          std::vector<shared_model::interface::types::PermissionNameType>>
+      getRolePermissions(
+          const shared_model::interface::types::RoleIdType &role_name) override;
+
+      boost::optional<std::vector<shared_model::interface::types::RoleIdType>>
+      getRoles() override;
+
+      boost::optional<std::shared_ptr<shared_model::interface::Account>>
+      getAccount(const shared_model::interface::types::AccountIdType
+                     &account_id) override;
+
+      boost::optional<std::string> getAccountDetail(
+          const std::string &account_id) override;
+
+      boost::optional<std::vector<shared_model::interface::types::PubkeyType>>
+      getSignatories(const shared_model::interface::types::AccountIdType
+                         &account_id) override;
+
+      boost::optional<std::shared_ptr<shared_model::interface::Asset>>
+      getAsset(const shared_model::interface::types::AssetIdType &asset_id)
+          override;
+
+      boost::optional<std::shared_ptr<shared_model::interface::AccountAsset>>
+      getAccountAsset(
+          const shared_model::interface::types::AccountIdType &account_id,
+          const shared_model::interface::types::AssetIdType &asset_id) override;
+
+      boost::optional<
+          std::vector<std::shared_ptr<shared_model::interface::Peer>>>
+      getPeers() override;
+
+      // ----------| WsvCommand |----------
+
+      WsvCommandResult insertRole(
+          const shared_model::interface::types::RoleIdType &role_name) override;
+
+      WsvCommandResult insertAccountRole(
+          const shared_model::interface::types::AccountIdType &account_id,
+          const shared_model::interface::types::RoleIdType &role_name) override;
+
+      WsvCommandResult deleteAccountRole(
+          const shared_model::interface::types::AccountIdType &account_id,
+          const shared_model::interface::types::RoleIdType &role_name) override;
+
+      WsvCommandResult insertRolePermissions(
+          const shared_model::interface::types::RoleIdType &role_id,
+          const std::set<shared_model::interface::types::PermissionNameType>
+              &permissions) override;
+
+      WsvCommandResult insertAccountGrantablePermission(
+          const shared_model::interface::types::AccountIdType
+              &permittee_account_id,
+          const shared_model::interface::types::AccountIdType &account_id,
+          const shared_model::interface::types::PermissionNameType
+              &permission_id) override;
+
+      WsvCommandResult deleteAccountGrantablePermission(
+          const shared_model::interface::types::AccountIdType
+              &permittee_account_id,
+          const shared_model::interface::types::AccountIdType &account_id,
+          const shared_model::interface::types::PermissionNameType
+              &permission_id) override;
+
+      WsvCommandResult insertAccount(
+          const shared_model::interface::Account &account) override;
+
+      WsvCommandResult updateAccount(
+          const shared_model::interface::Account &account) override;
+
+      WsvCommandResult setAccountKV(
+          const shared_model::interface::types::AccountIdType &account_id,
+          const shared_model::interface::types::AccountIdType
+              &creator_account_id,
+          const std::string &key,
+          const std::string &val) override;
+
+      WsvCommandResult insertAsset(
+          const shared_model::interface::Asset &asset) override;
+
+      WsvCommandResult upsertAccountAsset(
+          const shared_model::interface::AccountAsset &asset) override;
+
+      WsvCommandResult insertSignatory(
+          const shared_model::interface::types::PubkeyType &signatory) override;
+
+      WsvCommandResult insertAccountSignatory(
+          const shared_model::interface::types::AccountIdType &account_id,
+          const shared_model::interface::types::PubkeyType &signatory) override;
+
+      WsvCommandResult deleteAccountSignatory(
+          const shared_model::interface::types::AccountIdType &account_id,
+          const shared_model::interface::types::PubkeyType &signatory) override;
+
+      WsvCommandResult deleteSignatory(
+          const shared_model::interface::types::PubkeyType &signatory) override;
+
+      WsvCommandResult insertPeer(
+          const shared_model::interface::Peer &peer) override;
+
+      WsvCommandResult deletePeer(
+          const shared_model::interface::Peer &peer) override;
+
+      WsvCommandResult insertDomain(
+          const shared_model::interface::Domain &domain) override;
+
+     private:
+      /**
+       * Call function for layers from the latest to the earliest one,
+       * including layers of parent
+       * @param visit - function which returns true to stop the iteration
+       * @return true if the iteration is stopped
+       */
+      template <typename Visit>
+      bool visitLayers(Visit &&visit) const;
+
+      /**
+       * Find the latest written value of entity
+       * @return pointer to value, null if entity is not written
+       */
+      template <typename Table>
+      const typename Table::mapped_type *find(
+          Table Layer::*table, const typename Table::key_type &key) const;
+
+      /**
+       * Copy-on-write access to list entity for modification in the last
+       * layer
+       * @param load - function which reads the committed list
+       * @return list stored in the last layer
+       */
+      template <typename Table, typename Load>
+      typename Table::mapped_type &modify(Table Layer::*table,
+                                          const typename Table::key_type &key,
+                                          Load &&load);
+
+      bool roleExists(const shared_model::interface::types::RoleIdType &role);
+
+      /**
+       * Find the latest state of account, including stored account which
+       * is not returned by WsvQuery
+       * @return account, none if it does not exist, error if storage fails
+       */
+      OverlayStorage::Result<
+          boost::optional<std::shared_ptr<shared_model::interface::Account>>>
+      storedAccount(
+          const shared_model::interface::types::AccountIdType &account_id);
+
+      /**
+       * Existence checks of rows referenced by foreign keys
+       * @return true if row exists, none if storage fails
+       */
+      boost::optional<bool> accountExists(
+          const shared_model::interface::types::AccountIdType &account_id);
+
+      boost::optional<bool> assetExists(
+          const shared_model::interface::types::AssetIdType &asset_id);
+
+      boost::optional<bool> domainExists(
+          const shared_model::interface::types::DomainIdType &domain_id);
+
+      boost::optional<bool> signatoryExists(
+          const shared_model::interface::types::PubkeyType &signatory);
+
+      /**
+       * @return true if any account or peer has the signatory, none if
+       * storage fails
+       */
+      boost::optional<bool> signatoryUsed(
+          const shared_model::interface::types::PubkeyType &signatory);
+
+      /**
+       * @return the latest list of all peers, including stored peers which
+       * are not returned by WsvQuery, none if storage fails
+       */
+      boost::optional<
+          std::vector<std::shared_ptr<shared_model::interface::Peer>>>
+      storedPeers();
+
+      std::shared_ptr<WsvQuery> committed_;
+      std::shared_ptr<OverlayStorage> storage_;
+      const WsvOverlay *parent_;
+      // roles of committed state, read once
+      boost::optional<std::vector<shared_model::interface::types::RoleIdType>>
+          committed_roles_;
+      // the first layer holds released changes and is never dropped
+      std::vector<Layer> layers_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_WSV_OVERLAY_HPP
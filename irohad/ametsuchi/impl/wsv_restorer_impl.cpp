@@ -17,28 +17,235 @@
 
 #include "wsv_restorer_impl.hpp"
 
-#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <boost/optional.hpp>
 
 #include "ametsuchi/block_query.hpp"
+#include "ametsuchi/mutable_storage.hpp"
 #include "ametsuchi/storage.hpp"
 #include "interfaces/iroha_internal/block.hpp"
+#include "validators/field_validator.hpp"
+
+namespace {
+  /**
+   * Queue with limited capacity which connects stages of restore pipeline
+   */
+  template <typename T>
+  class BoundedQueue {
+   public:
+    explicit BoundedQueue(size_t capacity)
+        : capacity_(std::max<size_t>(capacity, 1)), closed_(false) {}
+
+    /**
+     * Add item, wait for a free slot if the queue is full
+     * @return false if the queue is closed
+     */
+    bool push(T item) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      not_full_.wait(lock,
+                     [this] { return closed_ or queue_.size() < capacity_; });
+      if (closed_) {
+        return false;
+      }
+      queue_.push_back(std::move(item));
+      lock.unlock();
+      not_empty_.notify_one();
+      return true;
+    }
+
+    /**
+     * Take item, wait for it if the queue is empty
+     * @return none if the queue is closed and empty
+     */
+    boost::optional<T> pop() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      not_empty_.wait(lock, [this] { return closed_ or not queue_.empty(); });
+      if (queue_.empty()) {
+        return boost::none;
+      }
+      auto item = std::move(queue_.front());
+      queue_.pop_front();
+      lock.unlock();
+      not_full_.notify_one();
+      return item;
+    }
+
+    /**
+     * Reject further items, the queued ones are still available
+     */
+    void close() {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+      }
+      not_full_.notify_all();
+      not_empty_.notify_all();
+    }
+
+   private:
+    const size_t capacity_;
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<T> queue_;
+    bool closed_;
+  };
+
+  /// number of blocks requested from block query at once
+  const uint32_t kReadChunkSize = 100;
+
+  /**
+   * @return blocks per second
+   */
+  double throughput(size_t blocks, std::chrono::steady_clock::duration time) {
+    auto seconds = std::chrono::duration<double>(time).count();
+    return seconds > 0 ? blocks / seconds : 0;
+  }
+}  // namespace
 
 namespace iroha {
   namespace ametsuchi {
+
+    using wBlock = std::shared_ptr<const shared_model::interface::Block>;
+
+    const size_t WsvRestorerImpl::kDefaultQueueCapacity;
+    const size_t WsvRestorerImpl::kDefaultCommitInterval;
+
+    WsvRestorerImpl::WsvRestorerImpl(size_t queue_capacity,
+                                     size_t commit_interval)
+        : queue_capacity_(queue_capacity),
+          commit_interval_(std::max<size_t>(commit_interval, 1)),
+          log_(logger::log("WsvRestorer")) {}
+
     expected::Result<void, std::string> WsvRestorerImpl::restoreWsv(
         Storage &storage) {
-      // get all blocks starting from the genesis
-      std::vector<std::shared_ptr<shared_model::interface::Block>> blocks;
-      storage.getBlockQuery()->getBlocksFrom(1).as_blocking().subscribe(
-          [&blocks](auto block) {
-            blocks.push_back(std::move(block));
-          });
+      auto block_query = storage.getBlockQuery();
+      shared_model::interface::types::HeightType top_height = 0;
+      block_query->getTopBlocks(1).as_blocking().subscribe(
+          [&top_height](auto block) { top_height = block->height(); });
+
+      // replay only blocks after the latest usable snapshot
+      auto snapshot_height = storage.restoreWsvSnapshot();
+      if (not snapshot_height) {
+        storage.dropWsv();
+      }
+      const auto first_height = snapshot_height.value_or(0) + 1;
+
+      auto start = std::chrono::steady_clock::now();
+      BoundedQueue<wBlock> decoded(queue_capacity_);
+      BoundedQueue<wBlock> verified(queue_capacity_);
+      std::mutex error_mutex;
+      boost::optional<std::string> error;
+      auto fail = [&](std::string message) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (not error) {
+          error = std::move(message);
+        }
+      };
+
+      // read and decode blocks, starting after the restored state
+      std::thread reader([&] {
+        bool stopped = false;
+        for (auto height = first_height;
+             height <= top_height and not stopped;
+             height += kReadChunkSize) {
+          block_query->getBlocks(height, kReadChunkSize)
+              .as_blocking()
+              .subscribe([&](auto block) {
+                stopped = stopped or not decoded.push(std::move(block));
+              });
+        }
+        decoded.close();
+      });
+
+      // verify signatures of blocks
+      std::thread verifier([&] {
+        shared_model::validation::FieldValidator validator;
+        while (auto block = decoded.pop()) {
+          shared_model::validation::ReasonsGroupType reason;
+          validator.validateSignatures(
+              reason, (*block)->signatures(), (*block)->payload());
+          if (not reason.second.empty()) {
+            fail("block " + std::to_string((*block)->height())
+                 + " has invalid signatures");
+            break;
+          }
+          if (not verified.push(std::move(*block))) {
+            break;
+          }
+        }
+        // stop reader if verification is interrupted
+        decoded.close();
+        verified.close();
+      });
 
-      storage.dropStorage();
+      // apply blocks in order, committing them periodically; block query
+      // skips blocks which cannot be read, so the sequence is checked
+      // before anything after a missing block is applied
+      std::unique_ptr<MutableStorage> mutable_storage;
+      size_t applied = 0;
+      while (auto block = verified.pop()) {
+        if ((*block)->height() != first_height + applied) {
+          fail("cannot read block " + std::to_string(first_height + applied));
+          break;
+        }
+        if (not mutable_storage) {
+          storage.createMutableStorage().match(
+              [&](expected::Value<std::unique_ptr<MutableStorage>> &value) {
+                mutable_storage = std::move(value.value);
+              },
+              [&](expected::Error<std::string> &e) { fail(e.error); });
+          if (not mutable_storage) {
+            break;
+          }
+        }
+        if (not mutable_storage->apply(
+                **block,
+                [](const auto &block, auto &query, const auto &top_hash) {
+                  return true;
+                })) {
+          fail("cannot apply block " + std::to_string((*block)->height()));
+          break;
+        }
+        if (++applied % commit_interval_ == 0) {
+          storage.commit(std::move(mutable_storage));
+          log_->info(
+              "restored {} of {} blocks, {:.1f} blocks/s",
+              applied,
+              top_height - first_height + 1,
+              throughput(applied, std::chrono::steady_clock::now() - start));
+        }
+      }
+      // stop other stages if applying is interrupted
+      verified.close();
+      decoded.close();
+      reader.join();
+      verifier.join();
 
-      if (not storage.insertBlocks(blocks))
-        return expected::makeError("cannot insert blocks");
+      if (not error and first_height + applied != top_height + 1) {
+        fail("cannot read block " + std::to_string(first_height + applied));
+      }
+      if (error) {
+        return expected::makeError(*error);
+      }
+      if (mutable_storage) {
+        storage.commit(std::move(mutable_storage));
+      }
 
+      auto time = std::chrono::steady_clock::now() - start;
+      log_->info(
+          "WSV restored from {} blocks after height {} in {} ms, "
+          "{:.1f} blocks/s",
+          applied,
+          first_height - 1,
+          std::chrono::duration_cast<std::chrono::milliseconds>(time).count(),
+          throughput(applied, time));
       return expected::Value<void>();
     }
   }  // namespace ametsuchi
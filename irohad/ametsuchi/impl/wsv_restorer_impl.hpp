@@ -20,25 +20,51 @@
 
 #include "ametsuchi/wsv_restorer.hpp"
 #include "common/result.hpp"
+#include "logger/logger.hpp"
 
 namespace iroha {
   namespace ametsuchi {
 
     /**
-     * Recover WSV (World State View).
-     * @return true on success, otherwise false
+     * Recover WSV (World State View) by streaming blocks from the block
+     * store through a pipeline: blocks are read and decoded on one thread,
+     * their signatures are verified on another one, and the calling thread
+     * applies them in order. Stages are connected with bounded queues, so
+     * only a few blocks are kept in memory at once
      */
     class WsvRestorerImpl : public WsvRestorer {
      public:
+      /// default max number of blocks waiting between pipeline stages
+      static const size_t kDefaultQueueCapacity = 64;
+      /// default number of blocks applied in a single storage transaction
+      static const size_t kDefaultCommitInterval = 1000;
+
+      /**
+       * @param queue_capacity - max number of blocks waiting between
+       * pipeline stages
+       * @param commit_interval - number of blocks after which applied state
+       * is committed
+       */
+      explicit WsvRestorerImpl(
+          size_t queue_capacity = kDefaultQueueCapacity,
+          size_t commit_interval = kDefaultCommitInterval);
+
       virtual ~WsvRestorerImpl() = default;
+
       /**
        * Recover WSV (World State View).
-       * Drop storage and apply blocks one by one.
+       * Drop WSV and apply blocks from the block store one by one. Blocks
+       * after a missing or unreadable one are not applied.
        * @param storage of blocks in ledger
        * @return void on success, otherwise error string
        */
       virtual expected::Result<void, std::string> restoreWsv(
           Storage &storage) override;
+
+     private:
+      const size_t queue_capacity_;
+      const size_t commit_interval_;
+      logger::Logger log_;
     };
 
   }  // namespace ametsuchi
@@ -0,0 +1,391 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/wsv_snapshot_store.hpp"
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <cstring>
+#include <pqxx/pqxx>
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "common/types.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    namespace {
+      using shared_model::interface::types::HashType;
+      using shared_model::interface::types::HeightType;
+
+      const uint64_t kSnapshotVersion = 1;
+      const char *kTemporarySuffix = ".tmp";
+      const size_t kRowsPerEntry = 1000;
+      const FlatFile::Identifier kHeaderId = 1;
+
+      /**
+       * WSV tables in order which satisfies foreign keys on insertion
+       */
+      const std::vector<std::string> kTables = {
+          "role",
+          "domain",
+          "signatory",
+          "account",
+          "account_has_signatory",
+          "peer",
+          "asset",
+          "account_has_asset",
+          "role_has_permissions",
+          "account_has_roles",
+          "account_has_grantable_permissions",
+          "height_by_hash",
+          "height_by_block_hash",
+          "height_by_account_set",
+          "index_by_creator_height",
+          "index_by_id_height_asset"};
+
+      /**
+       * Appends integers and length-prefixed strings to entry
+       */
+      class EntryWriter {
+       public:
+        void put(uint64_t value) {
+          auto begin = reinterpret_cast<const uint8_t *>(&value);
+          data_.insert(data_.end(), begin, begin + sizeof(value));
+        }
+
+        void put(const std::string &value) {
+          put(static_cast<uint64_t>(value.size()));
+          data_.insert(data_.end(), value.begin(), value.end());
+        }
+
+        void putByte(uint8_t value) {
+          data_.push_back(value);
+        }
+
+        const std::vector<uint8_t> &data() const {
+          return data_;
+        }
+
+       private:
+        std::vector<uint8_t> data_;
+      };
+
+      /**
+       * Reads values written by EntryWriter, fails on truncated entry
+       */
+      class EntryReader {
+       public:
+        EntryReader(const uint8_t *data, size_t size)
+            : data_(data), size_(size) {}
+
+        bool get(uint64_t &value) {
+          if (size_ - offset_ < sizeof(value)) {
+            return false;
+          }
+          std::memcpy(&value, data_ + offset_, sizeof(value));
+          offset_ += sizeof(value);
+          return true;
+        }
+
+        bool get(std::string &value) {
+          uint64_t length;
+          if (not get(length) or size_ - offset_ < length) {
+            return false;
+          }
+          value.assign(reinterpret_cast<const char *>(data_ + offset_),
+                       length);
+          offset_ += length;
+          return true;
+        }
+
+        bool getByte(uint8_t &value) {
+          if (offset_ == size_) {
+            return false;
+          }
+          value = data_[offset_++];
+          return true;
+        }
+
+       private:
+        const uint8_t *data_;
+        size_t size_;
+        size_t offset_ = 0;
+      };
+
+      /**
+       * Serialize rows of one table
+       */
+      std::vector<uint8_t> serializeRows(const std::string &table,
+                                         const pqxx::result &rows) {
+        EntryWriter entry;
+        entry.put(table);
+        entry.put(static_cast<uint64_t>(rows.columns()));
+        for (pqxx::row_size_type i = 0; i < rows.columns(); ++i) {
+          entry.put(std::string(rows.column_name(i)));
+        }
+        entry.put(static_cast<uint64_t>(rows.size()));
+        for (const auto &row : rows) {
+          for (const auto &field : row) {
+            entry.putByte(field.is_null() ? 1 : 0);
+            entry.put(field.is_null() ? std::string() : field.c_str());
+          }
+        }
+        return entry.data();
+      }
+
+      /**
+       * Build insertion of rows serialized by serializeRows
+       * @return statement, none if entry is damaged
+       */
+      boost::optional<std::string> deserializeRows(
+          const FlatFile::BlobView &view, pqxx::transaction_base &txn) {
+        EntryReader entry(view.data(), view.size());
+        std::string table;
+        uint64_t columns, rows;
+        if (not entry.get(table) or not entry.get(columns) or columns == 0
+            or std::find(kTables.begin(), kTables.end(), table)
+                == kTables.end()) {
+          return boost::none;
+        }
+
+        std::string statement = "INSERT INTO " + txn.quote_name(table) + " (";
+        for (uint64_t i = 0; i < columns; ++i) {
+          std::string column;
+          if (not entry.get(column)) {
+            return boost::none;
+          }
+          statement += (i == 0 ? "" : ", ") + txn.quote_name(column);
+        }
+        if (not entry.get(rows)) {
+          return boost::none;
+        }
+        if (rows == 0) {
+          return std::string();
+        }
+
+        statement += ") VALUES ";
+        for (uint64_t row = 0; row < rows; ++row) {
+          statement += row == 0 ? "(" : ", (";
+          for (uint64_t i = 0; i < columns; ++i) {
+            uint8_t is_null;
+            std::string value;
+            if (not entry.getByte(is_null) or not entry.get(value)) {
+              return boost::none;
+            }
+            statement += (i == 0 ? "" : ", ")
+                + (is_null ? std::string("NULL") : txn.quote(value));
+          }
+          statement += ")";
+        }
+        return statement + ";";
+      }
+    }  // namespace
+
+    const size_t WsvSnapshotStore::kDefaultKeptSnapshots;
+
+    boost::optional<std::unique_ptr<WsvSnapshotStore>>
+    WsvSnapshotStore::create(const std::string &directory, size_t kept) {
+      auto log = logger::log("WsvSnapshotStore::create()");
+      boost::system::error_code err;
+      if (not boost::filesystem::is_directory(directory, err)
+          and not boost::filesystem::create_directories(directory, err)) {
+        log->error(
+            "Cannot create snapshot dir: {}\n{}", directory, err.message());
+        return boost::none;
+      }
+
+      // remove snapshots which were not completed before shutdown
+      for (const auto &entry :
+           boost::filesystem::directory_iterator{directory}) {
+        if (entry.path().extension() == kTemporarySuffix) {
+          boost::filesystem::remove_all(entry.path(), err);
+        }
+      }
+      return std::unique_ptr<WsvSnapshotStore>(
+          new WsvSnapshotStore(directory, std::max<size_t>(kept, 1)));
+    }
+
+    WsvSnapshotStore::WsvSnapshotStore(std::string directory, size_t kept)
+        : directory_(std::move(directory)),
+          kept_(kept),
+          log_(logger::log("WsvSnapshotStore")) {}
+
+    boost::optional<WsvSnapshotStore::Header> WsvSnapshotStore::save(
+        pqxx::connection_base &connection) {
+      boost::optional<Header> result;
+      std::string temporary;
+      try {
+        pqxx::work txn(connection, "WsvSnapshot");
+        txn.exec("SET TRANSACTION ISOLATION LEVEL REPEATABLE READ, READ ONLY;");
+        auto top = txn.exec(
+            "SELECT height, hash FROM height_by_block_hash "
+            "ORDER BY height DESC LIMIT 1;");
+        if (top.empty()) {
+          return boost::none;
+        }
+        Header header{top[0].at("height").as<HeightType>(),
+                      HashType(pqxx::binarystring(top[0].at("hash")).str())};
+        if (boost::filesystem::exists(path(header.height))) {
+          return header;
+        }
+
+        temporary = path(header.height) + kTemporarySuffix;
+        boost::system::error_code err;
+        boost::filesystem::remove_all(temporary, err);
+        auto file = FlatFile::create(temporary);
+        if (not file) {
+          return boost::none;
+        }
+
+        EntryWriter header_entry;
+        header_entry.put(kSnapshotVersion);
+        header_entry.put(static_cast<uint64_t>(header.height));
+        header_entry.put(bytesToString(header.top_hash.blob()));
+        auto id = kHeaderId;
+        auto written = (*file)->add(id++, header_entry.data());
+
+        for (const auto &table : kTables) {
+          txn.exec("DECLARE snapshot_cursor NO SCROLL CURSOR FOR SELECT * FROM "
+                   + txn.quote_name(table) + ";");
+          pqxx::result rows;
+          do {
+            rows = txn.exec("FETCH " + std::to_string(kRowsPerEntry)
+                            + " FROM snapshot_cursor;");
+            written =
+                written and (*file)->add(id++, serializeRows(table, rows));
+          } while (written and rows.size() == kRowsPerEntry);
+          txn.exec("CLOSE snapshot_cursor;");
+          if (not written) {
+            break;
+          }
+        }
+        file->reset();
+
+        if (written) {
+          boost::filesystem::rename(temporary, path(header.height), err);
+          if (not err) {
+            result = header;
+          }
+        }
+      } catch (const std::exception &e) {
+        log_->error("Cannot save snapshot: {}", e.what());
+      }
+
+      if (not result) {
+        boost::system::error_code err;
+        if (not temporary.empty()) {
+          boost::filesystem::remove_all(temporary, err);
+        }
+        log_->error("Snapshot is not saved");
+        return boost::none;
+      }
+      log_->info("saved snapshot at height {}", result->height);
+      prune();
+      return result;
+    }
+
+    std::vector<HeightType> WsvSnapshotStore::heights() const {
+      std::vector<HeightType> result;
+      boost::system::error_code err;
+      for (boost::filesystem::directory_iterator it{directory_, err}, end;
+           not err and it != end;
+           it.increment(err)) {
+        auto name = it->path().filename().string();
+        if (name.size() == FlatFile::DIGIT_CAPACITY
+            and std::all_of(name.begin(), name.end(), ::isdigit)) {
+          result.push_back(std::stoull(name));
+        }
+      }
+      std::sort(result.rbegin(), result.rend());
+      return result;
+    }
+
+    boost::optional<WsvSnapshotStore::Header> WsvSnapshotStore::header(
+        HeightType height) const {
+      auto file = FlatFile::create(path(height));
+      if (not file) {
+        return boost::none;
+      }
+      auto view = (*file)->getView(kHeaderId);
+      if (not view) {
+        return boost::none;
+      }
+
+      EntryReader entry(view->data(), view->size());
+      uint64_t version, stored_height;
+      std::string hash;
+      if (not entry.get(version) or version != kSnapshotVersion
+          or not entry.get(stored_height) or stored_height != height
+          or not entry.get(hash)) {
+        log_->warn("snapshot at height {} is damaged", height);
+        return boost::none;
+      }
+      return Header{height, HashType(hash)};
+    }
+
+    bool WsvSnapshotStore::load(HeightType height,
+                                pqxx::transaction_base &transaction) const {
+      auto file = FlatFile::create(path(height));
+      if (not file) {
+        return false;
+      }
+      for (auto id = kHeaderId + 1; id <= (*file)->last_id(); ++id) {
+        auto statement = (*file)->getView(id) | [&transaction](auto view) {
+          return deserializeRows(view, transaction);
+        };
+        if (not statement) {
+          log_->error("entry {} of snapshot at height {} is damaged",
+                      id,
+                      height);
+          return false;
+        }
+        if (not statement->empty()) {
+          transaction.exec(*statement);
+        }
+      }
+      // ids were inserted explicitly, so the sequence is not advanced
+      transaction.exec(
+          "SELECT setval(pg_get_serial_sequence('index_by_creator_height', "
+          "'id'), COALESCE(MAX(id), 0) + 1, false) "
+          "FROM index_by_creator_height;");
+      return true;
+    }
+
+    void WsvSnapshotStore::dropAll() {
+      boost::system::error_code err;
+      for (auto height : heights()) {
+        boost::filesystem::remove_all(path(height), err);
+      }
+    }
+
+    std::string WsvSnapshotStore::path(HeightType height) const {
+      return (boost::filesystem::path{directory_}
+              / FlatFile::id_to_name(height))
+          .string();
+    }
+
+    void WsvSnapshotStore::prune() {
+      auto stored = heights();
+      boost::system::error_code err;
+      for (size_t i = kept_; i < stored.size(); ++i) {
+        boost::filesystem::remove_all(path(stored[i]), err);
+        log_->info("removed snapshot at height {}", stored[i]);
+      }
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
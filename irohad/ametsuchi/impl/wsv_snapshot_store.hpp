@@ -0,0 +1,122 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_WSV_SNAPSHOT_STORE_HPP
+#define IROHA_WSV_SNAPSHOT_STORE_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include <pqxx/connection_base>
+#include <pqxx/transaction_base>
+
+#include "interfaces/common_objects/types.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Storage of WSV snapshots. Every snapshot is a FlatFile in its own
+     * directory named by the height of the top block, with a header entry
+     * followed by chunks of table rows. Snapshot is written to a temporary
+     * directory and renamed when complete, so a crash leaves no partial
+     * snapshot behind
+     */
+    class WsvSnapshotStore {
+     public:
+      /**
+       * Block which the snapshot state corresponds to
+       */
+      struct Header {
+        shared_model::interface::types::HeightType height;
+        shared_model::interface::types::HashType top_hash;
+      };
+
+      /// default number of latest snapshots kept on disk
+      static const size_t kDefaultKeptSnapshots = 2;
+
+      /**
+       * Create snapshot store in the directory
+       * @param directory - directory of snapshots, created if missing
+       * @param kept - number of latest snapshots kept on disk
+       * @return created store
+       */
+      static boost::optional<std::unique_ptr<WsvSnapshotStore>> create(
+          const std::string &directory,
+          size_t kept = kDefaultKeptSnapshots);
+
+      /**
+       * Write snapshot of the committed WSV. Tables are read in a single
+       * repeatable read transaction, so the snapshot is consistent with the
+       * top block indexed in it
+       * @param connection - connection to WSV database
+       * @return header of written snapshot, none on failure
+       */
+      boost::optional<Header> save(pqxx::connection_base &connection);
+
+      /**
+       * @return heights of stored snapshots, latest first
+       */
+      std::vector<shared_model::interface::types::HeightType> heights() const;
+
+      /**
+       * Read header of snapshot
+       * @param height - height of snapshot
+       * @return header, none if snapshot is missing or damaged
+       */
+      boost::optional<Header> header(
+          shared_model::interface::types::HeightType height) const;
+
+      /**
+       * Insert rows of snapshot to empty WSV tables
+       * @param height - height of snapshot
+       * @param transaction - transaction to WSV database
+       * @return true if all rows are inserted
+       */
+      bool load(shared_model::interface::types::HeightType height,
+                pqxx::transaction_base &transaction) const;
+
+      /**
+       * Remove all snapshots
+       */
+      void dropAll();
+
+     private:
+      WsvSnapshotStore(std::string directory, size_t kept);
+
+      /**
+       * @return directory of snapshot with given height
+       */
+      std::string path(shared_model::interface::types::HeightType height) const;
+
+      /**
+       * Remove snapshots except the kept latest ones
+       */
+      void prune();
+
+      const std::string directory_;
+      const size_t kept_;
+      logger::Logger log_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_WSV_SNAPSHOT_STORE_HPP
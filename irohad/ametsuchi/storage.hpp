@@ -19,9 +19,11 @@
 #define IROHA_AMETSUCHI_H
 
 #include <vector>
+#include <boost/optional.hpp>
 #include "ametsuchi/mutable_factory.hpp"
 #include "ametsuchi/temporary_factory.hpp"
 #include "common/result.hpp"
+#include "interfaces/common_objects/types.hpp"
 
 namespace shared_model {
   namespace interface {
@@ -42,7 +44,14 @@ namespace iroha {
      */
     class Storage : public TemporaryFactory, public MutableFactory {
      public:
-      virtual std::shared_ptr<WsvQuery> getWsvQuery() const = 0;
+      /**
+       * Create query on committed world state view. The query holds a
+       * pooled database connection while it exists, so it should not be
+       * kept longer than needed
+       * @return WSV query, or none if no database connection is available
+       */
+      virtual boost::optional<std::shared_ptr<WsvQuery>> getWsvQuery()
+          const = 0;
 
       virtual std::shared_ptr<BlockQuery> getBlockQuery() const = 0;
 
@@ -65,6 +74,19 @@ namespace iroha {
        */
       virtual void dropStorage() = 0;
 
+      /**
+       * Remove world state view, blocks are kept in the block store
+       */
+      virtual void dropWsv() = 0;
+
+      /**
+       * Replace world state view with the latest stored snapshot which
+       * matches the block store
+       * @return height of the restored state, none if no snapshot is usable
+       */
+      virtual boost::optional<shared_model::interface::types::HeightType>
+      restoreWsvSnapshot() = 0;
+
       virtual ~Storage() = default;
     };
 
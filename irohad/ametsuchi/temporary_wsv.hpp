@@ -19,6 +19,7 @@
 #define IROHA_TEMPORARYWSV_HPP
 
 #include <functional>
+#include <vector>
 
 #include "ametsuchi/wsv_command.hpp"
 #include "ametsuchi/wsv_query.hpp"
@@ -38,6 +39,9 @@ namespace iroha {
      */
     class TemporaryWsv {
      public:
+      using TransactionRefs = std::vector<
+          std::reference_wrapper<const shared_model::interface::Transaction>>;
+
       /**
        * Applies a transaction to current state
        * using logic specified in function
@@ -56,6 +60,29 @@ namespace iroha {
           std::function<bool(const shared_model::interface::Transaction &,
                              WsvQuery &)> function) = 0;
 
+      /**
+       * Applies transactions which do not conflict with each other, so that
+       * the result does not depend on the order of application. Changes of
+       * successful transactions are kept like after sequential application
+       * of transactions in the given order, implementation may apply them
+       * concurrently
+       * @param transactions - independent transactions to be applied
+       * @param function - function that specifies the logic used to apply
+       * the transaction, it may be called concurrently
+       * @return flags of successful application of transactions
+       */
+      virtual std::vector<bool> applyIndependent(
+          const TransactionRefs &transactions,
+          std::function<bool(const shared_model::interface::Transaction &,
+                             WsvQuery &)> function) {
+        std::vector<bool> result;
+        result.reserve(transactions.size());
+        for (const auto &transaction : transactions) {
+          result.push_back(apply(transaction, function));
+        }
+        return result;
+      }
+
       virtual ~TemporaryWsv() = default;
     };
   }  // namespace ametsuchi
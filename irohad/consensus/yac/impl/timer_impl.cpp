@@ -16,22 +16,26 @@
  */
 
 #include "consensus/yac/impl/timer_impl.hpp"
-#include <iostream>
 
 namespace iroha {
   namespace consensus {
     namespace yac {
+      TimerImpl::TimerImpl(std::shared_ptr<timer::TimerWheel> wheel)
+          : wheel_(std::move(wheel)),
+            handle_(timer::TimerWheel::kNoTimer) {}
+
       void TimerImpl::invokeAfterDelay(uint64_t millis,
                                        std::function<void()> handler) {
-        deny();
-        handler_ = std::move(handler);
-        timer = rxcpp::observable<>::timer(std::chrono::milliseconds(millis));
-        handle = timer.subscribe_on(rxcpp::observe_on_new_thread())
-                     .subscribe([this](auto) { handler_(); });
+        std::lock_guard<std::mutex> lock(handle_mutex_);
+        wheel_->cancel(handle_);
+        handle_ = wheel_->schedule(std::chrono::milliseconds(millis),
+                                   std::move(handler));
       }
 
       void TimerImpl::deny() {
-        handle.unsubscribe();
+        std::lock_guard<std::mutex> lock(handle_mutex_);
+        wheel_->cancel(handle_);
+        handle_ = timer::TimerWheel::kNoTimer;
       }
 
       TimerImpl::~TimerImpl() {
@@ -18,15 +18,21 @@
 #ifndef IROHA_TIMER_IMPL_HPP
 #define IROHA_TIMER_IMPL_HPP
 
-#include <rxcpp/rx.hpp>
+#include <mutex>
+
 #include "consensus/yac/timer.hpp"
+#include "timer/timer_wheel.hpp"
 
 namespace iroha {
   namespace consensus {
     namespace yac {
       class TimerImpl : public Timer {
        public:
-        TimerImpl() = default;
+        /**
+         * @param wheel - timer wheel which invokes handlers
+         */
+        explicit TimerImpl(std::shared_ptr<timer::TimerWheel> wheel =
+                               timer::defaultTimerWheel());
         TimerImpl(const TimerImpl &) = delete;
         TimerImpl &operator=(const TimerImpl &) = delete;
 
@@ -37,10 +43,13 @@ namespace iroha {
         ~TimerImpl() override;
 
        private:
-        std::function<void()> handler_;
+        std::shared_ptr<timer::TimerWheel> wheel_;
 
-        rxcpp::observable<long> timer;
-        rxcpp::composite_subscription handle;
+        /**
+         * Timer of the last submitted handler
+         */
+        timer::TimerWheel::TimerId handle_;
+        std::mutex handle_mutex_;
       };
     }  // namespace yac
   }    // namespace consensus
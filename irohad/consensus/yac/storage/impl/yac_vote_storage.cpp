@@ -28,32 +28,72 @@ namespace iroha {
 
       // --------| private api |--------
 
-      auto YacVoteStorage::getProposalStorage(ProposalHash hash) {
-        return std::find_if(proposal_storages_.begin(),
-                            proposal_storages_.end(),
-                            [&hash](auto storage) {
-                              return storage.getProposalHash() == hash;
-                            });
+      YacProposalStorage *YacVoteStorage::getProposalStorage(
+          const ProposalHash &hash) {
+        auto iter = proposal_storages_.find(hash);
+        if (iter == proposal_storages_.end()) {
+          return nullptr;
+        }
+        return &iter->second;
+      }
+
+      YacProposalStorage &YacVoteStorage::findProposalStorage(
+          const VoteMessage &msg, uint64_t peers_in_round) {
+        const auto &hash = msg.hash.proposal_hash;
+        if (auto storage = getProposalStorage(hash)) {
+          return *storage;
+        }
+        auto &storage =
+            proposal_storages_
+                .emplace(std::piecewise_construct,
+                         std::forward_as_tuple(hash),
+                         std::forward_as_tuple(
+                             hash,
+                             peers_in_round,
+                             std::make_shared<SupermajorityCheckerImpl>()))
+                .first->second;
+        rounds_order_.push_back(hash);
+        removeOldRounds();
+        return storage;
+      }
+
+      void YacVoteStorage::removeOldRounds() {
+        if (not last_committed_) {
+          return;
+        }
+        auto older = std::distance(
+            rounds_order_.begin(),
+            std::find(
+                rounds_order_.begin(), rounds_order_.end(), *last_committed_));
+        for (; older > 0 and rounds_order_.size() > rounds_window_; --older) {
+          const auto &hash = rounds_order_.front();
+          proposal_storages_.erase(hash);
+          processing_state_.erase(hash);
+          rounds_order_.pop_front();
+        }
       }
 
-      auto YacVoteStorage::findProposalStorage(const VoteMessage &msg,
-                                               uint64_t peers_in_round) {
-        auto val = getProposalStorage(msg.hash.proposal_hash);
-        if (val != proposal_storages_.end()) {
-          return val;
+      boost::optional<Answer> YacVoteStorage::updateCommitted(
+          const ProposalHash &hash, boost::optional<Answer> answer) {
+        if (answer and boost::get<CommitMessage>(&*answer)) {
+          last_committed_ = hash;
+          removeOldRounds();
         }
-        return proposal_storages_.emplace(
-            proposal_storages_.end(),
-            msg.hash.proposal_hash,
-            peers_in_round,
-            std::make_shared<SupermajorityCheckerImpl>());
+        return answer;
       }
 
       // --------| public api |--------
 
+      const size_t YacVoteStorage::kDefaultRoundsWindow;
+
+      YacVoteStorage::YacVoteStorage(size_t rounds_window)
+          : rounds_window_(std::max<size_t>(rounds_window, 1)) {}
+
       boost::optional<Answer> YacVoteStorage::store(VoteMessage vote,
                                                      uint64_t peers_in_round) {
-        return findProposalStorage(vote, peers_in_round)->insert(vote);
+        return updateCommitted(
+            vote.hash.proposal_hash,
+            findProposalStorage(vote, peers_in_round).insert(vote));
       }
 
       boost::optional<Answer> YacVoteStorage::store(CommitMessage commit,
@@ -67,11 +107,11 @@ namespace iroha {
       }
 
       bool YacVoteStorage::isHashCommitted(ProposalHash hash) {
-        auto iter = getProposalStorage(std::move(hash));
-        if (iter == proposal_storages_.end()) {
+        auto storage = getProposalStorage(hash);
+        if (not storage) {
           return false;
         }
-        return bool(iter->getState());
+        return bool(storage->getState());
       }
 
       bool YacVoteStorage::getProcessingState(const ProposalHash &hash) {
@@ -82,6 +122,10 @@ namespace iroha {
         processing_state_.insert(hash);
       }
 
+      size_t YacVoteStorage::roundsNumber() const {
+        return proposal_storages_.size();
+      }
+
       // --------| private api |--------
 
       boost::optional<Answer> YacVoteStorage::insert_votes(
@@ -90,8 +134,9 @@ namespace iroha {
           return boost::none;
         }
 
-        auto storage = findProposalStorage(votes.at(0), peers_in_round);
-        return storage->insert(votes);
+        return updateCommitted(
+            votes.at(0).hash.proposal_hash,
+            findProposalStorage(votes.at(0), peers_in_round).insert(votes));
       }
 
     }  // namespace yac
@@ -18,33 +18,39 @@
 #ifndef IROHA_YAC_VOTE_STORAGE_HPP
 #define IROHA_YAC_VOTE_STORAGE_HPP
 
-#include <memory>
 #include <boost/optional.hpp>
+#include <deque>
+#include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "consensus/yac/messages.hpp"  // because messages passed by value
 #include "consensus/yac/storage/storage_result.hpp"  // for Answer
 #include "consensus/yac/storage/yac_common.hpp"      // for ProposalHash
+#include "consensus/yac/storage/yac_proposal_storage.hpp"
 
 namespace iroha {
   namespace consensus {
     namespace yac {
-      class YacProposalStorage;
 
       /**
        * Class provide storage for votes and useful methods for it.
+       * Only a window of the most recent rounds is kept, votes and
+       * processing state of older rounds are removed. Rounds are removed
+       * only if they were started before the last committed round, so votes
+       * for unknown hashes cannot push out the current or committed rounds.
        */
       class YacVoteStorage {
        private:
         // --------| private api |--------
 
         /**
-         * Retrieve iterator for storage with parameters hash
+         * Retrieve storage with parameters hash
          * @param hash - object for finding
-         * @return iterator to proposal storage
+         * @return pointer to proposal storage, nullptr if absent
          */
-        auto getProposalStorage(ProposalHash hash);
+        YacProposalStorage *getProposalStorage(const ProposalHash &hash);
 
         /**
          * Find existed proposal storage or create new if required
@@ -52,14 +58,38 @@ namespace iroha {
          * @param peers_in_round - number of peer required
          * for verify supermajority;
          * This parameter used on creation of proposal storage
-         * @return - iter for required proposal storage
+         * @return - required proposal storage
+         */
+        YacProposalStorage &findProposalStorage(const VoteMessage &msg,
+                                                uint64_t peers_in_round);
+
+        /**
+         * Remove the oldest rounds which do not fit into the window and
+         * were started before the last committed round
+         */
+        void removeOldRounds();
+
+        /**
+         * Remember the round as the last committed one, if the answer is
+         * commit
+         * @param hash - hash of the round
+         * @param answer - result of insertion into the round
+         * @return the same answer
          */
-        auto findProposalStorage(const VoteMessage &msg,
-                                 uint64_t peers_in_round);
+        boost::optional<Answer> updateCommitted(
+            const ProposalHash &hash, boost::optional<Answer> answer);
 
        public:
         // --------| public api |--------
 
+        /// number of rounds kept by default
+        static const size_t kDefaultRoundsWindow = 100;
+
+        /**
+         * @param rounds_window - number of the most recent rounds to keep
+         */
+        explicit YacVoteStorage(size_t rounds_window = kDefaultRoundsWindow);
+
         /**
          * Insert vote in storage
          * @param msg - current vote message
@@ -109,6 +139,11 @@ namespace iroha {
          */
         void markAsProcessedState(const ProposalHash &hash);
 
+        /**
+         * @return number of rounds kept in storage
+         */
+        size_t roundsNumber() const;
+
        private:
         // --------| private api |--------
 
@@ -123,10 +158,27 @@ namespace iroha {
 
         // --------| fields |--------
 
+        /**
+         * Maximal number of rounds kept in storage
+         */
+        size_t rounds_window_;
+
         /**
          * Active proposal storages
          */
-        std::vector<YacProposalStorage> proposal_storages_;
+        std::unordered_map<ProposalHash, YacProposalStorage>
+            proposal_storages_;
+
+        /**
+         * Hashes of active proposal storages, from the oldest to the newest
+         */
+        std::deque<ProposalHash> rounds_order_;
+
+        /**
+         * Hash of the latest committed round, rounds started before it can
+         * be removed
+         */
+        boost::optional<ProposalHash> last_committed_;
 
         /**
          * Processing set provide user flags about processing some hashes.
@@ -30,7 +30,8 @@ namespace iroha {
     namespace yac {
       // ----------| Public API |----------
 
-      NetworkImpl::NetworkImpl() {
+      NetworkImpl::NetworkImpl(size_t max_in_flight)
+          : AsyncGrpcClient(kDefaultPollers, max_in_flight) {
         log_ = logger::log("YacNetwork");
       }
 
@@ -45,7 +46,14 @@ namespace iroha {
 
         auto request = PbConverters::serializeVote(vote);
 
-        auto call = new AsyncClientCall;
+        auto call = newCall(to.address(), "vote");
+        if (not call) {
+          // voting step sends the vote to the next peer after a delay
+          log_->warn("Too many calls in flight to {}, vote {} is dropped",
+                     to.address(),
+                     vote.hash.block_hash);
+          return;
+        }
 
         call->response_reader =
             peers_.at(to.address())
@@ -66,7 +74,9 @@ namespace iroha {
           *pb_vote = PbConverters::serializeVote(vote);
         }
 
-        auto call = new AsyncClientCall;
+        // commit is sent even if the peer is slow, since the peer cannot
+        // finish the round without it
+        auto call = newCall(to.address(), "commit", false);
 
         call->response_reader =
             peers_.at(to.address())
@@ -89,7 +99,9 @@ namespace iroha {
           *pb_vote = PbConverters::serializeVote(vote);
         }
 
-        auto call = new AsyncClientCall;
+        // reject is sent even if the peer is slow, since the peer cannot
+        // finish the round without it
+        auto call = newCall(to.address(), "reject", false);
 
         call->response_reader =
             peers_.at(to.address())
@@ -42,7 +42,15 @@ namespace iroha {
                           public proto::Yac::Service,
                           network::AsyncGrpcClient<google::protobuf::Empty> {
        public:
-        NetworkImpl();
+        /**
+         * @param max_in_flight - max number of not completed calls to a
+         * peer, votes over the limit are dropped, while commits and rejects
+         * are always sent since they finish the round
+         */
+        explicit NetworkImpl(size_t max_in_flight = kDefaultMaxInFlight);
+
+        using network::AsyncGrpcClient<google::protobuf::Empty>::statistics;
+
         void subscribe(
             std::shared_ptr<YacNetworkNotifications> handler) override;
         void send_commit(const shared_model::interface::Peer &to,
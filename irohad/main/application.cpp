@@ -42,7 +42,10 @@ Irohad::Irohad(const std::string &block_store_dir,
                std::chrono::milliseconds proposal_delay,
                std::chrono::milliseconds vote_delay,
                std::chrono::milliseconds load_delay,
-               const keypair_t &keypair)
+               const keypair_t &keypair,
+               bool pipelined_consensus,
+               bool adaptive_proposal_batching,
+               size_t snapshot_interval)
     : block_store_dir_(block_store_dir),
       pg_conn_(pg_conn),
       torii_port_(torii_port),
@@ -51,6 +54,10 @@ Irohad::Irohad(const std::string &block_store_dir,
       proposal_delay_(proposal_delay),
       vote_delay_(vote_delay),
       load_delay_(load_delay),
+      pipelined_consensus_(pipelined_consensus),
+      adaptive_proposal_batching_(adaptive_proposal_batching),
+      snapshot_interval_(snapshot_interval),
+      timer_wheel_(iroha::timer::defaultTimerWheel()),
       keypair(keypair) {
   log_ = logger::log("IROHAD");
   log_->info("created");
@@ -93,7 +100,8 @@ void Irohad::dropStorage() {
  * Initializing iroha daemon storage
  */
 void Irohad::initStorage() {
-  auto storageResult = StorageImpl::create(block_store_dir_, pg_conn_);
+  auto storageResult =
+      StorageImpl::create(block_store_dir_, pg_conn_, snapshot_interval_);
   storageResult.match(
       [&](expected::Value<std::shared_ptr<ametsuchi::StorageImpl>> &_storage) {
         storage = _storage.value;
@@ -127,7 +135,7 @@ bool Irohad::restoreWsv() {
  * Initializing peer query interface
  */
 void Irohad::initPeerQuery() {
-  wsv = std::make_shared<ametsuchi::PeerQueryWsv>(storage->getWsvQuery());
+  wsv = std::make_shared<ametsuchi::PeerQueryWsv>(storage);
 
   log_->info("[Init] => peer query");
 }
@@ -160,8 +168,13 @@ void Irohad::initValidators() {
  * Initializing ordering gate
  */
 void Irohad::initOrderingGate() {
-  ordering_gate = ordering_init.initOrderingGate(
-      wsv, max_proposal_size_, proposal_delay_, ordering_service_storage_);
+  ordering_gate = ordering_init.initOrderingGate(wsv,
+                                                 max_proposal_size_,
+                                                 proposal_delay_,
+                                                 ordering_service_storage_,
+                                                 pipelined_consensus_,
+                                                 adaptive_proposal_batching_,
+                                                 timer_wheel_);
   log_->info("[Init] => init ordering gate - [{}]",
              logger::logBool(ordering_gate));
 }
@@ -174,7 +187,8 @@ void Irohad::initSimulator() {
                                           stateful_validator,
                                           storage,
                                           storage->getBlockQuery(),
-                                          crypto_signer_);
+                                          crypto_signer_,
+                                          pipelined_consensus_);
 
   log_->info("[Init] => init simulator");
 }
@@ -193,8 +207,13 @@ void Irohad::initBlockLoader() {
  * Initializing consensus gate
  */
 void Irohad::initConsensusGate() {
-  consensus_gate = yac_init.initConsensusGate(
-      wsv, simulator, block_loader, keypair, vote_delay_, load_delay_);
+  consensus_gate = yac_init.initConsensusGate(wsv,
+                                              simulator,
+                                              block_loader,
+                                              keypair,
+                                              vote_delay_,
+                                              load_delay_,
+                                              timer_wheel_);
 
   log_->info("[Init] => consensus gate");
 }
@@ -222,6 +241,25 @@ void Irohad::initPeerCommunicationService() {
   pcs->on_commit().subscribe(
       [this](auto) { log_->info("~~~~~~~~~| COMMIT =^._.^= |~~~~~~~~~ "); });
 
+  pcs->on_commit().subscribe([this](auto) {
+    auto timers = timer_wheel_->statistics();
+    log_->debug(
+        "timers: scheduled {}, fired {}, cancelled {}, pending {}, "
+        "threads started {}",
+        timers.scheduled,
+        timers.fired,
+        timers.cancelled,
+        timers.pending,
+        timer_wheel_->executorStatistics().threads_started);
+  });
+
+  // commit latency is used by adaptive proposal batching
+  pcs->on_commit().subscribe(
+      [this](auto) { ordering_init.ordering_service->onCommit(); });
+
+  // simulator has to handle commit before the ordering gate starts next round
+  simulator->setPcs(*pcs);
+
   // complete initialization of ordering gate
   ordering_gate->setPcs(*pcs);
 
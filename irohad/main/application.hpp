@@ -67,6 +67,12 @@ class Irohad {
    * @param load_delay - waiting time before loading committed block from next
    * peer
    * @param keypair - public and private keys for crypto signer
+   * @param pipelined_consensus - validate next proposal while previous block
+   * is being committed
+   * @param adaptive_proposal_batching - adapt proposal size and delay to the
+   * load, max_proposal_size and proposal_delay are used as upper bounds
+   * @param snapshot_interval - number of blocks between WSV snapshots used
+   * for restart, 0 disables snapshots
    */
   Irohad(const std::string &block_store_dir,
          const std::string &pg_conn,
@@ -76,7 +82,10 @@ class Irohad {
          std::chrono::milliseconds proposal_delay,
          std::chrono::milliseconds vote_delay,
          std::chrono::milliseconds load_delay,
-         const iroha::keypair_t &keypair);
+         const iroha::keypair_t &keypair,
+         bool pipelined_consensus = false,
+         bool adaptive_proposal_batching = false,
+         size_t snapshot_interval = 0);
 
   /**
    * Initialization of whole objects in system
@@ -147,9 +156,15 @@ class Irohad {
   std::chrono::milliseconds proposal_delay_;
   std::chrono::milliseconds vote_delay_;
   std::chrono::milliseconds load_delay_;
+  bool pipelined_consensus_;
+  bool adaptive_proposal_batching_;
+  size_t snapshot_interval_;
 
   // ------------------------| internal dependencies |-------------------------
 
+  // timers of consensus and ordering
+  std::shared_ptr<iroha::timer::TimerWheel> timer_wheel_;
+
   // crypto provider
   std::shared_ptr<shared_model::crypto::CryptoModelSigner<>> crypto_signer_;
 
@@ -44,8 +44,9 @@ namespace iroha {
         return crypto;
       }
 
-      auto YacInit::createTimer() {
-        return std::make_shared<TimerImpl>();
+      auto YacInit::createTimer(
+          std::shared_ptr<timer::TimerWheel> timer_wheel) {
+        return std::make_shared<TimerImpl>(std::move(timer_wheel));
       }
 
       auto YacInit::createHashProvider() {
@@ -55,11 +56,12 @@ namespace iroha {
       std::shared_ptr<consensus::yac::Yac> YacInit::createYac(
           ClusterOrdering initial_order,
           const keypair_t &keypair,
-          std::chrono::milliseconds delay_milliseconds) {
+          std::chrono::milliseconds delay_milliseconds,
+          std::shared_ptr<timer::TimerWheel> timer_wheel) {
         return Yac::create(YacVoteStorage(),
                            createNetwork(),
                            createCryptoProvider(keypair),
-                           createTimer(),
+                           createTimer(std::move(timer_wheel)),
                            initial_order,
                            delay_milliseconds.count());
       }
@@ -70,12 +72,14 @@ namespace iroha {
           std::shared_ptr<network::BlockLoader> block_loader,
           const keypair_t &keypair,
           std::chrono::milliseconds vote_delay_milliseconds,
-          std::chrono::milliseconds load_delay_milliseconds) {
+          std::chrono::milliseconds load_delay_milliseconds,
+          std::shared_ptr<timer::TimerWheel> timer_wheel) {
         auto peer_orderer = createPeerOrderer(wsv);
 
         auto yac = createYac(peer_orderer->getInitialOrdering().value(),
                              keypair,
-                             vote_delay_milliseconds);
+                             vote_delay_milliseconds,
+                             std::move(timer_wheel));
         consensus_network->subscribe(yac);
 
         auto hash_provider = createHashProvider();
@@ -22,8 +22,9 @@
 namespace iroha {
   namespace network {
     auto OrderingInit::createGate(
-        std::shared_ptr<OrderingGateTransport> transport) {
-      auto gate = std::make_shared<ordering::OrderingGateImpl>(transport);
+        std::shared_ptr<OrderingGateTransport> transport, bool pipelined) {
+      auto gate =
+          std::make_shared<ordering::OrderingGateImpl>(transport, pipelined);
       transport->subscribe(gate);
       return gate;
     }
@@ -34,13 +35,26 @@ namespace iroha {
         std::chrono::milliseconds delay_milliseconds,
         std::shared_ptr<network::OrderingServiceTransport> transport,
         std::shared_ptr<ametsuchi::OrderingServicePersistentState>
-            persistent_state) {
+            persistent_state,
+        bool adaptive_batching,
+        std::shared_ptr<timer::TimerWheel> timer_wheel) {
+      if (adaptive_batching) {
+        // configured values become upper bounds of proposal size and delay
+        return std::make_shared<ordering::OrderingServiceImpl>(
+            wsv,
+            ordering::AdaptiveBatchingPolicy::Bounds{
+                1, max_size, std::chrono::milliseconds(1), delay_milliseconds},
+            transport,
+            persistent_state,
+            timer_wheel);
+      }
       return std::make_shared<ordering::OrderingServiceImpl>(
           wsv,
           max_size,
           delay_milliseconds.count(),
           transport,
-          persistent_state);
+          persistent_state,
+          timer_wheel);
     }
 
     std::shared_ptr<ordering::OrderingGateImpl> OrderingInit::initOrderingGate(
@@ -48,7 +62,10 @@ namespace iroha {
         size_t max_size,
         std::chrono::milliseconds delay_milliseconds,
         std::shared_ptr<ametsuchi::OrderingServicePersistentState>
-            persistent_state) {
+            persistent_state,
+        bool pipelined,
+        bool adaptive_batching,
+        std::shared_ptr<timer::TimerWheel> timer_wheel) {
       auto ledger_peers = wsv->getLedgerPeers();
       if (not ledger_peers or ledger_peers.value().empty()) {
         log_->error(
@@ -57,7 +74,10 @@ namespace iroha {
       auto network_address = ledger_peers->front()->address();
       ordering_gate_transport =
           std::make_shared<iroha::ordering::OrderingGateTransportGrpc>(
-              network_address);
+              network_address,
+              ordering::OrderingGateTransportGrpc::kDefaultMaxBatchSize,
+              ordering::OrderingGateTransportGrpc::kDefaultFlushDelay,
+              timer_wheel);
 
       ordering_service_transport =
           std::make_shared<ordering::OrderingServiceTransportGrpc>();
@@ -65,9 +85,11 @@ namespace iroha {
                                        max_size,
                                        delay_milliseconds,
                                        ordering_service_transport,
-                                       persistent_state);
+                                       persistent_state,
+                                       adaptive_batching,
+                                       timer_wheel);
       ordering_service_transport->subscribe(ordering_service);
-      ordering_gate = createGate(ordering_gate_transport);
+      ordering_gate = createGate(ordering_gate_transport, pipelined);
       return ordering_gate;
     }
   }  // namespace network
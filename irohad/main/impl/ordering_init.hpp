@@ -42,8 +42,9 @@ namespace iroha {
        * Init effective realisation of ordering gate (client of ordering
        * service)
        * @param network_address - address of ordering service
+       * @param pipelined - pass next proposal before previous is committed
        */
-      auto createGate(std::shared_ptr<OrderingGateTransport>);
+      auto createGate(std::shared_ptr<OrderingGateTransport>, bool pipelined);
 
       /**
        * Init ordering service
@@ -51,6 +52,9 @@ namespace iroha {
        * @param max_size - limitation of proposal size
        * @param delay_milliseconds - delay before emitting proposal
        * @param loop - handler of async events
+       * @param adaptive_batching - adapt proposal size and delay to the load,
+       * max_size and delay_milliseconds are used as upper bounds
+       * @param timer_wheel - timer wheel for proposal timer
        */
       auto createService(
           std::shared_ptr<ametsuchi::PeerQuery> wsv,
@@ -58,7 +62,9 @@ namespace iroha {
           std::chrono::milliseconds delay_milliseconds,
           std::shared_ptr<network::OrderingServiceTransport> transport,
           std::shared_ptr<ametsuchi::OrderingServicePersistentState>
-              persistent_state);
+              persistent_state,
+          bool adaptive_batching,
+          std::shared_ptr<timer::TimerWheel> timer_wheel);
 
      public:
       /**
@@ -67,6 +73,9 @@ namespace iroha {
        * @param loop - handler of async events
        * @param max_size - limitation of proposal size
        * @param delay_milliseconds - delay before emitting proposal
+       * @param pipelined - pass next proposal before previous is committed
+       * @param adaptive_batching - adapt proposal size and delay to the load
+       * @param timer_wheel - timer wheel for ordering timers
        * @return effective realisation of OrderingGate
        */
       std::shared_ptr<ordering::OrderingGateImpl> initOrderingGate(
@@ -74,7 +83,11 @@ namespace iroha {
           size_t max_size,
           std::chrono::milliseconds delay_milliseconds,
           std::shared_ptr<ametsuchi::OrderingServicePersistentState>
-              persistent_state);
+              persistent_state,
+          bool pipelined = false,
+          bool adaptive_batching = false,
+          std::shared_ptr<timer::TimerWheel> timer_wheel =
+              timer::defaultTimerWheel());
 
       std::shared_ptr<ordering::OrderingServiceImpl> ordering_service;
       std::shared_ptr<ordering::OrderingGateImpl> ordering_gate;
@@ -35,6 +35,9 @@ namespace config_members {
   const char *ProposalDelay = "proposal_delay";
   const char *VoteDelay = "vote_delay";
   const char *LoadDelay = "load_delay";
+  const char *PipelinedConsensus = "pipelined_consensus";
+  const char *AdaptiveProposalBatching = "adaptive_proposal_batching";
+  const char *SnapshotInterval = "snapshot_interval";
 }  // namespace config_members
 
 /**
@@ -50,6 +53,7 @@ inline rapidjson::Document parse_iroha_config(const std::string &conf_path) {
   rapidjson::IStreamWrapper isw(ifs_iroha);
   const std::string kStrType = "string";
   const std::string kUintType = "uint";
+  const std::string kBoolType = "bool";
   doc.ParseStream(isw);
   ac::assert_fatal(
       not doc.HasParseError(),
@@ -94,6 +98,17 @@ inline rapidjson::Document parse_iroha_config(const std::string &conf_path) {
                    ac::no_member_error(mbr::LoadDelay));
   ac::assert_fatal(doc[mbr::LoadDelay].IsUint(),
                    ac::type_error(mbr::LoadDelay, kUintType));
+
+  // optional member
+  ac::assert_fatal(not doc.HasMember(mbr::PipelinedConsensus)
+                       or doc[mbr::PipelinedConsensus].IsBool(),
+                   ac::type_error(mbr::PipelinedConsensus, kBoolType));
+  ac::assert_fatal(not doc.HasMember(mbr::AdaptiveProposalBatching)
+                       or doc[mbr::AdaptiveProposalBatching].IsBool(),
+                   ac::type_error(mbr::AdaptiveProposalBatching, kBoolType));
+  ac::assert_fatal(not doc.HasMember(mbr::SnapshotInterval)
+                       or doc[mbr::SnapshotInterval].IsUint(),
+                   ac::type_error(mbr::SnapshotInterval, kUintType));
   return doc;
 }
 
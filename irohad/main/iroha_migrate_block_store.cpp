@@ -0,0 +1,55 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gflags/gflags.h>
+
+#include "ametsuchi/impl/block_store_migration.hpp"
+#include "logger/logger.hpp"
+
+/**
+ * Creating input argument for the block store location.
+ */
+DEFINE_string(block_store_path, "", "Specify path to block store to migrate");
+
+/**
+ * One-shot tool which converts block store written in the legacy JSON format
+ * or one-file-per-block layout to the binary block format in segmented
+ * layout. Must be run while irohad is stopped
+ */
+int main(int argc, char *argv[]) {
+  auto log = logger::log("MIGRATE");
+
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  gflags::ShutDownCommandLineFlags();
+
+  if (FLAGS_block_store_path.empty()) {
+    log->error("Block store path is not specified");
+    return EXIT_FAILURE;
+  }
+
+  return iroha::ametsuchi::migrateBlockStore(FLAGS_block_store_path)
+      .match(
+          [&log](const iroha::expected::Value<size_t> &converted) {
+            log->info("Migration finished, {} blocks converted",
+                      converted.value);
+            return EXIT_SUCCESS;
+          },
+          [&log](const iroha::expected::Error<std::string> &error) {
+            log->error("Migration failed: {}", error.error);
+            return EXIT_FAILURE;
+          });
+}
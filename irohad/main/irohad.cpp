@@ -119,7 +119,14 @@ int main(int argc, char *argv[]) {
                 std::chrono::milliseconds(config[mbr::ProposalDelay].GetUint()),
                 std::chrono::milliseconds(config[mbr::VoteDelay].GetUint()),
                 std::chrono::milliseconds(config[mbr::LoadDelay].GetUint()),
-                keypair);
+                keypair,
+                config.HasMember(mbr::PipelinedConsensus)
+                    and config[mbr::PipelinedConsensus].GetBool(),
+                config.HasMember(mbr::AdaptiveProposalBatching)
+                    and config[mbr::AdaptiveProposalBatching].GetBool(),
+                config.HasMember(mbr::SnapshotInterval)
+                    ? config[mbr::SnapshotInterval].GetUint()
+                    : 0);
 
   // Check if iroha daemon storage was successfully initialized
   if (not irohad.storage) {
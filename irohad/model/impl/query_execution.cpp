@@ -284,7 +284,9 @@ QueryProcessingFactory::QueryResponseBuilderDone
 iroha::model::QueryProcessingFactory::executeGetAccountAssetTransactions(
     const shared_model::interface::GetAccountAssetTransactions &query) {
   auto acc_asset_tx = _blockQuery->getAccountAssetTransactions(
-      query.accountId(), query.assetId());
+      query.accountId(),
+      query.assetId(),
+      ametsuchi::TxPagination{query.pageSize(), query.lastTxHash()});
 
   std::vector<shared_model::proto::Transaction> txs;
   acc_asset_tx.subscribe([&](const auto &tx) {
@@ -299,7 +301,9 @@ iroha::model::QueryProcessingFactory::executeGetAccountAssetTransactions(
 QueryProcessingFactory::QueryResponseBuilderDone
 QueryProcessingFactory::executeGetAccountTransactions(
     const shared_model::interface::GetAccountTransactions &query) {
-  auto acc_tx = _blockQuery->getAccountTransactions(query.accountId());
+  auto acc_tx = _blockQuery->getAccountTransactions(
+      query.accountId(),
+      ametsuchi::TxPagination{query.pageSize(), query.lastTxHash()});
 
   std::vector<shared_model::proto::Transaction> txs;
   acc_tx.subscribe([&](const auto &tx) {
@@ -20,19 +20,64 @@
 
 #include <google/protobuf/empty.pb.h>
 #include <grpc++/grpc++.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace iroha {
   namespace network {
 
     /**
-     * Asynchronous gRPC client which does no processing of server responses
+     * Statistics of asynchronous calls of one message type
+     */
+    struct AsyncCallStatistics {
+      static const size_t kLatencyBuckets = 12;
+
+      /// number of completed calls
+      size_t calls = 0;
+      /// number of completed calls with non-ok status
+      size_t failures = 0;
+      /// number of droppable calls not sent because of in-flight limit
+      size_t dropped = 0;
+      /**
+       * Latency histogram: bucket i counts calls completed in less than
+       * 2^i milliseconds (and not less than 2^(i-1)), the last bucket counts
+       * all slower calls
+       */
+      std::array<size_t, kLatencyBuckets> latency{};
+    };
+
+    /**
+     * Asynchronous gRPC client which does no processing of server responses.
+     * Completions are drained by a pool of poller threads, call objects are
+     * reused, number of calls in flight to each peer is limited, and
+     * completion latency and failures are collected per message type
      * @tparam Response type of server response
      */
     template <typename Response>
     class AsyncGrpcClient {
      public:
-      AsyncGrpcClient() : thread_(&AsyncGrpcClient::asyncCompleteRpc, this) {}
+      static const size_t kDefaultPollers = 1;
+      static const size_t kDefaultMaxInFlight = 1024;
+
+      /**
+       * @param pollers - number of threads draining completion queue
+       * @param max_in_flight - max number of not completed calls to a peer
+       */
+      explicit AsyncGrpcClient(size_t pollers = kDefaultPollers,
+                               size_t max_in_flight = kDefaultMaxInFlight)
+          : max_in_flight_(max_in_flight) {
+        pollers = std::max<size_t>(pollers, 1);
+        for (size_t i = 0; i < pollers; ++i) {
+          threads_.emplace_back(&AsyncGrpcClient::asyncCompleteRpc, this);
+        }
+      }
 
       /**
        * Listen to gRPC server responses
@@ -43,20 +88,22 @@ namespace iroha {
         while (cq_.Next(&got_tag, &ok)) {
           auto call = static_cast<AsyncClientCall *>(got_tag);
 
-          delete call;
+          completeCall(call);
         }
       }
 
       ~AsyncGrpcClient() {
         cq_.Shutdown();
-        if (thread_.joinable()) {
-          thread_.join();
+        for (auto &thread : threads_) {
+          if (thread.joinable()) {
+            thread.join();
+          }
+        }
+        for (auto memory : free_calls_) {
+          ::operator delete(memory);
         }
       }
 
-      grpc::CompletionQueue cq_;
-      std::thread thread_;
-
       /**
        * State and data information of gRPC call
        */
@@ -69,8 +116,124 @@ namespace iroha {
 
         std::unique_ptr<grpc::ClientAsyncResponseReader<Response>>
             response_reader;
+
+        /// address of the peer the call is sent to
+        std::string peer;
+
+        /// type of sent message
+        const char *type;
+
+        std::chrono::steady_clock::time_point start;
       };
+
+      /**
+       * Create call object for sending message to the peer
+       * @param peer - address of the peer
+       * @param type - type of the message, string literal
+       * @param droppable - false for messages which must be sent even if
+       * the in-flight limit is reached, they are still counted in flight
+       * @return call object, which is released when call completes;
+       * nullptr if the message is droppable and there are too many calls in
+       * flight to the peer
+       */
+      AsyncClientCall *newCall(const std::string &peer,
+                               const char *type,
+                               bool droppable = true) {
+        void *memory = nullptr;
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          auto &in_flight = in_flight_[peer];
+          if (droppable and in_flight >= max_in_flight_) {
+            ++statistics_[type].dropped;
+            return nullptr;
+          }
+          ++in_flight;
+
+          if (not free_calls_.empty()) {
+            memory = free_calls_.back();
+            free_calls_.pop_back();
+          }
+        }
+
+        if (not memory) {
+          memory = ::operator new(sizeof(AsyncClientCall));
+        }
+        auto call = new (memory) AsyncClientCall;
+        call->peer = peer;
+        call->type = type;
+        call->start = std::chrono::steady_clock::now();
+        return call;
+      }
+
+      /**
+       * @return statistics of completed calls per message type
+       */
+      std::map<std::string, AsyncCallStatistics> statistics() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return statistics_;
+      }
+
+      grpc::CompletionQueue cq_;
+
+     private:
+      /// max number of call objects kept for reuse
+      static const size_t kMaxPooledCalls = 1024;
+
+      /**
+       * Record results of completed call and release call object
+       * @param call - completed call
+       */
+      void completeCall(AsyncClientCall *call) {
+        auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - call->start)
+                           .count();
+        size_t bucket = 0;
+        while (bucket + 1 < AsyncCallStatistics::kLatencyBuckets
+               and latency >= (1ll << bucket)) {
+          ++bucket;
+        }
+        auto failed = not call->status.ok();
+        auto peer = std::move(call->peer);
+        auto type = call->type;
+        call->~AsyncClientCall();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto &statistics = statistics_[type];
+        ++statistics.calls;
+        statistics.failures += failed;
+        ++statistics.latency[bucket];
+
+        auto in_flight = in_flight_.find(peer);
+        if (--in_flight->second == 0) {
+          in_flight_.erase(in_flight);
+        }
+
+        if (free_calls_.size() < kMaxPooledCalls) {
+          free_calls_.push_back(call);
+        } else {
+          ::operator delete(call);
+        }
+      }
+
+      const size_t max_in_flight_;
+
+      mutable std::mutex mutex_;
+      std::unordered_map<std::string, size_t> in_flight_;
+      std::map<std::string, AsyncCallStatistics> statistics_;
+      /// memory of released call objects
+      std::vector<void *> free_calls_;
+
+      std::vector<std::thread> threads_;
     };
+
+    template <typename Response>
+    const size_t AsyncGrpcClient<Response>::kDefaultPollers;
+
+    template <typename Response>
+    const size_t AsyncGrpcClient<Response>::kDefaultMaxInFlight;
+
+    template <typename Response>
+    const size_t AsyncGrpcClient<Response>::kMaxPooledCalls;
   }  // namespace network
 }  // namespace iroha
 
@@ -52,8 +52,8 @@ rxcpp::observable<std::shared_ptr<Block>> BlockLoaderImpl::retrieveBlocks(
   return rxcpp::observable<>::create<std::shared_ptr<Block>>(
       [this, peer_pubkey](auto subscriber) {
         boost::optional<iroha::model::Block> top_block;
+        // block query emits synchronously, so no thread is needed
         block_query_->getTopBlocks(1)
-            .subscribe_on(rxcpp::observe_on_new_thread())
             .as_blocking()
             .subscribe([&top_block](auto block) {
               top_block =
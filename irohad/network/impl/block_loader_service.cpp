@@ -17,12 +17,14 @@
 
 #include "network/impl/block_loader_service.hpp"
 
+#include "backend/protobuf/block.hpp"
 #include "common/byteutils.hpp"
+#include "common/visitor.hpp"
+#include "model/block.hpp"
 
 using namespace iroha;
 using namespace iroha::ametsuchi;
 using namespace iroha::model;
-using namespace iroha::model::converters;
 using namespace iroha::network;
 
 BlockLoaderService::BlockLoaderService(std::shared_ptr<BlockQuery> storage)
@@ -30,17 +32,30 @@ BlockLoaderService::BlockLoaderService(std::shared_ptr<BlockQuery> storage)
   log_ = logger::log("BlockLoaderService");
 }
 
+template <typename Consume>
+void BlockLoaderService::withTransport(
+    const shared_model::interface::Block &block, Consume &&consume) const {
+  if (auto proto_block =
+          dynamic_cast<const shared_model::proto::Block *>(&block)) {
+    consume(proto_block->getTransport());
+    return;
+  }
+  auto transport = factory_.serialize(
+      *std::unique_ptr<iroha::model::Block>(block.makeOldModel()));
+  consume(std::move(transport));
+}
+
 grpc::Status BlockLoaderService::retrieveBlocks(
     ::grpc::ServerContext *context,
     const proto::BlocksRequest *request,
     ::grpc::ServerWriter<::iroha::protocol::Block> *writer) {
   storage_->getBlocksFrom(request->height())
-      .map([this](auto block) {
-        return factory_.serialize(
-            *std::unique_ptr<iroha::model::Block>(block->makeOldModel()));
-      })
       .as_blocking()
-      .subscribe([writer](auto block) { writer->Write(block); });
+      .subscribe([this, writer](auto block) {
+        this->withTransport(*block, [writer](const auto &transport) {
+          writer->Write(transport);
+        });
+      });
   return grpc::Status::OK;
 }
 
@@ -56,22 +71,21 @@ grpc::Status BlockLoaderService::retrieveBlock(
                         "Bad hash provided");
   }
 
-  boost::optional<protocol::Block> result;
-  storage_->getBlocksFrom(1)
-      .filter([hash](auto block) {
-        return shared_model::crypto::toBinaryString(block->hash())
-            == hash->to_string();
-      })
-      .map([this](auto block) {
-        return factory_.serialize(
-            *std::unique_ptr<iroha::model::Block>(block->makeOldModel()));
-      })
-      .as_blocking()
-      .subscribe([&result](auto block) { result = block; });
-  if (not result) {
+  auto block = storage_->getBlockByHashSync(
+      shared_model::crypto::Hash(request->hash()));
+  if (not block) {
     log_->info("Cannot find block with requested hash");
     return grpc::Status(grpc::StatusCode::NOT_FOUND, "Block not found");
   }
-  response->CopyFrom(result.value());
+  // converted block is moved to response, while the block shared with cache
+  // of block query is copied once, since response is owned by grpc
+  withTransport(**block,
+                make_visitor(
+                    [response](const protocol::Block &transport) {
+                      response->CopyFrom(transport);
+                    },
+                    [response](protocol::Block &&transport) {
+                      response->Swap(&transport);
+                    }));
   return grpc::Status::OK;
 }
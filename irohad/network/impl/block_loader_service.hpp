@@ -40,6 +40,17 @@ namespace iroha {
                                  protocol::Block *response) override;
 
      private:
+      /**
+       * Pass protobuf transport of block to consumer without copying it.
+       * Blocks which are not backed by protobuf are converted through the
+       * old model
+       * @param block - block to send
+       * @param consume - function which takes transport of block
+       */
+      template <typename Consume>
+      void withTransport(const shared_model::interface::Block &block,
+                         Consume &&consume) const;
+
       model::converters::PbBlockFactory factory_;
       std::shared_ptr<ametsuchi::BlockQuery> storage_;
       logger::Logger log_;
@@ -34,6 +34,13 @@ namespace iroha {
       ordering_gate_->propagateTransaction(transaction);
     }
 
+    void PeerCommunicationServiceImpl::propagate_batch(
+        std::vector<std::shared_ptr<const shared_model::interface::Transaction>>
+            transactions) {
+      log_->info("propagate batch of {} txs", transactions.size());
+      ordering_gate_->propagateBatch(std::move(transactions));
+    }
+
     rxcpp::observable<std::shared_ptr<shared_model::interface::Proposal>>
     PeerCommunicationServiceImpl::on_proposal() const {
       return ordering_gate_->on_proposal();
@@ -36,6 +36,11 @@ namespace iroha {
           std::shared_ptr<const shared_model::interface::Transaction>
               transaction) override;
 
+      void propagate_batch(
+          std::vector<
+              std::shared_ptr<const shared_model::interface::Transaction>>
+              transactions) override;
+
       rxcpp::observable<std::shared_ptr<shared_model::interface::Proposal>>
       on_proposal() const override;
 
@@ -44,6 +44,15 @@ namespace iroha {
           std::shared_ptr<const shared_model::interface::Transaction>
               transaction) = 0;
 
+      /**
+       * Propagate signed transactions for further processing as a single unit
+       * @param transactions
+       */
+      virtual void propagateBatch(
+          std::vector<
+              std::shared_ptr<const shared_model::interface::Transaction>>
+              transactions) = 0;
+
       /**
        * Return observable of all proposals in the consensus
        * @return observable with notifications
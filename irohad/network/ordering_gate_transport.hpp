@@ -18,6 +18,7 @@
 #define IROHA_ORDERING_GATE_TRANSPORT_H
 
 #include <memory>
+#include <vector>
 
 namespace shared_model {
   namespace interface {
@@ -68,6 +69,15 @@ namespace iroha {
           std::shared_ptr<const shared_model::interface::Transaction>
               transaction) = 0;
 
+      /**
+       * Propagates transactions over network as a single unit
+       * @param transactions : transactions to be propagated
+       */
+      virtual void propagateBatch(
+          std::vector<
+              std::shared_ptr<const shared_model::interface::Transaction>>
+              transactions) = 0;
+
       virtual ~OrderingGateTransport() = default;
     };
 
@@ -18,6 +18,7 @@
 #define IROHA_ORDERING_SERVICE_TRANSPORT_H
 
 #include <memory>
+#include <vector>
 #include "interfaces/iroha_internal/proposal.hpp"
 #include "interfaces/transaction.hpp"
 
@@ -38,6 +39,14 @@ namespace iroha {
           std::shared_ptr<shared_model::interface::Transaction>
               transaction) = 0;
 
+      /**
+       * Callback on receiving batch of transactions
+       * @param batch - transactions, in the order they were sent
+       */
+      virtual void onBatch(
+          std::vector<std::shared_ptr<shared_model::interface::Transaction>>
+              batch) = 0;
+
       virtual ~OrderingServiceNotification() = default;
     };
 
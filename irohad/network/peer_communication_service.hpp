@@ -19,6 +19,7 @@
 #define IROHA_PEER_COMMUNICATION_SERVICE_HPP
 
 #include <rxcpp/rx.hpp>
+#include <vector>
 
 namespace shared_model {
   namespace interface {
@@ -48,6 +49,15 @@ namespace iroha {
           std::shared_ptr<const shared_model::interface::Transaction>
               transaction) = 0;
 
+      /**
+       * Propagate transactions in network as a single unit
+       * @param transactions - objects for propagation
+       */
+      virtual void propagate_batch(
+          std::vector<
+              std::shared_ptr<const shared_model::interface::Transaction>>
+              transactions) = 0;
+
       /**
        * Event is triggered when proposal arrives from network.
        * @return observable with Proposals.
@@ -0,0 +1,128 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ordering/impl/adaptive_batching_policy.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+  /**
+   * Make bounds consistent: proposal has at least one transaction, upper
+   * bounds are not less than lower ones
+   */
+  iroha::ordering::AdaptiveBatchingPolicy::Bounds normalize(
+      iroha::ordering::AdaptiveBatchingPolicy::Bounds bounds) {
+    bounds.min_size = std::max<size_t>(bounds.min_size, 1);
+    bounds.max_size = std::max(bounds.max_size, bounds.min_size);
+    bounds.max_delay = std::max(bounds.max_delay, bounds.min_delay);
+    return bounds;
+  }
+}  // namespace
+
+namespace iroha {
+  namespace ordering {
+
+    constexpr double AdaptiveBatchingPolicy::kSmoothing;
+    constexpr size_t AdaptiveBatchingPolicy::kMaxPendingProposals;
+
+    AdaptiveBatchingPolicy::AdaptiveBatchingPolicy(Bounds bounds,
+                                                   Clock::time_point now)
+        : bounds_(normalize(bounds)),
+          arrived_(0),
+          last_sample_(now),
+          arrival_rate_(0),
+          commit_latency_(0) {
+      update();
+    }
+
+    void AdaptiveBatchingPolicy::onTransactions(size_t count) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      arrived_ += count;
+    }
+
+    void AdaptiveBatchingPolicy::sample(Clock::time_point now) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto elapsed =
+          std::chrono::duration<double, std::milli>(now - last_sample_).count();
+      if (elapsed <= 0) {
+        return;
+      }
+      arrival_rate_ = kSmoothing * (arrived_ / elapsed)
+          + (1 - kSmoothing) * arrival_rate_;
+      arrived_ = 0;
+      last_sample_ = now;
+      update();
+    }
+
+    void AdaptiveBatchingPolicy::onPublish(Clock::time_point now) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      published_.push_back(now);
+      // commits may be not reported, so keep only the recent proposals
+      if (published_.size() > kMaxPendingProposals) {
+        published_.pop_front();
+      }
+    }
+
+    void AdaptiveBatchingPolicy::onCommit(Clock::time_point now) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (published_.empty()) {
+        return;
+      }
+      auto latency = std::chrono::duration<double, std::milli>(
+                         now - published_.front())
+                         .count();
+      published_.pop_front();
+      commit_latency_ =
+          kSmoothing * latency + (1 - kSmoothing) * commit_latency_;
+      update();
+    }
+
+    size_t AdaptiveBatchingPolicy::proposalSize() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return proposal_size_;
+    }
+
+    std::chrono::milliseconds AdaptiveBatchingPolicy::proposalDelay() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return proposal_delay_;
+    }
+
+    const AdaptiveBatchingPolicy::Bounds &AdaptiveBatchingPolicy::bounds()
+        const {
+      return bounds_;
+    }
+
+    void AdaptiveBatchingPolicy::update() {
+      // transactions which arrive while the previous proposal is committed
+      auto size = std::round(arrival_rate_ * commit_latency_);
+      size = std::min<double>(std::max<double>(size, bounds_.min_size),
+                              bounds_.max_size);
+      proposal_size_ = static_cast<size_t>(size);
+
+      // time to collect the proposal
+      auto max_delay = static_cast<double>(bounds_.max_delay.count());
+      auto delay = arrival_rate_ > 0
+          ? std::min(std::round(proposal_size_ / arrival_rate_), max_delay)
+          : max_delay;
+      proposal_delay_ = std::max(
+          std::chrono::milliseconds(static_cast<long long>(delay)),
+          bounds_.min_delay);
+    }
+
+  }  // namespace ordering
+}  // namespace iroha
@@ -0,0 +1,132 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_ADAPTIVE_BATCHING_POLICY_HPP
+#define IROHA_ADAPTIVE_BATCHING_POLICY_HPP
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+
+namespace iroha {
+  namespace ordering {
+
+    /**
+     * Chooses proposal size and delay of ordering service from observed
+     * transaction arrival rate and commit latency.
+     *
+     * Proposal size is the number of transactions which arrive during one
+     * commit, so at low load proposals are emitted as soon as transactions
+     * arrive, and at high load proposals are full. Delay is the time needed
+     * to collect proposal of that size. Both are kept within bounds; equal
+     * lower and upper bounds give fixed size and delay
+     */
+    class AdaptiveBatchingPolicy {
+     public:
+      using Clock = std::chrono::steady_clock;
+
+      /**
+       * Bounds of proposal size and delay
+       */
+      struct Bounds {
+        size_t min_size;
+        size_t max_size;
+        std::chrono::milliseconds min_delay;
+        std::chrono::milliseconds max_delay;
+      };
+
+      /**
+       * @param bounds - bounds of proposal size and delay
+       * @param now - start of the first observation period
+       */
+      explicit AdaptiveBatchingPolicy(Bounds bounds,
+                                      Clock::time_point now = Clock::now());
+
+      /**
+       * Record arrival of transactions
+       * @param count - number of transactions
+       */
+      void onTransactions(size_t count);
+
+      /**
+       * Update arrival rate with transactions arrived since previous sample
+       * @param now - time of the sample
+       */
+      void sample(Clock::time_point now = Clock::now());
+
+      /**
+       * Record publication of proposal
+       * @param now - time of publication
+       */
+      void onPublish(Clock::time_point now = Clock::now());
+
+      /**
+       * Record commit of the oldest published proposal
+       * @param now - time of commit
+       */
+      void onCommit(Clock::time_point now = Clock::now());
+
+      /**
+       * @return current proposal size
+       */
+      size_t proposalSize() const;
+
+      /**
+       * @return current proposal delay
+       */
+      std::chrono::milliseconds proposalDelay() const;
+
+      /**
+       * @return bounds of the policy
+       */
+      const Bounds &bounds() const;
+
+     private:
+      /**
+       * Recompute proposal size and delay from estimations
+       * Lock on mutex_ must be held
+       */
+      void update();
+
+      /// weight of new observation in moving averages
+      static constexpr double kSmoothing = 0.3;
+      /// max number of published proposals awaiting commit
+      static constexpr size_t kMaxPendingProposals = 16;
+
+      const Bounds bounds_;
+
+      /// transactions arrived since the last sample
+      size_t arrived_;
+      Clock::time_point last_sample_;
+      /// publication time of proposals which are not committed yet
+      std::deque<Clock::time_point> published_;
+
+      /// estimated arrival rate, transactions per millisecond
+      double arrival_rate_;
+      /// estimated commit latency, milliseconds
+      double commit_latency_;
+
+      size_t proposal_size_;
+      std::chrono::milliseconds proposal_delay_;
+
+      mutable std::mutex mutex_;
+    };
+
+  }  // namespace ordering
+}  // namespace iroha
+
+#endif  // IROHA_ADAPTIVE_BATCHING_POLICY_HPP
@@ -24,8 +24,11 @@ namespace iroha {
   namespace ordering {
 
     OrderingGateImpl::OrderingGateImpl(
-        std::shared_ptr<iroha::network::OrderingGateTransport> transport)
-        : transport_(std::move(transport)), log_(logger::log("OrderingGate")) {}
+        std::shared_ptr<iroha::network::OrderingGateTransport> transport,
+        bool pipelined)
+        : transport_(std::move(transport)),
+          max_rounds_in_flight_(pipelined ? 2 : 1),
+          log_(logger::log("OrderingGate")) {}
 
     void OrderingGateImpl::propagateTransaction(
         std::shared_ptr<const shared_model::interface::Transaction>
@@ -37,6 +40,14 @@ namespace iroha {
       transport_->propagateTransaction(transaction);
     }
 
+    void OrderingGateImpl::propagateBatch(
+        std::vector<std::shared_ptr<const shared_model::interface::Transaction>>
+            transactions) {
+      log_->info("propagate batch of {} txs", transactions.size());
+
+      transport_->propagateBatch(std::move(transactions));
+    }
+
     rxcpp::observable<std::shared_ptr<shared_model::interface::Proposal>>
     OrderingGateImpl::on_proposal() {
       return proposals_.get_observable();
@@ -47,7 +58,7 @@ namespace iroha {
       pcs_subscriber_ = pcs.on_commit().subscribe([this](auto) {
         // TODO: 05/03/2018 @muratovv rework behavior of queue with respect to
         // block height IR-1042
-        unlock_next_.store(true);
+        this->finishRound();
         this->tryNextRound();
 
       });
@@ -61,14 +72,37 @@ namespace iroha {
     }
 
     void OrderingGateImpl::tryNextRound() {
-      if (not proposal_queue_.empty() and unlock_next_.exchange(false)) {
+      while (not proposal_queue_.empty() and startRound()) {
         std::shared_ptr<shared_model::interface::Proposal> next_proposal;
-        proposal_queue_.try_pop(next_proposal);
+        if (not proposal_queue_.try_pop(next_proposal)) {
+          // the proposal was taken by a concurrent call
+          finishRound();
+          return;
+        }
         log_->info("Pass the proposal to pipeline");
         proposals_.get_subscriber().on_next(next_proposal);
       }
     }
 
+    bool OrderingGateImpl::startRound() {
+      auto rounds = rounds_in_flight_.load();
+      do {
+        if (rounds >= max_rounds_in_flight_) {
+          return false;
+        }
+      } while (not rounds_in_flight_.compare_exchange_weak(rounds, rounds + 1));
+      return true;
+    }
+
+    void OrderingGateImpl::finishRound() {
+      auto rounds = rounds_in_flight_.load();
+      do {
+        if (rounds == 0) {
+          return;
+        }
+      } while (not rounds_in_flight_.compare_exchange_weak(rounds, rounds - 1));
+    }
+
     OrderingGateImpl::~OrderingGateImpl() {
       pcs_subscriber_.unsubscribe();
     }
@@ -42,17 +42,31 @@ namespace iroha {
      * Interacts with given OrderingService
      * by propagating transactions and receiving proposals
      * @param server_address OrderingService address
+     *
+     * In pipelined mode the next proposal is passed to the pipeline before
+     * the previous one is committed, so it can be validated while the
+     * previous block is voted for and committed
      */
     class OrderingGateImpl : public network::OrderingGate,
                              public network::OrderingGateNotification {
      public:
+      /**
+       * @param transport - transport to ordering service
+       * @param pipelined - allow two rounds in flight instead of one
+       */
       explicit OrderingGateImpl(
-          std::shared_ptr<iroha::network::OrderingGateTransport> transport);
+          std::shared_ptr<iroha::network::OrderingGateTransport> transport,
+          bool pipelined = false);
 
       void propagateTransaction(
           std::shared_ptr<const shared_model::interface::Transaction>
               transaction) override;
 
+      void propagateBatch(
+          std::vector<
+              std::shared_ptr<const shared_model::interface::Transaction>>
+              transactions) override;
+
       rxcpp::observable<std::shared_ptr<shared_model::interface::Proposal>>
       on_proposal() override;
 
@@ -69,13 +83,28 @@ namespace iroha {
        */
       void tryNextRound();
 
+      /**
+       * Occupy a slot for new round
+       * @return true if the number of rounds in flight allows new round
+       */
+      bool startRound();
+
+      /**
+       * Free a slot occupied by committed round
+       */
+      void finishRound();
+
       rxcpp::subjects::subject<
           std::shared_ptr<shared_model::interface::Proposal>>
           proposals_;
       std::shared_ptr<iroha::network::OrderingGateTransport> transport_;
 
-      /// invariant: true if proposal can be pushed to subscribers
-      std::atomic_bool unlock_next_{true};
+      /// max number of proposals passed to the pipeline and not committed
+      const size_t max_rounds_in_flight_;
+
+      /// invariant: proposal can be pushed to subscribers if the number of
+      /// rounds in flight is less than max_rounds_in_flight_
+      std::atomic<size_t> rounds_in_flight_{0};
 
       /// queue with all proposals received from ordering service
       tbb::concurrent_queue<std::shared_ptr<shared_model::interface::Proposal>>
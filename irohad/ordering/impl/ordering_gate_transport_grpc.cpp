@@ -16,6 +16,8 @@
  */
 #include "ordering_gate_transport_grpc.hpp"
 
+#include <algorithm>
+
 #include "backend/protobuf/transaction.hpp"
 #include "builders/protobuf/proposal.hpp"
 #include "interfaces/common_objects/types.hpp"
@@ -50,24 +52,98 @@ grpc::Status OrderingGateTransportGrpc::onProposal(
   return grpc::Status::OK;
 }
 
+const size_t OrderingGateTransportGrpc::kDefaultMaxBatchSize;
+constexpr std::chrono::milliseconds
+    OrderingGateTransportGrpc::kDefaultFlushDelay;
+
 OrderingGateTransportGrpc::OrderingGateTransportGrpc(
-    const std::string &server_address)
+    const std::string &server_address,
+    size_t max_batch_size,
+    std::chrono::milliseconds flush_delay,
+    std::shared_ptr<iroha::timer::TimerWheel> timer_wheel)
     : client_(proto::OrderingServiceTransportGrpc::NewStub(grpc::CreateChannel(
           server_address, grpc::InsecureChannelCredentials()))),
+      server_address_(server_address),
+      max_batch_size_(std::max<size_t>(max_batch_size, 1)),
+      flush_delay_(flush_delay),
+      timer_wheel_(std::move(timer_wheel)),
+      flush_timer_(iroha::timer::TimerWheel::kNoTimer),
+      is_finished_(false),
       log_(logger::log("OrderingGate")) {}
 
 void OrderingGateTransportGrpc::propagateTransaction(
     std::shared_ptr<const shared_model::interface::Transaction> transaction) {
   log_->info("Propagate tx (on transport)");
-  auto call = new AsyncClientCall;
+  std::lock_guard<std::mutex> lock(batch_mutex_);
+  if (is_finished_) {
+    return;
+  }
+
+  bufferTransaction(*transaction);
+  if (static_cast<size_t>(batch_.transactions_size()) >= max_batch_size_) {
+    flush();
+  } else if (flush_timer_ == iroha::timer::TimerWheel::kNoTimer) {
+    // first transaction of the batch starts the timer
+    flush_timer_ = timer_wheel_->schedule(flush_delay_, [this] {
+      std::lock_guard<std::mutex> lock(batch_mutex_);
+      flush_timer_ = iroha::timer::TimerWheel::kNoTimer;
+      if (not is_finished_) {
+        this->flush();
+      }
+    });
+  }
+}
+
+void OrderingGateTransportGrpc::propagateBatch(
+    std::vector<std::shared_ptr<const shared_model::interface::Transaction>>
+        transactions) {
+  log_->info("Propagate batch of {} txs (on transport)", transactions.size());
+  std::lock_guard<std::mutex> lock(batch_mutex_);
+  if (is_finished_) {
+    return;
+  }
+
+  // the batch is already coalesced by the caller, so it is sent at once
+  // together with the pending transactions
+  for (const auto &transaction : transactions) {
+    bufferTransaction(*transaction);
+    if (static_cast<size_t>(batch_.transactions_size()) >= max_batch_size_) {
+      flush();
+    }
+  }
+  flush();
+}
 
-  auto transaction_transport =
-      static_cast<const shared_model::proto::Transaction &>(*transaction)
+void OrderingGateTransportGrpc::bufferTransaction(
+    const shared_model::interface::Transaction &transaction) {
+  *batch_.add_transactions() =
+      static_cast<const shared_model::proto::Transaction &>(transaction)
           .getTransport();
-  call->response_reader =
-      client_->AsynconTransaction(&call->context, transaction_transport, &cq_);
+}
+
+void OrderingGateTransportGrpc::flush() {
+  // timer which is already running resets itself after the lock is released
+  if (flush_timer_ != iroha::timer::TimerWheel::kNoTimer
+      and timer_wheel_->cancel(flush_timer_)) {
+    flush_timer_ = iroha::timer::TimerWheel::kNoTimer;
+  }
+  if (batch_.transactions_size() == 0) {
+    return;
+  }
+
+  log_->info("Send batch of {} txs", batch_.transactions_size());
+  auto call = newCall(server_address_, "batch");
+  if (not call) {
+    log_->warn("Too many calls in flight to ordering service, {} txs dropped",
+               batch_.transactions_size());
+    batch_.Clear();
+    return;
+  }
+
+  call->response_reader = client_->AsynconBatch(&call->context, batch_, &cq_);
 
   call->response_reader->Finish(&call->reply, &call->status, call);
+  batch_.Clear();
 }
 
 void OrderingGateTransportGrpc::subscribe(
@@ -75,3 +151,16 @@ void OrderingGateTransportGrpc::subscribe(
   log_->info("Subscribe");
   subscriber_ = subscriber;
 }
+
+OrderingGateTransportGrpc::~OrderingGateTransportGrpc() {
+  iroha::timer::TimerWheel::TimerId timer;
+  {
+    std::lock_guard<std::mutex> lock(batch_mutex_);
+    is_finished_ = true;
+    // do not lose buffered transactions
+    flush();
+    timer = flush_timer_;
+  }
+  // running timer waits for the lock, so it is not held here
+  timer_wheel_->cancelAndWait(timer);
+}
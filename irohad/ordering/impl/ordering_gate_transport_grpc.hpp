@@ -18,11 +18,14 @@
 #define IROHA_ORDERING_GATE_TRANSPORT_GRPC_H
 
 #include <google/protobuf/empty.pb.h>
+#include <chrono>
+#include <mutex>
 
 #include "logger/logger.hpp"
 #include "network/impl/async_grpc_client.hpp"
 #include "network/ordering_gate_transport.hpp"
 #include "ordering.grpc.pb.h"
+#include "timer/timer_wheel.hpp"
 
 namespace shared_model {
   namespace interface {
@@ -32,12 +35,38 @@ namespace shared_model {
 
 namespace iroha {
   namespace ordering {
+    /**
+     * Ordering gate transport which coalesces outgoing transactions into
+     * batches. A batch is sent to the ordering service with single onBatch
+     * call when it reaches max_batch_size transactions, or when flush_delay
+     * has passed since the first transaction of the batch was buffered
+     */
     class OrderingGateTransportGrpc
         : public iroha::network::OrderingGateTransport,
           public proto::OrderingGateTransportGrpc::Service,
           private network::AsyncGrpcClient<google::protobuf::Empty> {
      public:
-      explicit OrderingGateTransportGrpc(const std::string &server_address);
+      /// default max number of transactions in a batch
+      static const size_t kDefaultMaxBatchSize = 100;
+      /// default max time a transaction is buffered before sending
+      static constexpr std::chrono::milliseconds kDefaultFlushDelay =
+          std::chrono::milliseconds(10);
+
+      /**
+       * @param server_address - address of the ordering service
+       * @param max_batch_size - batch is sent as soon as it has this number
+       * of transactions
+       * @param flush_delay - non-empty batch is sent after this delay
+       * @param timer_wheel - timer wheel for flush timer
+       */
+      explicit OrderingGateTransportGrpc(
+          const std::string &server_address,
+          size_t max_batch_size = kDefaultMaxBatchSize,
+          std::chrono::milliseconds flush_delay = kDefaultFlushDelay,
+          std::shared_ptr<timer::TimerWheel> timer_wheel =
+              timer::defaultTimerWheel());
+
+      using network::AsyncGrpcClient<google::protobuf::Empty>::statistics;
 
       grpc::Status onProposal(::grpc::ServerContext *context,
                               const protocol::Proposal *request,
@@ -47,12 +76,57 @@ namespace iroha {
           std::shared_ptr<const shared_model::interface::Transaction>
               transaction) override;
 
+      void propagateBatch(
+          std::vector<
+              std::shared_ptr<const shared_model::interface::Transaction>>
+              transactions) override;
+
       void subscribe(std::shared_ptr<iroha::network::OrderingGateNotification>
                          subscriber) override;
 
+      ~OrderingGateTransportGrpc() override;
+
      private:
+      /**
+       * Add transaction to the pending batch
+       * Lock on batch_mutex_ must be held
+       * @param transaction - transaction to be sent
+       */
+      void bufferTransaction(
+          const shared_model::interface::Transaction &transaction);
+
+      /**
+       * Send pending batch to the ordering service
+       * Lock on batch_mutex_ must be held
+       */
+      void flush();
+
       std::weak_ptr<iroha::network::OrderingGateNotification> subscriber_;
       std::unique_ptr<proto::OrderingServiceTransportGrpc::Stub> client_;
+      const std::string server_address_;
+
+      const size_t max_batch_size_;
+      const std::chrono::milliseconds flush_delay_;
+
+      /**
+       * Transactions waiting to be sent
+       */
+      proto::TxBatch batch_;
+
+      std::shared_ptr<timer::TimerWheel> timer_wheel_;
+
+      /**
+       * Timer which flushes the pending batch, it is reset when the timer
+       * is cancelled or finished
+       */
+      timer::TimerWheel::TimerId flush_timer_;
+
+      /**
+       * Set after destruction
+       */
+      bool is_finished_;
+
+      std::mutex batch_mutex_;
       logger::Logger log_;
     };
 
@@ -33,29 +33,102 @@ namespace iroha {
         size_t delay_milliseconds,
         std::shared_ptr<network::OrderingServiceTransport> transport,
         std::shared_ptr<ametsuchi::OrderingServicePersistentState>
-            persistent_state)
+            persistent_state,
+        std::shared_ptr<timer::TimerWheel> timer_wheel)
+        : OrderingServiceImpl(
+              wsv,
+              {max_size,
+               max_size,
+               std::chrono::milliseconds(delay_milliseconds),
+               std::chrono::milliseconds(delay_milliseconds)},
+              transport,
+              persistent_state,
+              std::move(timer_wheel)) {}
+
+    OrderingServiceImpl::OrderingServiceImpl(
+        std::shared_ptr<ametsuchi::PeerQuery> wsv,
+        AdaptiveBatchingPolicy::Bounds bounds,
+        std::shared_ptr<network::OrderingServiceTransport> transport,
+        std::shared_ptr<ametsuchi::OrderingServicePersistentState>
+            persistent_state,
+        std::shared_ptr<timer::TimerWheel> timer_wheel)
         : wsv_(wsv),
-          max_size_(max_size),
-          delay_milliseconds_(delay_milliseconds),
+          policy_(bounds),
           transport_(transport),
           persistent_state_(persistent_state),
+          timer_wheel_(std::move(timer_wheel)),
+          timer_(timer::TimerWheel::kNoTimer),
           is_finished(false) {
-      updateTimer();
       log_ = logger::log("OrderingServiceImpl");
 
       // restore state of ordering service from persistent storage
       proposal_height = persistent_state_->loadProposalHeight().value();
+
+      std::lock_guard<std::mutex> lock(m);
+      scheduleTimer();
     }
 
     void OrderingServiceImpl::onTransaction(
         std::shared_ptr<shared_model::interface::Transaction> transaction) {
       queue_.push(transaction);
+      policy_.onTransactions(1);
       log_->info("Queue size is {}", queue_.unsafe_size());
 
-      if (queue_.unsafe_size() >= max_size_) {
-        handle.unsubscribe();
-        updateTimer();
+      checkQueueSize();
+    }
+
+    void OrderingServiceImpl::onBatch(
+        std::vector<std::shared_ptr<shared_model::interface::Transaction>>
+            batch) {
+      for (auto &transaction : batch) {
+        queue_.push(std::move(transaction));
       }
+      policy_.onTransactions(batch.size());
+      log_->info("Batch of {} txs enqueued, queue size is {}",
+                 batch.size(),
+                 queue_.unsafe_size());
+
+      checkQueueSize();
+    }
+
+    void OrderingServiceImpl::onCommit() {
+      policy_.onCommit();
+    }
+
+    void OrderingServiceImpl::checkQueueSize() {
+      if (queue_.unsafe_size() >= policy_.proposalSize()) {
+        std::lock_guard<std::mutex> lock(m);
+        if (not is_finished) {
+          generateFullProposals();
+        }
+      }
+    }
+
+    void OrderingServiceImpl::generateFullProposals() {
+      // the queue may have enough transactions for several proposals
+      while (queue_.unsafe_size() >= policy_.proposalSize()) {
+        this->generateProposal();
+      }
+    }
+
+    void OrderingServiceImpl::onTimer() {
+      std::lock_guard<std::mutex> lock(m);
+      if (is_finished) {
+        return;
+      }
+      policy_.sample();
+      if (not queue_.empty()) {
+        this->generateProposal();
+      }
+      generateFullProposals();
+      scheduleTimer();
+    }
+
+    void OrderingServiceImpl::scheduleTimer() {
+      // empty queue has nothing to wait for, except arrival rate sampling
+      auto delay = queue_.empty() ? policy_.bounds().max_delay
+                                  : policy_.proposalDelay();
+      timer_ = timer_wheel_->schedule(delay, [this] { this->onTimer(); });
     }
 
     void OrderingServiceImpl::generateProposal() {
@@ -65,8 +138,9 @@ namespace iroha {
       proto_proposal.set_height(proposal_height++);
       proto_proposal.set_created_time(iroha::time::now());
       log_->info("Start proposal generation");
+      const auto max_size = policy_.proposalSize();
       for (std::shared_ptr<shared_model::interface::Transaction> tx;
-           static_cast<size_t>(proto_proposal.transactions_size()) < max_size_
+           static_cast<size_t>(proto_proposal.transactions_size()) < max_size
            and queue_.try_pop(tx);) {
         *proto_proposal.add_transactions() = std::move(
             std::static_pointer_cast<shared_model::proto::Transaction>(tx)
@@ -80,6 +154,7 @@ namespace iroha {
       // In case of restart it reloads state.
       if (persistent_state_->saveProposalHeight(proposal_height)) {
         publishProposal(std::move(proposal));
+        policy_.onPublish();
       } else {
         // TODO(@l4l) 23/03/18: publish proposal independant of psql status
         // IR-1162
@@ -103,24 +178,15 @@ namespace iroha {
       }
     }
 
-    void OrderingServiceImpl::updateTimer() {
-      std::lock_guard<std::mutex> lock(m);
-      if (is_finished) {
-        return;
-      }
-      if (not queue_.empty()) {
-        this->generateProposal();
-      }
-      timer = rxcpp::observable<>::timer(
-          std::chrono::milliseconds(delay_milliseconds_));
-      handle = timer.subscribe_on(rxcpp::observe_on_new_thread())
-                   .subscribe([this](auto) { this->updateTimer(); });
-    }
-
     OrderingServiceImpl::~OrderingServiceImpl() {
-      std::lock_guard<std::mutex> lock(m);
-      is_finished = true;
-      handle.unsubscribe();
+      timer::TimerWheel::TimerId timer;
+      {
+        std::lock_guard<std::mutex> lock(m);
+        is_finished = true;
+        timer = timer_;
+      }
+      // running timer may wait for the lock, so it is not held here
+      timer_wheel_->cancelAndWait(timer);
     }
   }  // namespace ordering
 }  // namespace iroha
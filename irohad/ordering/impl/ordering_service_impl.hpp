@@ -21,11 +21,12 @@
 #include <tbb/concurrent_queue.h>
 #include <memory>
 #include <mutex>
-#include <rxcpp/rx.hpp>
 
 #include "logger/logger.hpp"
 #include "network/ordering_service.hpp"
 #include "ordering.grpc.pb.h"
+#include "ordering/impl/adaptive_batching_policy.hpp"
+#include "timer/timer_wheel.hpp"
 
 namespace iroha {
 
@@ -41,11 +42,14 @@ namespace iroha {
      * OrderingService implementation with gRPC synchronous server
      * Allows receiving transactions concurrently from multiple peers by using
      * concurrent queue
-     * Sends proposal by given timer interval and proposal size
+     * Sends proposal by given timer interval and proposal size, which are
+     * fixed or adapted to the load by AdaptiveBatchingPolicy
+     * Proposal timer runs on the shared timer wheel
      * @param delay_milliseconds timer delay
      * @param max_size proposal size
      * @param persistent_state - storage for persistent state of ordering
      * service
+     * @param timer_wheel - timer wheel for proposal timer
      */
     class OrderingServiceImpl : public network::OrderingService {
      public:
@@ -55,7 +59,26 @@ namespace iroha {
           size_t delay_milliseconds,
           std::shared_ptr<network::OrderingServiceTransport> transport,
           std::shared_ptr<ametsuchi::OrderingServicePersistentState>
-              persistent_state);
+              persistent_state,
+          std::shared_ptr<timer::TimerWheel> timer_wheel =
+              timer::defaultTimerWheel());
+
+      /**
+       * @param wsv - peer query
+       * @param bounds - bounds of adaptive proposal size and delay
+       * @param transport - transport to ordering gates
+       * @param persistent_state - storage for persistent state of ordering
+       * service
+       * @param timer_wheel - timer wheel for proposal timer
+       */
+      OrderingServiceImpl(
+          std::shared_ptr<ametsuchi::PeerQuery> wsv,
+          AdaptiveBatchingPolicy::Bounds bounds,
+          std::shared_ptr<network::OrderingServiceTransport> transport,
+          std::shared_ptr<ametsuchi::OrderingServicePersistentState>
+              persistent_state,
+          std::shared_ptr<timer::TimerWheel> timer_wheel =
+              timer::defaultTimerWheel());
 
       /**
        * Process transaction received from network
@@ -65,6 +88,21 @@ namespace iroha {
       void onTransaction(std::shared_ptr<shared_model::interface::Transaction>
                              transaction) override;
 
+      /**
+       * Process batch of transactions received from network
+       * Enqueues all transactions and publishes corresponding event once
+       * @param batch
+       */
+      void onBatch(
+          std::vector<std::shared_ptr<shared_model::interface::Transaction>>
+              batch) override;
+
+      /**
+       * Record commit of a published proposal, which is used to estimate
+       * commit latency
+       */
+      void onCommit();
+
       ~OrderingServiceImpl() override;
 
      protected:
@@ -87,12 +125,27 @@ namespace iroha {
        */
 
       /**
-       * Update the timer to be called after delay_milliseconds_
+       * Generate proposals if the queue has enough transactions
+       */
+      void checkQueueSize();
+
+      /**
+       * Generate proposals while the queue has enough transactions
+       * Lock on m must be held
+       */
+      void generateFullProposals();
+
+      /**
+       * Generate proposal when its delay expires, and schedule the next one
+       */
+      void onTimer();
+
+      /**
+       * Schedule proposal timer
+       * Lock on m must be held
        */
-      void updateTimer();
+      void scheduleTimer();
 
-      rxcpp::observable<long> timer;
-      rxcpp::composite_subscription handle;
       std::shared_ptr<ametsuchi::PeerQuery> wsv_;
 
       tbb::concurrent_queue<
@@ -100,14 +153,10 @@ namespace iroha {
           queue_;
 
       /**
-       * max number of txs in proposal
+       * Chooses number of txs in proposal and delay between proposals
        */
-      const size_t max_size_;
+      AdaptiveBatchingPolicy policy_;
 
-      /**
-       *  wait for specified time if queue is empty
-       */
-      const size_t delay_milliseconds_;
       std::shared_ptr<network::OrderingServiceTransport> transport_;
 
       /**
@@ -129,6 +178,13 @@ namespace iroha {
        */
       std::mutex m;
 
+      std::shared_ptr<timer::TimerWheel> timer_wheel_;
+
+      /**
+       * Pending proposal timer
+       */
+      timer::TimerWheel::TimerId timer_;
+
       /**
        * Set after destruction
        */
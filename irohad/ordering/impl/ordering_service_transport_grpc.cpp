@@ -41,28 +41,99 @@ grpc::Status OrderingServiceTransportGrpc::onTransaction(
   return ::grpc::Status::OK;
 }
 
+grpc::Status OrderingServiceTransportGrpc::onBatch(
+    ::grpc::ServerContext *context,
+    const proto::TxBatch *request,
+    ::google::protobuf::Empty *response) {
+  if (subscriber_.expired()) {
+    log_->error("No subscriber");
+  } else {
+    std::vector<std::shared_ptr<shared_model::interface::Transaction>> batch;
+    batch.reserve(request->transactions_size());
+    for (const auto &tx : request->transactions()) {
+      batch.push_back(std::make_shared<shared_model::proto::Transaction>(
+          iroha::protocol::Transaction(tx)));
+    }
+    subscriber_.lock()->onBatch(std::move(batch));
+  }
+
+  return ::grpc::Status::OK;
+}
+
 void OrderingServiceTransportGrpc::publishProposal(
     std::unique_ptr<shared_model::interface::Proposal> proposal,
     const std::vector<std::string> &peers) {
-  std::unordered_map<std::string,
-                     std::unique_ptr<proto::OrderingGateTransportGrpc::Stub>>
-      peers_map;
-
-  for (const auto &peer : peers) {
-    peers_map[peer] = proto::OrderingGateTransportGrpc::NewStub(
-        grpc::CreateChannel(peer, grpc::InsecureChannelCredentials()));
+  std::lock_guard<std::mutex> lock(peers_mutex_);
+  if (peers != peer_addresses_) {
+    updatePeers(peers);
   }
 
-  for (const auto &peer : peers_map) {
-    auto call = new AsyncClientCall;
+  auto proto = static_cast<shared_model::proto::Proposal *>(proposal.get());
+  for (auto &peer : peers_) {
+    checkHealth(peer.first, peer.second);
+
+    auto call = newCall(peer.first, "proposal");
+    if (not call) {
+      log_->warn("Too many calls in flight to {}, proposal is dropped",
+                 peer.first);
+      continue;
+    }
 
-    auto proto = static_cast<shared_model::proto::Proposal *>(proposal.get());
-    call->response_reader = peer.second->AsynconProposal(
+    call->response_reader = peer.second.stub->AsynconProposal(
         &call->context, proto->getTransport(), &cq_);
 
     call->response_reader->Finish(&call->reply, &call->status, call);
   }
 }
 
+void OrderingServiceTransportGrpc::updatePeers(
+    const std::vector<std::string> &peers) {
+  log_->info("Ledger peers changed, {} peers", peers.size());
+
+  std::unordered_map<std::string, PeerConnection> updated_peers;
+  for (const auto &peer : peers) {
+    auto it = peers_.find(peer);
+    if (it != peers_.end()) {
+      updated_peers.emplace(peer, std::move(it->second));
+    } else if (updated_peers.find(peer) == updated_peers.end()) {
+      updated_peers.emplace(peer, connect(peer));
+    }
+  }
+
+  peers_ = std::move(updated_peers);
+  peer_addresses_ = peers;
+}
+
+OrderingServiceTransportGrpc::PeerConnection
+OrderingServiceTransportGrpc::connect(const std::string &address) const {
+  PeerConnection connection;
+  connection.channel =
+      grpc::CreateChannel(address, grpc::InsecureChannelCredentials());
+  connection.stub =
+      proto::OrderingGateTransportGrpc::NewStub(connection.channel);
+  // warm up the connection, so the first proposal does not wait for it
+  connection.state = connection.channel->GetState(true);
+  return connection;
+}
+
+void OrderingServiceTransportGrpc::checkHealth(const std::string &address,
+                                               PeerConnection &connection) {
+  auto state = connection.channel->GetState(true);
+  if (state == GRPC_CHANNEL_SHUTDOWN) {
+    log_->warn("Connection to {} is shut down, reconnecting", address);
+    connection = connect(address);
+    return;
+  }
+
+  if (state != connection.state) {
+    if (state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+      log_->warn("Peer {} is unavailable", address);
+    } else if (connection.state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+      log_->info("Peer {} is available again", address);
+    }
+    connection.state = state;
+  }
+}
+
 OrderingServiceTransportGrpc::OrderingServiceTransportGrpc()
     : log_(logger::testLog("OrderingServiceTransportGrpc")) {}
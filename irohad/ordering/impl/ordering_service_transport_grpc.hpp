@@ -18,6 +18,8 @@
 #define IROHA_ORDERING_SERVICE_TRANSPORT_GRPC_HPP
 
 #include <google/protobuf/empty.pb.h>
+#include <mutex>
+#include <unordered_map>
 
 #include "block.pb.h"
 #include "logger/logger.hpp"
@@ -34,6 +36,9 @@ namespace iroha {
           network::AsyncGrpcClient<google::protobuf::Empty> {
      public:
       OrderingServiceTransportGrpc();
+
+      using network::AsyncGrpcClient<google::protobuf::Empty>::statistics;
+
       void subscribe(
           std::shared_ptr<iroha::network::OrderingServiceNotification>
               subscriber) override;
@@ -46,10 +51,57 @@ namespace iroha {
                                  const protocol::Transaction *request,
                                  ::google::protobuf::Empty *response) override;
 
+      grpc::Status onBatch(::grpc::ServerContext *context,
+                           const proto::TxBatch *request,
+                           ::google::protobuf::Empty *response) override;
+
       ~OrderingServiceTransportGrpc() = default;
 
      private:
+      /**
+       * Cached connection to the ordering gate of a peer
+       */
+      struct PeerConnection {
+        std::shared_ptr<grpc::Channel> channel;
+        std::unique_ptr<proto::OrderingGateTransportGrpc::Stub> stub;
+        /// connectivity state observed on the last proposal
+        grpc_connectivity_state state;
+      };
+
+      /**
+       * Synchronize cached connections with the ledger peers: connections to
+       * removed peers are dropped, connections to new peers are created and
+       * start connecting in advance
+       * Lock on peers_mutex_ must be held
+       * @param peers - addresses of the ledger peers
+       */
+      void updatePeers(const std::vector<std::string> &peers);
+
+      /**
+       * Create connection to the peer and start connecting
+       * @param address - address of the peer
+       * @return connection to the peer
+       */
+      PeerConnection connect(const std::string &address) const;
+
+      /**
+       * Check connectivity state of the connection, recreate it if the
+       * channel is shut down
+       * Lock on peers_mutex_ must be held
+       * @param address - address of the peer
+       * @param connection - connection to the peer
+       */
+      void checkHealth(const std::string &address, PeerConnection &connection);
+
       std::weak_ptr<iroha::network::OrderingServiceNotification> subscriber_;
+
+      /**
+       * Addresses of the peers the connections were created for
+       */
+      std::vector<std::string> peer_addresses_;
+      std::unordered_map<std::string, PeerConnection> peers_;
+      std::mutex peers_mutex_;
+
       logger::Logger log_;
     };
 
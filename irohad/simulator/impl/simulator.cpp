@@ -31,11 +31,13 @@ namespace iroha {
         std::shared_ptr<validation::StatefulValidator> statefulValidator,
         std::shared_ptr<ametsuchi::TemporaryFactory> factory,
         std::shared_ptr<ametsuchi::BlockQuery> blockQuery,
-        std::shared_ptr<shared_model::crypto::CryptoModelSigner<>> crypto_signer)
+        std::shared_ptr<shared_model::crypto::CryptoModelSigner<>> crypto_signer,
+        bool pipelined)
         : validator_(std::move(statefulValidator)),
           ametsuchi_factory_(std::move(factory)),
           block_queries_(std::move(blockQuery)),
-          crypto_signer_(std::move(crypto_signer)) {
+          crypto_signer_(std::move(crypto_signer)),
+          pipelined_(pipelined) {
       log_ = logger::log("Simulator");
       ordering_gate->on_proposal().subscribe(
           proposal_subscription_,
@@ -54,6 +56,12 @@ namespace iroha {
     Simulator::~Simulator() {
       proposal_subscription_.unsubscribe();
       verified_proposal_subscription_.unsubscribe();
+      commit_subscription_.unsubscribe();
+    }
+
+    void Simulator::setPcs(const network::PeerCommunicationService &pcs) {
+      pcs.on_commit().subscribe(commit_subscription_,
+                                [this](auto) { this->process_commit(); });
     }
 
     rxcpp::observable<std::shared_ptr<shared_model::interface::Proposal>>
@@ -65,25 +73,61 @@ namespace iroha {
         const shared_model::interface::Proposal &proposal) {
       log_->info("process proposal");
       // Get last block from local ledger
-      block_queries_->getTopBlocks(1).as_blocking().subscribe(
-          [this](auto block) { last_block = block; });
-      if (not last_block) {
+      auto top_block = getTopBlock();
+      if (not top_block) {
         log_->warn("Could not fetch last block");
         return;
       }
-      if (last_block.value()->height() + 1 != proposal.height()) {
+      if (top_block.value()->height() + 1 != proposal.height()) {
+        if (pipelined_) {
+          std::shared_ptr<shared_model::interface::Block> pending_block;
+          {
+            std::lock_guard<std::mutex> lock(pipeline_mutex_);
+            pending_block = pending_block_;
+          }
+          if (pending_block
+              and pending_block->height() == top_block.value()->height() + 1
+              and pending_block->height() + 1 == proposal.height()) {
+            process_speculative_proposal(proposal, std::move(pending_block));
+            return;
+          }
+        }
         log_->warn("Last block height: {}, proposal height: {}",
-                   last_block.value()->height(),
+                   top_block.value()->height(),
                    proposal.height());
         return;
       }
+      last_block = top_block;
+      notifier_.get_subscriber().on_next(validateProposal(proposal, nullptr));
+    }
+
+    boost::optional<std::shared_ptr<const shared_model::interface::Block>>
+    Simulator::getTopBlock() {
+      boost::optional<std::shared_ptr<const shared_model::interface::Block>>
+          top_block;
+      block_queries_->getTopBlocks(1).as_blocking().subscribe(
+          [&top_block](auto block) { top_block = block; });
+      return top_block;
+    }
+
+    std::shared_ptr<shared_model::interface::Proposal>
+    Simulator::validateProposal(
+        const shared_model::interface::Proposal &proposal,
+        const shared_model::interface::Block *pending_block) {
+      std::shared_ptr<shared_model::interface::Proposal> validated_proposal;
       auto temporaryStorageResult = ametsuchi_factory_->createTemporaryWsv();
       temporaryStorageResult.match(
           [&](expected::Value<std::unique_ptr<ametsuchi::TemporaryWsv>>
                   &temporaryStorage) {
-            auto validated_proposal =
+            if (pending_block) {
+              // transactions of the block are already validated
+              for (const auto &tx : pending_block->transactions()) {
+                temporaryStorage.value->apply(
+                    *tx, [](const auto &, auto &) { return true; });
+              }
+            }
+            validated_proposal =
                 validator_->validate(proposal, *temporaryStorage.value);
-            notifier_.get_subscriber().on_next(validated_proposal);
           },
           [&](expected::Error<std::string> &error) {
             log_->error(error.error);
@@ -91,6 +135,64 @@ namespace iroha {
             // failed to produced - IR-966
             throw std::runtime_error(error.error);
           });
+      return validated_proposal;
+    }
+
+    void Simulator::process_speculative_proposal(
+        const shared_model::interface::Proposal &proposal,
+        std::shared_ptr<shared_model::interface::Block> pending_block) {
+      log_->info("process proposal {} on top of pending block",
+                 proposal.height());
+      auto verified_proposal = validateProposal(proposal, pending_block.get());
+      {
+        std::lock_guard<std::mutex> lock(pipeline_mutex_);
+        speculative_proposal_ = clone(proposal);
+        speculative_verified_ = std::move(verified_proposal);
+      }
+      // the pending block may be committed during validation
+      process_commit();
+    }
+
+    void Simulator::process_commit() {
+      std::shared_ptr<shared_model::interface::Proposal> proposal;
+      std::shared_ptr<shared_model::interface::Proposal> verified_proposal;
+      std::shared_ptr<shared_model::interface::Block> pending_block;
+      boost::optional<std::shared_ptr<const shared_model::interface::Block>>
+          top_block;
+      {
+        std::lock_guard<std::mutex> lock(pipeline_mutex_);
+        if (not speculative_proposal_) {
+          return;
+        }
+        top_block = getTopBlock();
+        if (not top_block
+            or top_block.value()->height() + 1
+                < speculative_proposal_->height()) {
+          // the pending block is not committed yet
+          return;
+        }
+        proposal = std::move(speculative_proposal_);
+        verified_proposal = std::move(speculative_verified_);
+        pending_block = pending_block_;
+      }
+
+      if (top_block.value()->height() + 1 != proposal->height()) {
+        log_->warn("Ledger is ahead of proposal {}, proposal is dropped",
+                   proposal->height());
+        return;
+      }
+
+      last_block = top_block;
+      if (top_block.value()->hash() == pending_block->hash()) {
+        log_->info("Pending block is committed, release proposal {}",
+                   proposal->height());
+        notifier_.get_subscriber().on_next(verified_proposal);
+      } else {
+        log_->info("Other block is committed, validate proposal {} again",
+                   proposal->height());
+        notifier_.get_subscriber().on_next(
+            validateProposal(*proposal, nullptr));
+      }
     }
 
     void Simulator::process_verified_proposal(
@@ -115,6 +217,11 @@ namespace iroha {
 
       crypto_signer_->sign(*block);
 
+      if (pipelined_) {
+        std::lock_guard<std::mutex> lock(pipeline_mutex_);
+        pending_block_ = block;
+      }
+
       block_notifier_.get_subscriber().on_next(block);
     }
 
@@ -19,11 +19,13 @@
 #define IROHA_SIMULATOR_HPP
 
 #include <boost/optional.hpp>
+#include <mutex>
 #include "ametsuchi/block_query.hpp"
 #include "ametsuchi/temporary_factory.hpp"
 #include "cryptography/crypto_provider/crypto_model_signer.hpp"
 #include "logger/logger.hpp"
 #include "network/ordering_gate.hpp"
+#include "network/peer_communication_service.hpp"
 #include "simulator/block_creator.hpp"
 #include "simulator/verified_proposal_creator.hpp"
 #include "validation/stateful_validator.hpp"
@@ -31,6 +33,14 @@
 namespace iroha {
   namespace simulator {
 
+    /**
+     * Simulator validates proposals and creates blocks from them.
+     *
+     * In pipelined mode a proposal which arrives while the previous block
+     * created by simulator is not committed yet is validated speculatively
+     * on top of that block. The result is released when the block is
+     * committed, and discarded if other block is committed instead
+     */
     class Simulator : public VerifiedProposalCreator, public BlockCreator {
      public:
       Simulator(
@@ -39,7 +49,8 @@ namespace iroha {
           std::shared_ptr<ametsuchi::TemporaryFactory> factory,
           std::shared_ptr<ametsuchi::BlockQuery> blockQuery,
           std::shared_ptr<shared_model::crypto::CryptoModelSigner<>>
-              crypto_signer);
+              crypto_signer,
+          bool pipelined = false);
 
       Simulator(const Simulator &) = delete;
       Simulator &operator=(const Simulator &) = delete;
@@ -58,7 +69,50 @@ namespace iroha {
       rxcpp::observable<std::shared_ptr<shared_model::interface::Block>>
       on_block() override;
 
+      /**
+       * Subscribe on commits of peer communication service, which release
+       * speculatively validated proposals in pipelined mode.
+       * Must be called before the ordering gate subscribes on the same
+       * commits, so the released block precedes the next round
+       * @param pcs - peer communication service
+       */
+      void setPcs(const network::PeerCommunicationService &pcs);
+
      private:
+      /**
+       * @return top block of the ledger
+       */
+      boost::optional<std::shared_ptr<const shared_model::interface::Block>>
+      getTopBlock();
+
+      /**
+       * Perform stateful validation of proposal
+       * @param proposal - proposal to validate
+       * @param pending_block - not committed block, which is applied to the
+       * state before validation; nullptr to validate on ledger state
+       * @return verified proposal
+       */
+      std::shared_ptr<shared_model::interface::Proposal> validateProposal(
+          const shared_model::interface::Proposal &proposal,
+          const shared_model::interface::Block *pending_block);
+
+      /**
+       * Validate proposal on top of the pending block and keep the result
+       * until the block is committed
+       * @param proposal - proposal following the pending block
+       * @param pending_block - block which is not committed yet
+       */
+      void process_speculative_proposal(
+          const shared_model::interface::Proposal &proposal,
+          std::shared_ptr<shared_model::interface::Block> pending_block);
+
+      /**
+       * Release speculatively verified proposal if the block it was
+       * validated on is committed, validate the proposal again if other
+       * block is committed instead
+       */
+      void process_commit();
+
       // internal
       rxcpp::subjects::subject<
           std::shared_ptr<shared_model::interface::Proposal>>
@@ -68,6 +122,7 @@ namespace iroha {
 
       rxcpp::composite_subscription proposal_subscription_;
       rxcpp::composite_subscription verified_proposal_subscription_;
+      rxcpp::composite_subscription commit_subscription_;
 
       std::shared_ptr<validation::StatefulValidator> validator_;
       std::shared_ptr<ametsuchi::TemporaryFactory> ametsuchi_factory_;
@@ -77,8 +132,19 @@ namespace iroha {
       logger::Logger log_;
 
       // last block
-      boost::optional<std::shared_ptr<shared_model::interface::Block>>
+      boost::optional<std::shared_ptr<const shared_model::interface::Block>>
           last_block;
+
+      const bool pipelined_;
+
+      /// last block created by simulator, which may be not committed yet
+      std::shared_ptr<shared_model::interface::Block> pending_block_;
+
+      /// proposal validated on top of pending block and its validation result
+      std::shared_ptr<shared_model::interface::Proposal> speculative_proposal_;
+      std::shared_ptr<shared_model::interface::Proposal> speculative_verified_;
+
+      std::mutex pipeline_mutex_;
     };
   }  // namespace simulator
 }  // namespace iroha
@@ -18,16 +18,22 @@
 #ifndef TORII_COMMAND_SERVICE_HPP
 #define TORII_COMMAND_SERVICE_HPP
 
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "ametsuchi/block_query.hpp"
+#include "backend/protobuf/transaction.hpp"
 #include "cache/cache.hpp"
 #include "cryptography/hash.hpp"
 #include "endpoint.grpc.pb.h"
 #include "endpoint.pb.h"
 #include "logger/logger.hpp"
+#include "timer/executor.hpp"
 #include "torii/processor/transaction_processor.hpp"
 
 namespace torii {
@@ -42,11 +48,14 @@ namespace torii {
      * @param tx_processor - processor of received transactions
      * @param block_query - to query transactions outside the cache
      * @param proposal_delay - time of a one proposal propagation.
+     * @param verification_threads - number of threads verifying received
+     * transactions, all hardware threads are used by default
      */
     CommandService(
         std::shared_ptr<iroha::torii::TransactionProcessor> tx_processor,
         std::shared_ptr<iroha::ametsuchi::BlockQuery> block_query,
-        std::chrono::milliseconds proposal_delay);
+        std::chrono::milliseconds proposal_delay,
+        size_t verification_threads = std::thread::hardware_concurrency());
 
     /**
      * Disable copying in any way to prevent potential issues with common
@@ -56,7 +65,9 @@ namespace torii {
     CommandService &operator=(const CommandService &) = delete;
 
     /**
-     * Actual implementation of sync Torii in CommandService
+     * Actual implementation of sync Torii in CommandService.
+     * Transaction is queued for stateless validation, which is performed
+     * asynchronously by the verification pool
      * @param tx - Transaction we've received
      */
     void Torii(const iroha::protocol::Transaction &tx);
@@ -72,6 +83,25 @@ namespace torii {
                                const iroha::protocol::Transaction *request,
                                google::protobuf::Empty *response) override;
 
+    /**
+     * Actual implementation of sync ListTorii in CommandService.
+     * Transactions are validated in parallel, and valid ones are passed to
+     * the transaction processor as a single unit
+     * @param tx_list - transactions we've received
+     */
+    void ListTorii(const iroha::protocol::TxList &tx_list);
+
+    /**
+     * ListTorii call via grpc
+     * @param context - call context (see grpc docs for details)
+     * @param request - list of transactions received
+     * @param response - no actual response (grpc stub for empty answer)
+     * @return - grpc::Status
+     */
+    virtual grpc::Status ListTorii(grpc::ServerContext *context,
+                                   const iroha::protocol::TxList *request,
+                                   google::protobuf::Empty *response) override;
+
     /**
      * Request to retrieve a status of any particular transaction
      * @param request - TxStatusRequest object which identifies transaction
@@ -125,6 +155,50 @@ namespace torii {
         override;
 
    private:
+    struct ReceivedList;
+
+    /**
+     * Perform stateless validation of transaction
+     * @param request - transaction received
+     * @param tx_hash - hash of the transaction
+     * @param response - status of the transaction is written here
+     * @return valid transaction, nullptr if it is invalid
+     */
+    std::shared_ptr<shared_model::proto::Transaction> validateTransaction(
+        const iroha::protocol::Transaction &request,
+        const shared_model::crypto::Hash &tx_hash,
+        iroha::protocol::ToriiResponse &response);
+
+    /**
+     * Perform stateless validation of transaction, store its status in
+     * cache and pass it to the transaction processor if it is valid
+     * @param request - transaction received
+     * @param tx_hash - hash of the transaction
+     */
+    void processTransaction(const iroha::protocol::Transaction &request,
+                            const shared_model::crypto::Hash &tx_hash);
+
+    /**
+     * Store statuses of validated list of transactions in cache and pass
+     * valid ones to the transaction processor
+     * @param list - validated transactions
+     */
+    void processList(ReceivedList &list);
+
+    /**
+     * Remove transactions from pending and wake up waiting status requests
+     * @param hashes - hashes of verified transactions
+     */
+    void finishVerification(
+        const std::vector<shared_model::crypto::Hash> &hashes);
+
+    /**
+     * Wait until the transaction is not verified anymore, so that its
+     * status can be found in cache
+     * @param tx_hash - hash of the transaction
+     */
+    void waitForVerification(const shared_model::crypto::Hash &tx_hash);
+
     void checkCacheAndSend(
         const boost::optional<iroha::protocol::ToriiResponse> &resp,
         grpc::ServerWriter<iroha::protocol::ToriiResponse> &response_writer)
@@ -143,6 +217,17 @@ namespace torii {
     std::chrono::milliseconds start_tx_processing_duration_;
     std::shared_ptr<CacheType> cache_;
     logger::Logger log_;
+
+    /// hashes of transactions queued or being verified
+    std::unordered_set<shared_model::crypto::Hash,
+                       shared_model::crypto::Hash::Hasher>
+        pending_;
+    std::mutex pending_mutex_;
+    std::condition_variable pending_verified_;
+
+    /// declared last, so that workers are stopped before other fields are
+    /// destroyed
+    std::unique_ptr<iroha::timer::Executor> verification_pool_;
   };
 
 }  // namespace torii
@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 
+#include <atomic>
 #include <thread>
 #include "backend/protobuf/transaction_responses/proto_tx_response.hpp"
 
@@ -32,16 +33,22 @@ using namespace std::chrono_literals;
 
 namespace torii {
 
+  /// maximal number of received transactions waiting for verification
+  const size_t kVerificationQueueSize = 1024;
+
   CommandService::CommandService(
       std::shared_ptr<iroha::torii::TransactionProcessor> tx_processor,
       std::shared_ptr<iroha::ametsuchi::BlockQuery> block_query,
-      std::chrono::milliseconds proposal_delay)
+      std::chrono::milliseconds proposal_delay,
+      size_t verification_threads)
       : tx_processor_(tx_processor),
         block_query_(block_query),
         proposal_delay_(proposal_delay),
         start_tx_processing_duration_(1s),
         cache_(std::make_shared<CacheType>()),
-        log_(logger::log("CommandService")) {
+        log_(logger::log("CommandService")),
+        verification_pool_(std::make_unique<iroha::timer::Executor>(
+            verification_threads, kVerificationQueueSize)) {
     // Notifier for all clients
     tx_processor_->transactionNotifier().subscribe([this](auto iroha_response) {
       // Find response in cache
@@ -67,42 +74,102 @@ namespace torii {
     });
   }
 
+  /**
+   * Transactions received in a single list, validated in parallel
+   */
+  struct CommandService::ReceivedList {
+    std::vector<iroha::protocol::Transaction> requests;
+    std::vector<shared_model::crypto::Hash> hashes;
+    std::vector<iroha::protocol::ToriiResponse> responses;
+    std::vector<std::shared_ptr<shared_model::proto::Transaction>>
+        transactions;
+    /// number of transactions which are not validated yet
+    std::atomic<size_t> left;
+  };
+
   void CommandService::Torii(const iroha::protocol::Transaction &request) {
-    shared_model::crypto::Hash tx_hash;
-    iroha::protocol::ToriiResponse response;
+    auto tx_hash = shared_model::proto::Transaction::HashProviderType::makeHash(
+        shared_model::proto::makeBlob(request.payload()));
+    {
+      std::lock_guard<std::mutex> lock(pending_mutex_);
+      if (not pending_.insert(tx_hash).second) {
+        // the same transaction is already being verified
+        return;
+      }
+    }
+
+    verification_pool_->submit([this, request, tx_hash] {
+      this->processTransaction(request, tx_hash);
+      this->finishVerification({tx_hash});
+    });
+  }
+
+  void CommandService::ListTorii(const iroha::protocol::TxList &tx_list) {
+    std::vector<shared_model::crypto::Hash> hashes;
+    hashes.reserve(tx_list.transactions_size());
+    for (const auto &request : tx_list.transactions()) {
+      hashes.push_back(
+          shared_model::proto::Transaction::HashProviderType::makeHash(
+              shared_model::proto::makeBlob(request.payload())));
+    }
+
+    auto list = std::make_shared<ReceivedList>();
+    {
+      std::lock_guard<std::mutex> lock(pending_mutex_);
+      for (int i = 0; i < tx_list.transactions_size(); ++i) {
+        // the same transaction may be already being verified
+        if (pending_.insert(hashes[i]).second) {
+          list->requests.push_back(tx_list.transactions(i));
+          list->hashes.push_back(std::move(hashes[i]));
+        }
+      }
+    }
+    if (list->requests.empty()) {
+      return;
+    }
+
+    const auto size = list->requests.size();
+    list->responses.resize(size);
+    list->transactions.resize(size);
+    list->left = size;
+    for (size_t i = 0; i < size; ++i) {
+      verification_pool_->submit([this, list, i] {
+        list->transactions[i] = this->validateTransaction(
+            list->requests[i], list->hashes[i], list->responses[i]);
+        // the last validated transaction completes the whole list
+        if (--list->left == 0) {
+          this->processList(*list);
+          this->finishVerification(list->hashes);
+        }
+      });
+    }
+  }
+
+  std::shared_ptr<shared_model::proto::Transaction>
+  CommandService::validateTransaction(
+      const iroha::protocol::Transaction &request,
+      const shared_model::crypto::Hash &tx_hash,
+      iroha::protocol::ToriiResponse &response) {
+    std::shared_ptr<shared_model::proto::Transaction> transaction;
 
     shared_model::proto::TransportBuilder<
         shared_model::proto::Transaction,
         shared_model::validation::DefaultSignableTransactionValidator>()
         .build(request)
         .match(
-            [this, &tx_hash, &response](
+            [&tx_hash, &response, &transaction](
                 // success case
                 iroha::expected::Value<shared_model::proto::Transaction>
                     &iroha_tx) {
-              tx_hash = iroha_tx.value.hash();
-              if (cache_->findItem(tx_hash)) {
-                return;
-              }
-
               // setting response
               response.set_tx_hash(tx_hash.toString());
               response.set_tx_status(
                   iroha::protocol::TxStatus::STATELESS_VALIDATION_SUCCESS);
 
-              cache_->addItem(tx_hash, response);
-              // Send transaction to iroha
-              tx_processor_->transactionHandle(
-                  std::make_shared<shared_model::proto::Transaction>(
-                      std::move(iroha_tx.value)));
+              transaction = std::make_shared<shared_model::proto::Transaction>(
+                  std::move(iroha_tx.value));
             },
-            [this, &tx_hash, &request, &response](const auto &error) {
-              // getting hash from invalid transaction
-              auto blobPayload =
-                  shared_model::proto::makeBlob(request.payload());
-              tx_hash =
-                  shared_model::proto::Transaction::HashProviderType::makeHash(
-                      blobPayload);
+            [this, &tx_hash, &response](const auto &error) {
               log_->warn("Stateless invalid tx: {}, hash: {}",
                          error.error,
                          tx_hash.hex());
@@ -114,7 +181,56 @@ namespace torii {
                   iroha::protocol::TxStatus::STATELESS_VALIDATION_FAILED);
             });
 
+    return transaction;
+  }
+
+  void CommandService::processTransaction(
+      const iroha::protocol::Transaction &request,
+      const shared_model::crypto::Hash &tx_hash) {
+    iroha::protocol::ToriiResponse response;
+    auto transaction = validateTransaction(request, tx_hash, response);
+    if (transaction and cache_->findItem(tx_hash)) {
+      // transaction has been received already
+      return;
+    }
+
     cache_->addItem(tx_hash, response);
+    if (transaction) {
+      // Send transaction to iroha
+      tx_processor_->transactionHandle(transaction);
+    }
+  }
+
+  void CommandService::processList(ReceivedList &list) {
+    std::vector<std::shared_ptr<shared_model::interface::Transaction>> batch;
+    for (size_t i = 0; i < list.transactions.size(); ++i) {
+      auto &transaction = list.transactions[i];
+      if (transaction and cache_->findItem(list.hashes[i])) {
+        // transaction has been received already
+        continue;
+      }
+
+      cache_->addItem(list.hashes[i], list.responses[i]);
+      if (transaction) {
+        batch.push_back(std::move(transaction));
+      }
+    }
+
+    if (not batch.empty()) {
+      // Send transactions to iroha as a single unit
+      tx_processor_->batchHandle(std::move(batch));
+    }
+  }
+
+  void CommandService::finishVerification(
+      const std::vector<shared_model::crypto::Hash> &hashes) {
+    {
+      std::lock_guard<std::mutex> lock(pending_mutex_);
+      for (const auto &tx_hash : hashes) {
+        pending_.erase(tx_hash);
+      }
+    }
+    pending_verified_.notify_all();
   }
 
   grpc::Status CommandService::Torii(
@@ -125,9 +241,26 @@ namespace torii {
     return grpc::Status::OK;
   }
 
+  grpc::Status CommandService::ListTorii(
+      grpc::ServerContext *context,
+      const iroha::protocol::TxList *request,
+      google::protobuf::Empty *response) {
+    ListTorii(*request);
+    return grpc::Status::OK;
+  }
+
+  void CommandService::waitForVerification(
+      const shared_model::crypto::Hash &tx_hash) {
+    std::unique_lock<std::mutex> lock(pending_mutex_);
+    pending_verified_.wait_for(lock, start_tx_processing_duration_, [&] {
+      return pending_.count(tx_hash) == 0;
+    });
+  }
+
   void CommandService::Status(const iroha::protocol::TxStatusRequest &request,
                               iroha::protocol::ToriiResponse &response) {
     auto tx_hash = shared_model::crypto::Hash(request.tx_hash());
+    waitForVerification(tx_hash);
     auto resp = cache_->findItem(tx_hash);
     if (resp) {
       response.CopyFrom(*resp);
@@ -156,6 +289,7 @@ namespace torii {
   void CommandService::StatusStream(
       iroha::protocol::TxStatusRequest const &request,
       grpc::ServerWriter<iroha::protocol::ToriiResponse> &response_writer) {
+    waitForVerification(shared_model::crypto::Hash(request.tx_hash()));
     auto resp = cache_->findItem(shared_model::crypto::Hash(request.tx_hash()));
     checkCacheAndSend(resp, response_writer);
 
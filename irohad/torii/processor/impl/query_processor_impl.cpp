@@ -70,10 +70,11 @@ namespace iroha {
         const shared_model::interface::Query &qry) {
       const auto &sig = *qry.signatures().begin();
 
-      const auto &wsv_query = storage_->getWsvQuery();
-      auto qpf =
-          model::QueryProcessingFactory(wsv_query, storage_->getBlockQuery());
-      auto signatories = wsv_query->getSignatories(qry.creatorAccountId());
+      auto wsv_query = storage_->getWsvQuery();
+      if (not wsv_query) {
+        return false;
+      }
+      auto signatories = (*wsv_query)->getSignatories(qry.creatorAccountId());
       if (not signatories) {
         return false;
       }
@@ -89,9 +90,14 @@ namespace iroha {
         return;
       }
 
-      const auto &wsv_query = storage_->getWsvQuery();
+      auto wsv_query = storage_->getWsvQuery();
+      if (not wsv_query) {
+        auto response = buildStatefulError(qry->hash());
+        subject_.get_subscriber().on_next(response);
+        return;
+      }
       auto qpf =
-          model::QueryProcessingFactory(wsv_query, storage_->getBlockQuery());
+          model::QueryProcessingFactory(*wsv_query, storage_->getBlockQuery());
       auto qpf_response = qpf.execute(*qry);
       auto qry_resp =
           std::static_pointer_cast<shared_model::proto::QueryResponse>(
@@ -86,6 +86,14 @@ namespace iroha {
       pcs_->propagate_transaction(transaction);
     }
 
+    void TransactionProcessorImpl::batchHandle(
+        std::vector<std::shared_ptr<shared_model::interface::Transaction>>
+            transactions) {
+      log_->info("handle batch of {} transactions", transactions.size());
+
+      pcs_->propagate_batch({transactions.begin(), transactions.end()});
+    }
+
     rxcpp::observable<
         std::shared_ptr<shared_model::interface::TransactionResponse>>
     TransactionProcessorImpl::transactionNotifier() {
@@ -19,6 +19,7 @@
 #define IROHA_TRANSACTION_PROCESSOR_HPP
 
 #include <rxcpp/rx.hpp>
+#include <vector>
 
 namespace shared_model {
   namespace interface {
@@ -44,6 +45,14 @@ namespace iroha {
           std::shared_ptr<shared_model::interface::Transaction>
               transaction) = 0;
 
+      /**
+       * Add transactions to the system for processing as a single unit
+       * @param transactions - transactions for processing
+       */
+      virtual void batchHandle(
+          std::vector<std::shared_ptr<shared_model::interface::Transaction>>
+              transactions) = 0;
+
       /**
        * Subscribers will be notified with transaction status
        * @return observable for subscribing
@@ -39,6 +39,10 @@ namespace iroha {
           std::shared_ptr<shared_model::interface::Transaction> transaction)
           override;
 
+      void batchHandle(
+          std::vector<std::shared_ptr<shared_model::interface::Transaction>>
+              transactions) override;
+
       rxcpp::observable<
           std::shared_ptr<shared_model::interface::TransactionResponse>>
       transactionNotifier() override;
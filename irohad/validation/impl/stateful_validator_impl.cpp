@@ -20,6 +20,7 @@
 #include <boost/range/adaptor/transformed.hpp>
 
 #include "builders/protobuf/proposal.hpp"
+#include "validation/impl/transaction_scheduler.hpp"
 
 namespace iroha {
   namespace validation {
@@ -54,21 +55,37 @@ namespace iroha {
                     });
       };
 
-      // Filter only valid transactions
-      auto filter = [&temporaryWsv, checking_transaction](auto &acc,
-                                                          const auto &tx) {
-        auto answer =
-            temporaryWsv.apply(*(tx.operator->()), checking_transaction);
-        if (answer) {
-          acc.push_back(tx);
-        }
-        return acc;
-      };
-
       auto &txs = proposal.transactions();
-      decltype(txs) valid = {};
 
-      auto valid_txs = std::accumulate(txs.begin(), txs.end(), valid, filter);
+      // Transactions of one batch do not conflict, so they are applied
+      // concurrently, while batches are applied in order
+      std::vector<AccessSet> access_sets;
+      for (const auto &tx : txs) {
+        access_sets.push_back(accessSet(*tx));
+      }
+      auto batches = scheduleBatches(access_sets);
+      log_->info("independent batches in proposal: {}", batches.size());
+
+      std::vector<bool> applied(txs.size(), false);
+      for (const auto &batch : batches) {
+        ametsuchi::TemporaryWsv::TransactionRefs batch_txs;
+        for (auto i : batch) {
+          batch_txs.emplace_back(*txs.at(i));
+        }
+        auto answers =
+            temporaryWsv.applyIndependent(batch_txs, checking_transaction);
+        for (size_t i = 0; i < batch.size(); ++i) {
+          applied[batch[i]] = answers[i];
+        }
+      }
+
+      // Filter only valid transactions, keeping the order of proposal
+      std::decay_t<decltype(txs)> valid_txs;
+      for (size_t i = 0; i < txs.size(); ++i) {
+        if (applied[i]) {
+          valid_txs.push_back(txs.at(i));
+        }
+      }
 
       // TODO: kamilsa IR-1010 20.02.2018 rework validation logic, so that this
       // cast is not needed and stateful validator does not know about the
@@ -0,0 +1,252 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "validation/impl/transaction_scheduler.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include <boost/variant/apply_visitor.hpp>
+#include <boost/variant/static_visitor.hpp>
+
+#include "interfaces/commands/command.hpp"
+#include "interfaces/transaction.hpp"
+
+namespace iroha {
+  namespace validation {
+
+    const std::string kWholeState = "*";
+
+    namespace {
+      std::string accountKey(const std::string &account_id) {
+        return "account:" + account_id;
+      }
+
+      std::string assetKey(const std::string &asset_id) {
+        return "asset:" + asset_id;
+      }
+
+      std::string domainKey(const std::string &domain_id) {
+        return "domain:" + domain_id;
+      }
+
+      std::string signatoryKey(
+          const shared_model::interface::types::PubkeyType &public_key) {
+        return "signatory:" + public_key.hex();
+      }
+
+      std::string accountAssetKey(const std::string &account_id,
+                                  const std::string &asset_id) {
+        return "account_asset:" + account_id + "/" + asset_id;
+      }
+
+      const std::string kRolesKey = "roles";
+      const std::string kPeersKey = "peers";
+
+      /**
+       * Adds keys accessed by command to access set. Account key covers
+       * account itself, its signatories, roles, details and grantable
+       * permissions given by the account. Signatory key covers the row of
+       * public key shared by all accounts and peers
+       */
+      class AccessCollector : public boost::static_visitor<void> {
+       public:
+        AccessCollector(AccessSet &access, const std::string &creator)
+            : access_(access), creator_(creator) {}
+
+        void operator()(const shared_model::detail::PolymorphicWrapper<
+                        shared_model::interface::AddAssetQuantity> &command) {
+          access_.reads.push_back(assetKey(command->assetId()));
+          access_.reads.push_back(accountKey(command->accountId()));
+          access_.writes.push_back(
+              accountAssetKey(command->accountId(), command->assetId()));
+        }
+
+        void operator()(const shared_model::detail::PolymorphicWrapper<
+                        shared_model::interface::AddPeer> &command) {
+          access_.reads.push_back(signatoryKey(command->peer().pubkey()));
+          access_.writes.push_back(kPeersKey);
+        }
+
+        void operator()(const shared_model::detail::PolymorphicWrapper<
+                        shared_model::interface::AddSignatory> &command) {
+          access_.writes.push_back(accountKey(command->accountId()));
+          access_.writes.push_back(signatoryKey(command->pubkey()));
+        }
+
+        void operator()(const shared_model::detail::PolymorphicWrapper<
+                        shared_model::interface::AppendRole> &command) {
+          access_.writes.push_back(accountKey(command->accountId()));
+        }
+
+        void operator()(const shared_model::detail::PolymorphicWrapper<
+                        shared_model::interface::CreateAccount> &command) {
+          access_.reads.push_back(domainKey(command->domainId()));
+          access_.writes.push_back(accountKey(
+              command->accountName() + "@" + command->domainId()));
+          access_.writes.push_back(signatoryKey(command->pubkey()));
+        }
+
+        void operator()(const shared_model::detail::PolymorphicWrapper<
+                        shared_model::interface::CreateAsset> &command) {
+          access_.reads.push_back(domainKey(command->domainId()));
+          access_.writes.push_back(
+              assetKey(command->assetName() + "#" + command->domainId()));
+        }
+
+        void operator()(const shared_model::detail::PolymorphicWrapper<
+                        shared_model::interface::CreateDomain> &command) {
+          access_.writes.push_back(domainKey(command->domainId()));
+        }
+
+        void operator()(const shared_model::detail::PolymorphicWrapper<
+                        shared_model::interface::CreateRole> &) {
+          access_.writes.push_back(kRolesKey);
+        }
+
+        void operator()(const shared_model::detail::PolymorphicWrapper<
+                        shared_model::interface::DetachRole> &command) {
+          access_.writes.push_back(accountKey(command->accountId()));
+        }
+
+        void operator()(const shared_model::detail::PolymorphicWrapper<
+                        shared_model::interface::GrantPermission> &command) {
+          // permission is stored for the pair of permittee and creator
+          access_.writes.push_back(accountKey(command->accountId()));
+          access_.writes.push_back(accountKey(creator_));
+        }
+
+        void operator()(const shared_model::detail::PolymorphicWrapper<
+                        shared_model::interface::RemoveSignatory> &command) {
+          // signatory row is removed unless any account or peer still has it
+          access_.reads.push_back(kPeersKey);
+          access_.writes.push_back(accountKey(command->accountId()));
+          access_.writes.push_back(signatoryKey(command->pubkey()));
+        }
+
+        void operator()(const shared_model::detail::PolymorphicWrapper<
+                        shared_model::interface::RevokePermission> &command) {
+          access_.writes.push_back(accountKey(command->accountId()));
+          access_.writes.push_back(accountKey(creator_));
+        }
+
+        void operator()(const shared_model::detail::PolymorphicWrapper<
+                        shared_model::interface::SetAccountDetail> &command) {
+          access_.writes.push_back(accountKey(command->accountId()));
+        }
+
+        void operator()(const shared_model::detail::PolymorphicWrapper<
+                        shared_model::interface::SetQuorum> &command) {
+          access_.writes.push_back(accountKey(command->accountId()));
+        }
+
+        void operator()(
+            const shared_model::detail::PolymorphicWrapper<
+                shared_model::interface::SubtractAssetQuantity> &command) {
+          access_.reads.push_back(assetKey(command->assetId()));
+          access_.reads.push_back(accountKey(command->accountId()));
+          access_.writes.push_back(
+              accountAssetKey(command->accountId(), command->assetId()));
+        }
+
+        void operator()(const shared_model::detail::PolymorphicWrapper<
+                        shared_model::interface::TransferAsset> &command) {
+          access_.reads.push_back(assetKey(command->assetId()));
+          access_.reads.push_back(accountKey(command->srcAccountId()));
+          access_.reads.push_back(accountKey(command->destAccountId()));
+          access_.writes.push_back(
+              accountAssetKey(command->srcAccountId(), command->assetId()));
+          access_.writes.push_back(
+              accountAssetKey(command->destAccountId(), command->assetId()));
+        }
+
+        /// Commands unknown to scheduler are applied exclusively
+        template <typename Command>
+        void operator()(const Command &) {
+          access_.writes.push_back(kWholeState);
+        }
+
+       private:
+        AccessSet &access_;
+        const std::string &creator_;
+      };
+    }  // namespace
+
+    AccessSet accessSet(
+        const shared_model::interface::Transaction &transaction) {
+      AccessSet access;
+      const auto &creator = transaction.creatorAccountId();
+      // signatures and permissions of creator are checked, and every
+      // permission check depends on the set of roles
+      access.reads.push_back(accountKey(creator));
+      access.reads.push_back(kRolesKey);
+      AccessCollector collector(access, creator);
+      for (const auto &command : transaction.commands()) {
+        boost::apply_visitor(collector, command->get());
+      }
+      return access;
+    }
+
+    std::vector<std::vector<size_t>> scheduleBatches(
+        const std::vector<AccessSet> &access_sets) {
+      // batch index is one more than the latest batch of a conflicting
+      // earlier transaction: after the last writer of each accessed key, and
+      // also after the last reader of each written key
+      std::unordered_map<std::string, size_t> write_level, read_level;
+      auto level_of = [](const auto &levels, const std::string &key) {
+        auto found = levels.find(key);
+        return found == levels.end() ? size_t{0} : found->second;
+      };
+
+      std::vector<std::vector<size_t>> batches;
+      for (size_t i = 0; i < access_sets.size(); ++i) {
+        const auto &access = access_sets[i];
+        // every transaction reads the whole state key, so transaction which
+        // writes it goes after all earlier ones
+        size_t level = level_of(write_level, kWholeState);
+        for (const auto &key : access.reads) {
+          level = std::max(level, level_of(write_level, key));
+        }
+        for (const auto &key : access.writes) {
+          level = std::max(
+              {level, level_of(write_level, key), level_of(read_level, key)});
+        }
+
+        if (level == batches.size()) {
+          batches.emplace_back();
+        }
+        batches[level].push_back(i);
+
+        // levels are stored one-based, so that zero means no access
+        const auto stored = level + 1;
+        auto update = [stored](auto &levels, const std::string &key) {
+          auto &value = levels[key];
+          value = std::max(value, stored);
+        };
+        update(read_level, kWholeState);
+        for (const auto &key : access.reads) {
+          update(read_level, key);
+        }
+        for (const auto &key : access.writes) {
+          update(write_level, key);
+        }
+      }
+      return batches;
+    }
+
+  }  // namespace validation
+}  // namespace iroha
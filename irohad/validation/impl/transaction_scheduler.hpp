@@ -0,0 +1,69 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_TRANSACTION_SCHEDULER_HPP
+#define IROHA_TRANSACTION_SCHEDULER_HPP
+
+#include <string>
+#include <vector>
+
+namespace shared_model {
+  namespace interface {
+    class Transaction;
+  }  // namespace interface
+}  // namespace shared_model
+
+namespace iroha {
+  namespace validation {
+
+    /**
+     * Parts of the world state which transaction may read and write during
+     * stateful validation. Sets are conservative: two transactions with
+     * disjoint write sets, which do not read each other's writes, give the
+     * same result in any order
+     */
+    struct AccessSet {
+      std::vector<std::string> reads;
+      std::vector<std::string> writes;
+    };
+
+    /// Key of the whole world state, written by transactions whose access
+    /// set cannot be determined
+    extern const std::string kWholeState;
+
+    /**
+     * Collect parts of the world state accessed by transaction
+     * @param transaction - transaction to inspect
+     * @return access set of all commands and of the signature check
+     */
+    AccessSet accessSet(const shared_model::interface::Transaction &transaction);
+
+    /**
+     * Split transactions into batches, which are applied one after another,
+     * while transactions of one batch do not conflict and can be applied
+     * concurrently. Conflicting transactions are kept in the original order,
+     * so the result equals to the sequential application
+     * @param access_sets - access sets of transactions in the original order
+     * @return batches with indices of transactions in ascending order
+     */
+    std::vector<std::vector<size_t>> scheduleBatches(
+        const std::vector<AccessSet> &access_sets);
+
+  }  // namespace validation
+}  // namespace iroha
+
+#endif  // IROHA_TRANSACTION_SCHEDULER_HPP
@@ -0,0 +1,137 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_LRU_CACHE_HPP
+#define IROHA_LRU_CACHE_HPP
+
+#include <atomic>
+#include <boost/optional.hpp>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace iroha {
+  namespace cache {
+
+    /**
+     * Thread-safe cache which holds a bounded number of items and evicts the
+     * least recently used one when the bound is reached
+     * @tparam KeyType type of key objects
+     * @tparam ValueType type of value objects
+     * @tparam KeyHash hasher for keys
+     */
+    template <typename KeyType,
+              typename ValueType,
+              typename KeyHash = std::hash<KeyType>>
+    class LruCache {
+     public:
+      /**
+       * @param capacity - maximal amount of items in cache
+       */
+      explicit LruCache(size_t capacity) : capacity_(capacity) {}
+
+      /**
+       * Adds new item to cache or replaces the value of existing one.
+       * Least recently used item is evicted if cache is full
+       * @param key - key to insert
+       * @param value - value to insert
+       */
+      void addItem(const KeyType &key, const ValueType &value) {
+        if (capacity_ == 0) {
+          return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto found = items_.find(key);
+        if (found != items_.end()) {
+          found->second->second = value;
+          order_.splice(order_.begin(), order_, found->second);
+          return;
+        }
+        order_.emplace_front(key, value);
+        items_.emplace(key, order_.begin());
+        if (items_.size() > capacity_) {
+          items_.erase(order_.back().first);
+          order_.pop_back();
+        }
+      }
+
+      /**
+       * Performs a search for an item with a specific key and marks it as
+       * the most recently used one
+       * @param key - key to find
+       * @return Optional of ValueType
+       */
+      boost::optional<ValueType> findItem(const KeyType &key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto found = items_.find(key);
+        if (found == items_.end()) {
+          ++misses_;
+          return boost::none;
+        }
+        ++hits_;
+        order_.splice(order_.begin(), order_, found->second);
+        return found->second->second;
+      }
+
+      /**
+       * Remove all items from cache
+       */
+      void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        items_.clear();
+        order_.clear();
+      }
+
+      /**
+       * @return amount of items in cache
+       */
+      size_t getCacheItemCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return items_.size();
+      }
+
+      /**
+       * @return number of findItem calls which found an item
+       */
+      uint64_t hits() const {
+        return hits_;
+      }
+
+      /**
+       * @return number of findItem calls which did not find an item
+       */
+      uint64_t misses() const {
+        return misses_;
+      }
+
+     private:
+      using ItemList = std::list<std::pair<KeyType, ValueType>>;
+
+      const size_t capacity_;
+
+      /// items ordered from the most to the least recently used
+      ItemList order_;
+      std::unordered_map<KeyType, typename ItemList::iterator, KeyHash> items_;
+      mutable std::mutex mutex_;
+
+      std::atomic<uint64_t> hits_{0};
+      std::atomic<uint64_t> misses_{0};
+    };
+  }  // namespace cache
+}  // namespace iroha
+
+#endif  // IROHA_LRU_CACHE_HPP
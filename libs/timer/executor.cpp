@@ -0,0 +1,100 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "timer/executor.hpp"
+
+#include <algorithm>
+
+namespace iroha {
+  namespace timer {
+
+    const size_t Executor::kUnbounded;
+
+    Executor::Executor(size_t workers, size_t queue_capacity)
+        : queue_capacity_(queue_capacity),
+          stopped_(false),
+          statistics_{0, 0, 0, 0},
+          log_(logger::log("Executor")) {
+      workers = std::max<size_t>(workers, 1);
+      workers_.reserve(workers);
+      for (size_t i = 0; i < workers; ++i) {
+        workers_.emplace_back([this] { this->work(); });
+      }
+      statistics_.threads_started = workers;
+    }
+
+    Executor::~Executor() {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+      }
+      not_empty_.notify_all();
+      for (auto &worker : workers_) {
+        worker.join();
+      }
+    }
+
+    void Executor::submit(Task task) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      auto full = [this] {
+        return queue_capacity_ != kUnbounded
+            and queue_.size() >= queue_capacity_;
+      };
+      if (full()) {
+        log_->debug("queue is full, waiting");
+        not_full_.wait(lock, [&full] { return not full(); });
+      }
+      queue_.push_back(std::move(task));
+      ++statistics_.tasks_submitted;
+      lock.unlock();
+      not_empty_.notify_one();
+    }
+
+    ExecutorStatistics Executor::statistics() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto statistics = statistics_;
+      statistics.queue_size = queue_.size();
+      return statistics;
+    }
+
+    void Executor::work() {
+      while (true) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock,
+                        [this] { return stopped_ or not queue_.empty(); });
+        if (queue_.empty()) {
+          // stopped and nothing left to execute
+          return;
+        }
+        auto task = std::move(queue_.front());
+        queue_.pop_front();
+        lock.unlock();
+        not_full_.notify_one();
+
+        try {
+          task();
+        } catch (const std::exception &e) {
+          log_->error("task failed: {}", e.what());
+        }
+
+        lock.lock();
+        ++statistics_.tasks_completed;
+      }
+    }
+
+  }  // namespace timer
+}  // namespace iroha
@@ -0,0 +1,102 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_EXECUTOR_HPP
+#define IROHA_EXECUTOR_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace timer {
+
+    /**
+     * Counters of executor activity
+     */
+    struct ExecutorStatistics {
+      /// threads started during the executor lifetime
+      size_t threads_started;
+      size_t tasks_submitted;
+      size_t tasks_completed;
+      /// tasks waiting for a worker
+      size_t queue_size;
+    };
+
+    /**
+     * Fixed set of long-lived worker threads which execute submitted tasks,
+     * so that short asynchronous jobs do not start a thread each. The queue
+     * of tasks may be bounded, then submission blocks while it is full, so
+     * that callers are slowed down instead of the queue growing without
+     * bound
+     */
+    class Executor {
+     public:
+      using Task = std::function<void()>;
+
+      /// queue capacity of executor which never blocks submission
+      static const size_t kUnbounded = 0;
+
+      /**
+       * @param workers - number of worker threads, at least one is started
+       * @param queue_capacity - maximal number of tasks waiting for a worker
+       */
+      explicit Executor(size_t workers, size_t queue_capacity = kUnbounded);
+
+      Executor(const Executor &) = delete;
+      Executor &operator=(const Executor &) = delete;
+
+      /**
+       * Executes tasks which are already queued and stops workers
+       */
+      ~Executor();
+
+      /**
+       * Queue task for execution, wait for a free slot if the queue is
+       * bounded and full
+       * @param task - task to execute
+       */
+      void submit(Task task);
+
+      /**
+       * @return snapshot of executor counters
+       */
+      ExecutorStatistics statistics() const;
+
+     private:
+      void work();
+
+      const size_t queue_capacity_;
+      mutable std::mutex mutex_;
+      std::condition_variable not_empty_;
+      std::condition_variable not_full_;
+      std::deque<Task> queue_;
+      bool stopped_;
+      ExecutorStatistics statistics_;
+      std::vector<std::thread> workers_;
+      logger::Logger log_;
+    };
+
+  }  // namespace timer
+}  // namespace iroha
+
+#endif  // IROHA_EXECUTOR_HPP
@@ -0,0 +1,246 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "timer/timer_wheel.hpp"
+
+#include <algorithm>
+
+namespace iroha {
+  namespace timer {
+
+    constexpr TimerWheel::TimerId TimerWheel::kNoTimer;
+    constexpr size_t TimerWheel::kSlotBits;
+    constexpr size_t TimerWheel::kSlots;
+    constexpr size_t TimerWheel::kLevels;
+
+    TimerWheel::TimerWheel(std::shared_ptr<Executor> executor,
+                           std::chrono::milliseconds tick)
+        : executor_(std::move(executor)),
+          tick_(std::max(tick, std::chrono::milliseconds(1))),
+          start_(Clock::now()),
+          current_tick_(0),
+          next_id_(kNoTimer),
+          wheel_(kLevels, std::vector<std::list<TimerId>>(kSlots)),
+          waiting_(0),
+          dispatched_(0),
+          statistics_{0, 0, 0, 0},
+          stopped_(false),
+          log_(logger::log("TimerWheel")) {
+      thread_ = std::thread([this] { this->loop(); });
+    }
+
+    TimerWheel::~TimerWheel() {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+      }
+      wakeup_.notify_one();
+      thread_.join();
+
+      std::unique_lock<std::mutex> lock(mutex_);
+      timers_.clear();
+      // queued tasks still refer to the wheel
+      finished_.wait(lock, [this] { return dispatched_ == 0; });
+    }
+
+    TimerWheel::TimerId TimerWheel::schedule(std::chrono::milliseconds delay,
+                                             Task task) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      auto now = toTick(Clock::now());
+      if (waiting_ == 0) {
+        // the wheel is empty, so it can skip ticks which passed while idle
+        current_tick_ = std::max(current_tick_, now);
+      }
+      auto ticks = (std::max<std::chrono::milliseconds::rep>(delay.count(), 0)
+                    + tick_.count() - 1)
+          / tick_.count();
+      auto expiry = std::max<uint64_t>(std::max(current_tick_, now) + ticks,
+                                       current_tick_ + 1);
+
+      auto id = ++next_id_;
+      auto &timer = timers_[id];
+      timer.expiry = expiry;
+      timer.task = std::move(task);
+      timer.state = State::kWaiting;
+      insert(id, timer);
+      ++waiting_;
+      ++statistics_.scheduled;
+      lock.unlock();
+
+      wakeup_.notify_one();
+      return id;
+    }
+
+    bool TimerWheel::cancel(TimerId id) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return remove(id);
+    }
+
+    bool TimerWheel::cancelAndWait(TimerId id) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      auto it = timers_.find(id);
+      if (it != timers_.end() and it->second.state == State::kRunning
+          and it->second.thread != std::this_thread::get_id()) {
+        finished_.wait(lock,
+                       [this, id] { return timers_.find(id) == timers_.end(); });
+        return false;
+      }
+      return remove(id);
+    }
+
+    TimerWheelStatistics TimerWheel::statistics() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto statistics = statistics_;
+      statistics.pending = timers_.size();
+      return statistics;
+    }
+
+    ExecutorStatistics TimerWheel::executorStatistics() const {
+      return executor_->statistics();
+    }
+
+    void TimerWheel::insert(TimerId id, Timer &timer) {
+      auto delta = timer.expiry > current_tick_ ? timer.expiry - current_tick_
+                                                : 0;
+      size_t level = 0;
+      while (level + 1 < kLevels
+             and delta >= (uint64_t(1) << (kSlotBits * (level + 1)))) {
+        ++level;
+      }
+      // timers beyond the range of the wheel wait in the farthest slot
+      auto range = uint64_t(1) << (kSlotBits * kLevels);
+      auto target =
+          delta < range ? timer.expiry : current_tick_ + range - 1;
+
+      timer.level = level;
+      timer.slot = (target >> (kSlotBits * level)) & (kSlots - 1);
+      auto &slot = wheel_[timer.level][timer.slot];
+      timer.position = slot.insert(slot.end(), id);
+    }
+
+    bool TimerWheel::remove(TimerId id) {
+      auto it = timers_.find(id);
+      if (it == timers_.end()) {
+        return false;
+      }
+      auto &timer = it->second;
+      switch (timer.state) {
+        case State::kWaiting:
+          wheel_[timer.level][timer.slot].erase(timer.position);
+          --waiting_;
+          break;
+        case State::kQueued:
+          // executor skips the task of removed timer
+          break;
+        case State::kRunning:
+          return false;
+      }
+      timers_.erase(it);
+      ++statistics_.cancelled;
+      return true;
+    }
+
+    void TimerWheel::advance() {
+      auto tick = ++current_tick_;
+
+      // move timers of the reached slots to lower levels
+      for (size_t level = 1; level < kLevels; ++level) {
+        if ((tick & ((uint64_t(1) << (kSlotBits * level)) - 1)) != 0) {
+          break;
+        }
+        std::list<TimerId> cascaded;
+        cascaded.swap(
+            wheel_[level][(tick >> (kSlotBits * level)) & (kSlots - 1)]);
+        for (auto id : cascaded) {
+          insert(id, timers_[id]);
+        }
+      }
+
+      std::list<TimerId> expired;
+      expired.swap(wheel_[0][tick & (kSlots - 1)]);
+      for (auto id : expired) {
+        auto &timer = timers_[id];
+        if (timer.expiry > tick) {
+          insert(id, timer);
+          continue;
+        }
+        timer.state = State::kQueued;
+        --waiting_;
+        ++dispatched_;
+        ++statistics_.fired;
+        executor_->submit([this, id] { this->run(id); });
+      }
+    }
+
+    void TimerWheel::run(TimerId id) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      auto it = timers_.find(id);
+      if (it != timers_.end()) {
+        it->second.state = State::kRunning;
+        it->second.thread = std::this_thread::get_id();
+        auto task = std::move(it->second.task);
+        lock.unlock();
+
+        try {
+          task();
+        } catch (const std::exception &e) {
+          log_->error("timer task failed: {}", e.what());
+        }
+
+        lock.lock();
+        timers_.erase(id);
+      }
+      --dispatched_;
+      lock.unlock();
+      finished_.notify_all();
+    }
+
+    uint64_t TimerWheel::toTick(Clock::time_point time) const {
+      return std::chrono::duration_cast<std::chrono::milliseconds>(time
+                                                                   - start_)
+          / tick_;
+    }
+
+    void TimerWheel::loop() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (not stopped_) {
+        if (waiting_ == 0) {
+          wakeup_.wait(lock, [this] { return stopped_ or waiting_ > 0; });
+          continue;
+        }
+        wakeup_.wait_until(lock, start_ + tick_ * (current_tick_ + 1));
+
+        auto now = toTick(Clock::now());
+        while (current_tick_ < now and not stopped_) {
+          if (waiting_ == 0) {
+            current_tick_ = now;
+            break;
+          }
+          advance();
+        }
+      }
+    }
+
+    std::shared_ptr<TimerWheel> defaultTimerWheel() {
+      static auto wheel = std::make_shared<TimerWheel>(
+          std::make_shared<Executor>(
+              std::max(2u, std::thread::hardware_concurrency())));
+      return wheel;
+    }
+
+  }  // namespace timer
+}  // namespace iroha
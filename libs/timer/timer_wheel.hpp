@@ -0,0 +1,201 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_TIMER_WHEEL_HPP
+#define IROHA_TIMER_WHEEL_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "logger/logger.hpp"
+#include "timer/executor.hpp"
+
+namespace iroha {
+  namespace timer {
+
+    /**
+     * Counters of timer wheel activity
+     */
+    struct TimerWheelStatistics {
+      size_t scheduled;
+      size_t fired;
+      size_t cancelled;
+      /// timers waiting for expiration or for executor
+      size_t pending;
+    };
+
+    /**
+     * Hierarchical timer wheel driven by a single thread. Expired timers are
+     * run on the executor, so a timer costs a list node instead of a thread.
+     *
+     * Level i of the wheel has kSlots slots of kSlots^i ticks each. A timer
+     * is put to the lowest level which covers its delay, and is moved to
+     * lower levels when the wheel reaches its slot
+     */
+    class TimerWheel {
+     public:
+      using Task = std::function<void()>;
+      using TimerId = uint64_t;
+      using Clock = std::chrono::steady_clock;
+
+      /// id which never identifies a timer
+      static constexpr TimerId kNoTimer = 0;
+
+      /**
+       * @param executor - runs expired timers
+       * @param tick - resolution of the wheel
+       */
+      explicit TimerWheel(
+          std::shared_ptr<Executor> executor,
+          std::chrono::milliseconds tick = std::chrono::milliseconds(1));
+
+      TimerWheel(const TimerWheel &) = delete;
+      TimerWheel &operator=(const TimerWheel &) = delete;
+
+      /**
+       * Drops pending timers and waits for running ones
+       */
+      ~TimerWheel();
+
+      /**
+       * Run task after delay
+       * @param delay - time before the task is run, rounded up to ticks
+       * @param task - task to run
+       * @return id of the timer for cancellation
+       */
+      TimerId schedule(std::chrono::milliseconds delay, Task task);
+
+      /**
+       * Cancel timer if its task has not started yet
+       * @param id - id of the timer
+       * @return true if the task will not be run
+       */
+      bool cancel(TimerId id);
+
+      /**
+       * Cancel timer, and wait for its task if it is running. Task running
+       * on the calling thread is not waited for
+       * @param id - id of the timer
+       * @return true if the task has not been started
+       */
+      bool cancelAndWait(TimerId id);
+
+      /**
+       * @return snapshot of timer counters
+       */
+      TimerWheelStatistics statistics() const;
+
+      /**
+       * @return statistics of the executor running the timers
+       */
+      ExecutorStatistics executorStatistics() const;
+
+     private:
+      /// number of bits of a slot index
+      static constexpr size_t kSlotBits = 6;
+      static constexpr size_t kSlots = 1 << kSlotBits;
+      static constexpr size_t kLevels = 4;
+
+      enum class State { kWaiting, kQueued, kRunning };
+
+      struct Timer {
+        uint64_t expiry;
+        Task task;
+        State state;
+        size_t level;
+        size_t slot;
+        std::list<TimerId>::iterator position;
+        std::thread::id thread;
+      };
+
+      /**
+       * Put waiting timer to the slot of its expiry tick
+       * Lock on mutex_ must be held
+       */
+      void insert(TimerId id, Timer &timer);
+
+      /**
+       * Remove timer which has not started yet
+       * Lock on mutex_ must be held
+       * @return true if the timer is removed
+       */
+      bool remove(TimerId id);
+
+      /**
+       * Advance the wheel by one tick, and queue expired timers to executor
+       * Lock on mutex_ must be held
+       */
+      void advance();
+
+      /**
+       * Run task of the timer on executor thread
+       */
+      void run(TimerId id);
+
+      /**
+       * @return tick which corresponds to the time point
+       */
+      uint64_t toTick(Clock::time_point time) const;
+
+      /**
+       * Body of the wheel thread
+       */
+      void loop();
+
+      std::shared_ptr<Executor> executor_;
+      const std::chrono::milliseconds tick_;
+      const Clock::time_point start_;
+
+      /// tick which has been processed last
+      uint64_t current_tick_;
+      TimerId next_id_;
+      std::unordered_map<TimerId, Timer> timers_;
+      /// timer ids by level and slot
+      std::vector<std::vector<std::list<TimerId>>> wheel_;
+      /// timers which are waiting in the wheel
+      size_t waiting_;
+      /// tasks submitted to executor which are not finished
+      size_t dispatched_;
+
+      TimerWheelStatistics statistics_;
+
+      mutable std::mutex mutex_;
+      std::condition_variable wakeup_;
+      std::condition_variable finished_;
+      bool stopped_;
+
+      logger::Logger log_;
+      std::thread thread_;
+    };
+
+    /**
+     * @return timer wheel shared by the whole process
+     */
+    std::shared_ptr<TimerWheel> defaultTimerWheel();
+
+  }  // namespace timer
+}  // namespace iroha
+
+#endif  // IROHA_TIMER_WHEEL_HPP
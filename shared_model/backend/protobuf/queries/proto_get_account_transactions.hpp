@@ -45,11 +45,33 @@ namespace shared_model {
         return account_transactions_.account_id();
       }
 
+      interface::types::TransactionsNumberType pageSize() const override {
+        return account_transactions_.pagination_meta().page_size();
+      }
+
+      const boost::optional<interface::types::HashType> &lastTxHash()
+          const override {
+        return *last_tx_hash_;
+      }
+
      private:
       // ------------------------------| fields |-------------------------------
 
       const iroha::protocol::GetAccountTransactions &account_transactions_{
           proto_->payload().get_account_transactions()};
+
+      template <typename T>
+      using Lazy = detail::LazyInitializer<T>;
+
+      const Lazy<boost::optional<interface::types::HashType>> last_tx_hash_{
+          [this]() -> boost::optional<interface::types::HashType> {
+            const auto &hash =
+                account_transactions_.pagination_meta().last_tx_hash();
+            if (hash.empty()) {
+              return boost::none;
+            }
+            return interface::types::HashType(hash);
+          }};
     };
 
   }  // namespace proto
@@ -87,6 +87,22 @@ namespace shared_model {
         return copy;
       }
 
+      /**
+       * Fill pagination of transactions history query
+       * @param meta - proto pagination meta to fill
+       * @param page_size - maximal number of transactions, 0 for all
+       * @param last_tx_hash - hash of the last transaction of previous page
+       */
+      static void setPaginationMeta(
+          iroha::protocol::TxPaginationMeta *meta,
+          interface::types::TransactionsNumberType page_size,
+          const boost::optional<interface::types::HashType> &last_tx_hash) {
+        meta->set_page_size(page_size);
+        if (last_tx_hash) {
+          meta->set_last_tx_hash(crypto::toBinaryString(*last_tx_hash));
+        }
+      }
+
      public:
       TemplateQueryBuilder(const SV &validator = SV())
           : stateless_validator_(validator) {}
@@ -126,20 +142,30 @@ namespace shared_model {
       }
 
       auto getAccountTransactions(
-          const interface::types::AccountIdType &account_id) const {
+          const interface::types::AccountIdType &account_id,
+          interface::types::TransactionsNumberType page_size = 0,
+          const boost::optional<interface::types::HashType> &last_tx_hash =
+              boost::none) const {
         return queryField([&](auto proto_query) {
           auto query = proto_query->mutable_get_account_transactions();
           query->set_account_id(account_id);
+          setPaginationMeta(
+              query->mutable_pagination_meta(), page_size, last_tx_hash);
         });
       }
 
       auto getAccountAssetTransactions(
           const interface::types::AccountIdType &account_id,
-          const interface::types::AssetIdType &asset_id) const {
+          const interface::types::AssetIdType &asset_id,
+          interface::types::TransactionsNumberType page_size = 0,
+          const boost::optional<interface::types::HashType> &last_tx_hash =
+              boost::none) const {
         return queryField([&](auto proto_query) {
           auto query = proto_query->mutable_get_account_asset_transactions();
           query->set_account_id(account_id);
           query->set_asset_id(asset_id);
+          setPaginationMeta(
+              query->mutable_pagination_meta(), page_size, last_tx_hash);
         });
       }
 
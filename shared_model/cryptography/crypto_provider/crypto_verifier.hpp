@@ -48,6 +48,18 @@ namespace shared_model {
         return Algorithm::verify(signedData, source, pubKey);
       }
 
+      /**
+       * Verify signatures attached to the same source data
+       * @param signatures - cryptographic signatures with public keys of
+       * signatories
+       * @param source - data that was signed
+       * @return validity of each signature in the order of the batch
+       */
+      static std::vector<bool> verifyBatch(const SignatureBatch &signatures,
+                                           const Blob &source) {
+        return Algorithm::verifyBatch(signatures, source);
+      }
+
       /// close constructor for forbidding instantiation
       CryptoVerifier() = delete;
     };
@@ -34,6 +34,11 @@ namespace shared_model {
       return Verifier::verify(signedData, orig, publicKey);
     }
 
+    std::vector<bool> CryptoProviderEd25519Sha3::verifyBatch(
+        const SignatureBatch &signatures, const Blob &orig) {
+      return Verifier::verifyBatch(signatures, orig);
+    }
+
     Seed CryptoProviderEd25519Sha3::generateSeed() {
       return Seed(iroha::create_seed().to_string());
     }
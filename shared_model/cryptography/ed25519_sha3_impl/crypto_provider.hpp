@@ -18,6 +18,7 @@
 #ifndef IROHA_CRYPTOPROVIDER_HPP
 #define IROHA_CRYPTOPROVIDER_HPP
 
+#include "cryptography/ed25519_sha3_impl/verifier.hpp"
 #include "cryptography/keypair.hpp"
 #include "cryptography/seed.hpp"
 #include "cryptography/signed.hpp"
@@ -47,6 +48,16 @@ namespace shared_model {
       static bool verify(const Signed &signedData,
                          const Blob &orig,
                          const PublicKey &publicKey);
+
+      /**
+       * Verifies signatures of the same message.
+       * @param signatures - signatures with public keys to verify
+       * @param orig - original message
+       * @return validity of each signature in the order of the batch
+       */
+      static std::vector<bool> verifyBatch(const SignatureBatch &signatures,
+                                           const Blob &orig);
+
       /**
        * Generates new seed
        * @return Seed generated
@@ -29,5 +29,22 @@ namespace shared_model {
           iroha::pubkey_t::from_string(toBinaryString(publicKey)),
           iroha::sig_t::from_string(toBinaryString(signedData)));
     }
+
+    std::vector<bool> Verifier::verifyBatch(const SignatureBatch &signatures,
+                                            const Blob &orig) {
+      if (signatures.empty()) {
+        return {};
+      }
+      auto hash = iroha::sha3_256(crypto::toBinaryString(orig)).to_string();
+      std::vector<bool> result;
+      result.reserve(signatures.size());
+      for (const auto &signature : signatures) {
+        result.push_back(iroha::verify(
+            hash,
+            iroha::pubkey_t::from_string(toBinaryString(*signature.second)),
+            iroha::sig_t::from_string(toBinaryString(*signature.first))));
+      }
+      return result;
+    }
   }  // namespace crypto
 }  // namespace shared_model
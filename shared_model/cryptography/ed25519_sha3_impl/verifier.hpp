@@ -18,11 +18,20 @@
 #ifndef IROHA_SHARED_MODEL_VERIFIER_HPP
 #define IROHA_SHARED_MODEL_VERIFIER_HPP
 
+#include <vector>
+
 #include "cryptography/public_key.hpp"
 #include "cryptography/signed.hpp"
 
 namespace shared_model {
   namespace crypto {
+    /**
+     * Signatures of the same message with public keys of signatories.
+     * Pointers refer to data owned by the caller
+     */
+    using SignatureBatch =
+        std::vector<std::pair<const Signed *, const PublicKey *>>;
+
     /**
      * Class for signature verification.
      */
@@ -31,6 +40,16 @@ namespace shared_model {
       static bool verify(const Signed &signedData,
                          const Blob &orig,
                          const PublicKey &publicKey);
+
+      /**
+       * Verify signatures of the same message. The message is hashed once
+       * for the whole batch instead of once per signature
+       * @param signatures - signatures with public keys
+       * @param orig - original message
+       * @return validity of each signature in the order of the batch
+       */
+      static std::vector<bool> verifyBatch(const SignatureBatch &signatures,
+                                           const Blob &orig);
     };
 
   }  // namespace crypto
@@ -18,6 +18,7 @@
 #ifndef IROHA_SHARED_MODEL_GET_ACCOUNT_ASSET_TRANSACTIONS_HPP
 #define IROHA_SHARED_MODEL_GET_ACCOUNT_ASSET_TRANSACTIONS_HPP
 
+#include <boost/optional.hpp>
 #include "interfaces/base/primitive.hpp"
 #include "interfaces/common_objects/types.hpp"
 
@@ -43,6 +44,17 @@ namespace shared_model {
        */
       virtual const types::AccountIdType &assetId() const = 0;
 
+      /**
+       * @return maximal number of transactions in response, 0 if the whole
+       * history is requested
+       */
+      virtual types::TransactionsNumberType pageSize() const = 0;
+      /**
+       * @return hash of the last transaction of the previous page,
+       * transactions following it are returned
+       */
+      virtual const boost::optional<types::HashType> &lastTxHash() const = 0;
+
 #ifndef DISABLE_BACKWARD
       OldModelType *makeOldModel() const override {
         auto oldModel = new iroha::model::GetAccountAssetTransactions;
@@ -58,11 +70,16 @@ namespace shared_model {
             .init("GetAccountAssetTransactions")
             .append("account_id", accountId())
             .append("asset_id", assetId())
+            .append("page_size", std::to_string(pageSize()))
+            .append("last_tx_hash",
+                    lastTxHash() ? lastTxHash()->hex() : std::string())
             .finalize();
       }
 
       bool operator==(const ModelType &rhs) const override {
-        return accountId() == rhs.accountId() and assetId() == rhs.assetId();
+        return accountId() == rhs.accountId() and assetId() == rhs.assetId()
+            and pageSize() == rhs.pageSize()
+            and lastTxHash() == rhs.lastTxHash();
       }
     };
 
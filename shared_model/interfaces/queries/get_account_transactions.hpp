@@ -18,6 +18,7 @@
 #ifndef IROHA_SHARED_MODEL_GET_ACCOUNT_TRANSACTIONS_HPP
 #define IROHA_SHARED_MODEL_GET_ACCOUNT_TRANSACTIONS_HPP
 
+#include <boost/optional.hpp>
 #include "interfaces/base/primitive.hpp"
 #include "interfaces/common_objects/types.hpp"
 
@@ -37,6 +38,17 @@ namespace shared_model {
        */
       virtual const types::AccountIdType &accountId() const = 0;
 
+      /**
+       * @return maximal number of transactions in response, 0 if the whole
+       * history is requested
+       */
+      virtual types::TransactionsNumberType pageSize() const = 0;
+      /**
+       * @return hash of the last transaction of the previous page,
+       * transactions following it are returned
+       */
+      virtual const boost::optional<types::HashType> &lastTxHash() const = 0;
+
 #ifndef DISABLE_BACKWARD
       virtual OldModelType *makeOldModel() const override {
         auto oldModel = new iroha::model::GetAccountTransactions;
@@ -50,11 +62,15 @@ namespace shared_model {
         return detail::PrettyStringBuilder()
             .init("GetAccountTransactions")
             .append("account_id", accountId())
+            .append("page_size", std::to_string(pageSize()))
+            .append("last_tx_hash",
+                    lastTxHash() ? lastTxHash()->hex() : std::string())
             .finalize();
       }
 
       bool operator==(const ModelType &rhs) const override {
-        return accountId() == rhs.accountId();
+        return accountId() == rhs.accountId() and pageSize() == rhs.pageSize()
+            and lastTxHash() == rhs.lastTxHash();
       }
     };
   }  // namespace interface
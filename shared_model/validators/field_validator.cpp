@@ -293,6 +293,7 @@ namespace shared_model {
         ReasonsGroupType &reason,
         const interface::SignatureSetType &signatures,
         const crypto::Blob &source) const {
+      crypto::SignatureBatch batch;
       for (const auto &signature : signatures) {
         const auto &sign = signature->signedData();
         const auto &pkey = signature->publicKey();
@@ -312,11 +313,19 @@ namespace shared_model {
           is_valid = false;
         }
 
-        if (is_valid
-            && not shared_model::crypto::CryptoVerifier<>::verify(
-                   sign, source, pkey)) {
+        if (is_valid) {
+          batch.emplace_back(&sign, &pkey);
+        }
+      }
+
+      // source is hashed once for all signatures
+      auto verified =
+          shared_model::crypto::CryptoVerifier<>::verifyBatch(batch, source);
+      for (size_t i = 0; i < batch.size(); ++i) {
+        if (not verified[i]) {
           reason.second.push_back((boost::format("Wrong signature [%s;%s]")
-                                   % sign.hex() % pkey.hex())
+                                   % batch[i].first->hex()
+                                   % batch[i].second->hex())
                                       .str());
         }
       }
@@ -0,0 +1,156 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+///
+/// Latency of block lookup by hash depending on the ledger height.
+///
+/// Requires running PostgreSQL, connection is configured with the same
+/// IROHA_POSTGRES_* environment variables as ametsuchi tests.
+///
+/// BM_GetBlockByHash is expected to stay flat with the growth of the chain,
+/// BM_GetBlockByScan shows the previous approach, which reads every block.
+///
+
+#include <benchmark/benchmark.h>
+#include <boost/filesystem.hpp>
+#include <pqxx/pqxx>
+#include <sstream>
+
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "ametsuchi/impl/postgres_block_query.hpp"
+#include "ametsuchi/impl/storage_impl.hpp"
+#include "common/files.hpp"
+#include "datetime/time.hpp"
+#include "module/shared_model/builders/protobuf/test_block_builder.hpp"
+
+using namespace iroha::ametsuchi;
+
+class BlockByHashFixture : public benchmark::Fixture {
+ public:
+  void SetUp(const benchmark::State &state) override {
+    auto pg_host = std::getenv("IROHA_POSTGRES_HOST");
+    if (pg_host) {
+      std::stringstream ss;
+      ss << "host=" << pg_host << " port=" << std::getenv("IROHA_POSTGRES_PORT")
+         << " user=" << std::getenv("IROHA_POSTGRES_USER")
+         << " password=" << std::getenv("IROHA_POSTGRES_PASSWORD");
+      pgopt_ = ss.str();
+    }
+    boost::filesystem::create_directory(block_store_path_);
+
+    StorageImpl::create(block_store_path_, pgopt_)
+        .match(
+            [&](iroha::expected::Value<std::shared_ptr<StorageImpl>> &v) {
+              storage_ = v.value;
+            },
+            [](iroha::expected::Error<std::string> &error) {
+              throw std::runtime_error(error.error);
+            });
+    storage_->dropStorage();
+
+    // fill the ledger with blocks
+    std::vector<std::shared_ptr<shared_model::interface::Block>> blocks;
+    auto prev_hash = shared_model::crypto::Hash(std::string(32, '0'));
+    for (int64_t height = 1; height <= state.range(0); ++height) {
+      auto block = std::make_shared<shared_model::proto::Block>(
+          TestBlockBuilder()
+              .height(height)
+              .prevHash(prev_hash)
+              .createdTime(iroha::time::now())
+              .build());
+      prev_hash = block->hash();
+      hashes_.push_back(prev_hash);
+      blocks.push_back(std::move(block));
+    }
+    storage_->insertBlocks(blocks);
+
+    // separate block query with a tiny cache, so blocks are read from disk
+    block_store_ = std::move(*FlatFile::create(block_store_path_));
+    connection_ = std::make_unique<pqxx::lazyconnection>(pgopt_);
+    transaction_ = std::make_unique<pqxx::nontransaction>(*connection_);
+    query_ = std::make_unique<PostgresBlockQuery>(
+        *transaction_, *block_store_, std::make_shared<BlockCache>(1));
+  }
+
+  void TearDown(const benchmark::State &) override {
+    query_.reset();
+    transaction_.reset();
+    connection_.reset();
+    block_store_.reset();
+    storage_->dropStorage();
+    storage_.reset();
+    hashes_.clear();
+    iroha::remove_dir_contents(block_store_path_);
+  }
+
+ protected:
+  /**
+   * @return hash of the next block to request, requests go round robin over
+   * the whole ledger
+   */
+  const shared_model::crypto::Hash &nextHash() {
+    next_ = (next_ + 1) % hashes_.size();
+    return hashes_[next_];
+  }
+
+  std::string pgopt_ =
+      "host=localhost port=5432 user=postgres password=mysecretpassword";
+  std::string block_store_path_ =
+      (boost::filesystem::temp_directory_path() / "block_store_benchmark")
+          .string();
+
+  std::shared_ptr<StorageImpl> storage_;
+  std::unique_ptr<FlatFile> block_store_;
+  std::unique_ptr<pqxx::lazyconnection> connection_;
+  std::unique_ptr<pqxx::nontransaction> transaction_;
+  std::unique_ptr<PostgresBlockQuery> query_;
+  std::vector<shared_model::crypto::Hash> hashes_;
+  size_t next_ = 0;
+};
+
+/// Lookup of height in hash index and a single block read
+BENCHMARK_DEFINE_F(BlockByHashFixture, BM_GetBlockByHash)
+(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    auto block = query_->getBlockByHashSync(nextHash());
+    benchmark::DoNotOptimize(block);
+  }
+}
+BENCHMARK_REGISTER_F(BlockByHashFixture, BM_GetBlockByHash)
+    ->RangeMultiplier(10)
+    ->Range(10, 10000)
+    ->Unit(benchmark::kMicrosecond);
+
+/// Reading blocks from the start of the ledger until hash matches
+BENCHMARK_DEFINE_F(BlockByHashFixture, BM_GetBlockByScan)
+(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    const auto &hash = nextHash();
+    std::shared_ptr<const shared_model::interface::Block> result;
+    query_->getBlocksFrom(1)
+        .filter([&hash](auto block) { return block->hash() == hash; })
+        .as_blocking()
+        .subscribe([&result](auto block) { result = block; });
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK_REGISTER_F(BlockByHashFixture, BM_GetBlockByScan)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
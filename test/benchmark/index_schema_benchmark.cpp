@@ -0,0 +1,183 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+///
+/// Latency of block index queries on a ledger with 1M transactions, before
+/// and after migration to the typed and indexed schema. Argument 0 stands
+/// for legacy schema, argument 1 for the migrated one.
+///
+/// Requires running PostgreSQL, connection is configured with the same
+/// IROHA_POSTGRES_* environment variables as ametsuchi tests. Index tables
+/// of the database are dropped.
+///
+
+#include <benchmark/benchmark.h>
+#include <boost/format.hpp>
+#include <pqxx/pqxx>
+#include <sstream>
+
+#include "ametsuchi/impl/schema_migration.hpp"
+
+using namespace iroha::ametsuchi;
+
+namespace {
+  const int kTransactions = 1000000;
+  const int kTransactionsPerBlock = 100;
+  const int kAccounts = 1000;
+
+  const std::string kLegacySchema = R"(
+DROP TABLE IF EXISTS schema_version;
+DROP TABLE IF EXISTS height_by_hash;
+DROP TABLE IF EXISTS height_by_account_set;
+DROP TABLE IF EXISTS index_by_creator_height;
+DROP TABLE IF EXISTS index_by_id_height_asset;
+CREATE TABLE height_by_hash (hash bytea, height text);
+CREATE TABLE height_by_account_set (account_id text, height text);
+CREATE TABLE index_by_creator_height (
+    id serial, creator_id text, height text, index text);
+CREATE TABLE index_by_id_height_asset (
+    id text, height text, asset_id text, index text);
+)";
+
+  /// transaction i is created by user<i % kAccounts>@test and placed in
+  /// block i / kTransactionsPerBlock + 1 at position i % kTransactionsPerBlock
+  const std::string kFill = R"(
+INSERT INTO height_by_hash
+    SELECT decode(md5(i::text), 'hex'), (i / %2% + 1)::text
+    FROM generate_series(0, %1% - 1) AS i;
+INSERT INTO height_by_account_set
+    SELECT 'user' || i %% %3% || '@test', (i / %2% + 1)::text
+    FROM generate_series(0, %1% - 1) AS i;
+INSERT INTO index_by_creator_height(creator_id, height, index)
+    SELECT 'user' || i %% %3% || '@test', (i / %2% + 1)::text,
+        (i %% %2%)::text
+    FROM generate_series(0, %1% - 1) AS i;
+INSERT INTO index_by_id_height_asset
+    SELECT 'user' || i %% %3% || '@test', (i / %2% + 1)::text, 'coin#test',
+        (i %% %2%)::text
+    FROM generate_series(0, %1% - 1) AS i;
+)";
+}  // namespace
+
+class IndexSchemaFixture : public benchmark::Fixture {
+ public:
+  void SetUp(const benchmark::State &state) override {
+    std::string pgopt =
+        "host=localhost port=5432 user=postgres password=mysecretpassword";
+    if (auto pg_host = std::getenv("IROHA_POSTGRES_HOST")) {
+      std::stringstream ss;
+      ss << "host=" << pg_host << " port=" << std::getenv("IROHA_POSTGRES_PORT")
+         << " user=" << std::getenv("IROHA_POSTGRES_USER")
+         << " password=" << std::getenv("IROHA_POSTGRES_PASSWORD");
+      pgopt = ss.str();
+    }
+    connection_ = std::make_unique<pqxx::connection>(pgopt);
+    transaction_ = std::make_unique<pqxx::nontransaction>(*connection_);
+
+    // filling takes a while, so data is kept between benchmarks with the
+    // same schema
+    static int schema = -1;
+    bool migrated = state.range(0) == 1;
+    if (schema == -1 or (schema == 1 and not migrated)) {
+      transaction_->exec(kLegacySchema);
+      transaction_->exec(
+          (boost::format(kFill) % kTransactions % kTransactionsPerBlock
+           % kAccounts)
+              .str());
+      schema = 0;
+    }
+    if (schema == 0 and migrated) {
+      migrateSchema(*transaction_)
+          .match([](iroha::expected::Value<int> &) {},
+                 [](iroha::expected::Error<std::string> &e) {
+                   throw std::runtime_error(e.error);
+                 });
+      schema = 1;
+    }
+    transaction_->exec("ANALYZE;");
+  }
+
+  void TearDown(const benchmark::State &) override {
+    transaction_.reset();
+    connection_.reset();
+  }
+
+ protected:
+  /**
+   * @return quoted value of the next key in round robin manner
+   */
+  std::string next(int count) {
+    return transaction_->quote(std::to_string(next_++ % count));
+  }
+
+  std::unique_ptr<pqxx::connection> connection_;
+  std::unique_ptr<pqxx::nontransaction> transaction_;
+  int next_ = 0;
+};
+
+/// PostgresBlockQuery::getBlockId, height of block with transaction
+BENCHMARK_DEFINE_F(IndexSchemaFixture, BM_HeightByTxHash)
+(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    auto result = transaction_->exec(
+        "SELECT height FROM height_by_hash WHERE hash = decode(md5("
+        + next(kTransactions) + "), 'hex');");
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK_REGISTER_F(IndexSchemaFixture, BM_HeightByTxHash)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMicrosecond);
+
+/// PostgresBlockQuery::getBlockIds, heights of blocks with account txs
+BENCHMARK_DEFINE_F(IndexSchemaFixture, BM_HeightsByAccount)
+(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    auto result = transaction_->exec(
+        "SELECT DISTINCT height FROM height_by_account_set WHERE "
+        "account_id = 'user' || "
+        + next(kAccounts) + " || '@test';");
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK_REGISTER_F(IndexSchemaFixture, BM_HeightsByAccount)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMicrosecond);
+
+/// PostgresBlockQuery::getAccountTransactions, tx indexes in one block
+BENCHMARK_DEFINE_F(IndexSchemaFixture, BM_IndexesByCreatorHeight)
+(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    auto result = transaction_->exec(
+        "SELECT DISTINCT index FROM index_by_creator_height WHERE "
+        "creator_id = 'user' || "
+        + next(kAccounts) + " || '@test' AND height = "
+        + transaction_->quote(
+              std::to_string(next_ % (kTransactions / kTransactionsPerBlock)
+                             + 1))
+        + ";");
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK_REGISTER_F(IndexSchemaFixture, BM_IndexesByCreatorHeight)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
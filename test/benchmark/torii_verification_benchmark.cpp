@@ -0,0 +1,110 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+///
+/// Throughput of stateless validation of received transactions in the
+/// Torii verification pool depending on the number of worker threads.
+///
+/// Every transaction carries several signatures, so signature verification
+/// dominates. Items per second are expected to grow with the number of
+/// workers up to the number of cores.
+///
+
+#include <algorithm>
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "builders/protobuf/transaction.hpp"
+#include "builders/protobuf/transport_builder.hpp"
+#include "cryptography/crypto_provider/crypto_defaults.hpp"
+#include "cryptography/crypto_provider/crypto_signer.hpp"
+#include "datetime/time.hpp"
+#include "timer/executor.hpp"
+#include "validators/default_validator.hpp"
+
+const size_t kTransactions = 1000;
+const size_t kSignatures = 4;
+
+class VerificationFixture : public benchmark::Fixture {
+ public:
+  void SetUp(const benchmark::State &) override {
+    std::vector<shared_model::crypto::Keypair> keypairs;
+    for (size_t i = 0; i < kSignatures; ++i) {
+      keypairs.push_back(shared_model::crypto::DefaultCryptoAlgorithmType::
+                             generateKeypair());
+    }
+
+    const std::string account_id = "admin@test";
+    transactions_.clear();
+    for (size_t i = 0; i < kTransactions; ++i) {
+      auto tx = shared_model::proto::TransactionBuilder()
+                    .creatorAccountId(account_id)
+                    .txCounter(i + 1)
+                    .createdTime(iroha::time::now())
+                    .setAccountQuorum(account_id, kSignatures)
+                    .build()
+                    .signAndAddSignature(keypairs.front());
+      for (size_t k = 1; k < kSignatures; ++k) {
+        tx.addSignature(
+            shared_model::crypto::CryptoSigner<>::sign(
+                shared_model::crypto::Blob(tx.payload()), keypairs.at(k)),
+            keypairs.at(k).publicKey());
+      }
+      transactions_.push_back(tx.getTransport());
+    }
+  }
+
+  std::vector<iroha::protocol::Transaction> transactions_;
+};
+
+BENCHMARK_DEFINE_F(VerificationFixture, VerifyTransactions)
+(benchmark::State &state) {
+  iroha::timer::Executor pool(state.range(0), kTransactions);
+  while (state.KeepRunning()) {
+    std::atomic<size_t> left(kTransactions);
+    std::mutex mutex;
+    std::condition_variable done;
+
+    for (const auto &tx : transactions_) {
+      pool.submit([&] {
+        auto result = shared_model::proto::TransportBuilder<
+                          shared_model::proto::Transaction,
+                          shared_model::validation::
+                              DefaultSignableTransactionValidator>()
+                          .build(tx);
+        benchmark::DoNotOptimize(result);
+        if (--left == 0) {
+          std::lock_guard<std::mutex> lock(mutex);
+          done.notify_one();
+        }
+      });
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&left] { return left == 0; });
+  }
+  state.SetItemsProcessed(state.iterations() * kTransactions);
+}
+BENCHMARK_REGISTER_F(VerificationFixture, VerifyTransactions)
+    ->DenseRange(1, std::max(1u, std::thread::hardware_concurrency()))
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
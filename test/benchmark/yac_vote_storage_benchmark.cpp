@@ -0,0 +1,73 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+///
+/// Throughput of YacVoteStorage::store depending on the number of rounds
+/// kept in the storage.
+///
+/// Each iteration votes a new round of 64 peers, so the storage is at its
+/// window size and the oldest round is removed on every iteration. The time
+/// per iteration is expected to stay flat with the growth of the window.
+///
+
+#include <benchmark/benchmark.h>
+
+#include "consensus/yac/storage/yac_vote_storage.hpp"
+
+using namespace iroha::consensus::yac;
+
+class YacVoteStorageFixture : public benchmark::Fixture {
+ public:
+  void SetUp(const benchmark::State &state) override {
+    storage_ = std::make_unique<YacVoteStorage>(state.range(0));
+    for (auto i = 0; i < state.range(0); ++i) {
+      voteRound(std::to_string(round_++));
+    }
+  }
+
+  void TearDown(const benchmark::State &) override {
+    storage_.reset();
+  }
+
+  void voteRound(const std::string &proposal) {
+    YacHash hash(proposal, proposal);
+    for (auto peer = 0u; peer < kPeers; ++peer) {
+      VoteMessage vote;
+      vote.hash = hash;
+      vote.signature.pubkey.at(0) = peer;
+      storage_->store(vote, kPeers);
+    }
+  }
+
+  static const uint64_t kPeers = 64;
+  std::unique_ptr<YacVoteStorage> storage_;
+  uint64_t round_ = 0;
+};
+
+BENCHMARK_DEFINE_F(YacVoteStorageFixture, StoreRound)
+(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    voteRound(std::to_string(round_++));
+  }
+  state.SetItemsProcessed(state.iterations() * kPeers);
+}
+BENCHMARK_REGISTER_F(YacVoteStorageFixture, StoreRound)
+    ->RangeMultiplier(4)
+    ->Range(1, 4 << 10)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -96,7 +96,9 @@ class ClientServerTest : public testing::Test {
 
     auto qpi = std::make_shared<iroha::torii::QueryProcessorImpl>(storage);
 
-    EXPECT_CALL(*storage, getWsvQuery()).WillRepeatedly(Return(wsv_query));
+    EXPECT_CALL(*storage, getWsvQuery())
+        .WillRepeatedly(Return(
+            boost::make_optional<std::shared_ptr<WsvQuery>>(wsv_query)));
     EXPECT_CALL(*storage, getBlockQuery()).WillRepeatedly(Return(block_query));
 
     //----------- Server run ----------------
@@ -117,6 +117,7 @@ DROP TABLE IF EXISTS signatory;
 DROP TABLE IF EXISTS peer;
 DROP TABLE IF EXISTS role;
 DROP TABLE IF EXISTS height_by_hash;
+DROP TABLE IF EXISTS height_by_block_hash;
 DROP TABLE IF EXISTS height_by_account_set;
 DROP TABLE IF EXISTS index_by_creator_height;
 DROP TABLE IF EXISTS index_by_id_height_asset;
@@ -185,24 +186,37 @@ CREATE TABLE IF NOT EXISTS account_has_grantable_permissions (
 );
 CREATE TABLE IF NOT EXISTS height_by_hash (
     hash bytea,
-    height text
+    height bigint
+);
+CREATE INDEX IF NOT EXISTS height_by_hash_hash_index
+    ON height_by_hash USING hash (hash);
+CREATE TABLE IF NOT EXISTS height_by_block_hash (
+    hash bytea,
+    height bigint NOT NULL,
+    PRIMARY KEY (hash)
 );
 CREATE TABLE IF NOT EXISTS height_by_account_set (
     account_id text,
-    height text
+    height bigint
 );
+CREATE INDEX IF NOT EXISTS height_by_account_set_account_id_height_index
+    ON height_by_account_set (account_id, height);
 CREATE TABLE IF NOT EXISTS index_by_creator_height (
     id serial,
     creator_id text,
-    height text,
-    index text
+    height bigint,
+    index bigint
 );
+CREATE INDEX IF NOT EXISTS index_by_creator_height_creator_id_height_index_index
+    ON index_by_creator_height (creator_id, height, index);
 CREATE TABLE IF NOT EXISTS index_by_id_height_asset (
     id text,
-    height text,
+    height bigint,
     asset_id text,
-    index text
+    index bigint
 );
+CREATE INDEX IF NOT EXISTS index_by_id_height_asset_id_asset_id_height_index_index
+    ON index_by_id_height_asset (id, asset_id, height, index);
 )";
     };
   }  // namespace ametsuchi
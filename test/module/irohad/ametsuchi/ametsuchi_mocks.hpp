@@ -21,6 +21,7 @@
 #include <gmock/gmock.h>
 #include <boost/optional.hpp>
 #include "ametsuchi/block_query.hpp"
+#include "ametsuchi/impl/overlay_storage.hpp"
 #include "ametsuchi/mutable_factory.hpp"
 #include "ametsuchi/mutable_storage.hpp"
 #include "ametsuchi/peer_query.hpp"
@@ -75,6 +76,33 @@ namespace iroha {
                         const std::string &permission_id));
     };
 
+    class MockOverlayStorage : public OverlayStorage {
+     public:
+      MOCK_METHOD1(getAccount,
+                   Result<boost::optional<
+                       std::shared_ptr<shared_model::interface::Account>>>(
+                       const std::string &account_id));
+      MOCK_METHOD1(hasAsset, Result<bool>(const std::string &asset_id));
+      MOCK_METHOD1(hasDomain, Result<bool>(const std::string &domain_id));
+      MOCK_METHOD1(
+          hasSignatory,
+          Result<bool>(const shared_model::interface::types::PubkeyType &));
+      MOCK_METHOD1(getSignatoryAccounts,
+                   Result<std::vector<std::string>>(
+                       const shared_model::interface::types::PubkeyType &));
+      MOCK_METHOD0(
+          getPeers,
+          Result<std::vector<std::shared_ptr<shared_model::interface::Peer>>>());
+      MOCK_METHOD1(normalizeJson,
+                   Result<std::string>(const std::string &json_data));
+      MOCK_METHOD4(setAccountDetail,
+                   Result<std::string>(
+                       const boost::optional<std::string> &json_data,
+                       const std::string &creator_account_id,
+                       const std::string &key,
+                       const std::string &val));
+    };
+
     class MockWsvCommand : public WsvCommand {
      public:
       MOCK_METHOD1(insertRole, WsvCommandResult(const std::string &role_name));
@@ -140,18 +168,20 @@ namespace iroha {
 
     class MockBlockQuery : public BlockQuery {
      public:
-      MOCK_METHOD1(
+      MOCK_METHOD2(
           getAccountTransactions,
           rxcpp::observable<wTransaction>(
-              const shared_model::interface::types::AccountIdType &account_id));
+              const shared_model::interface::types::AccountIdType &account_id,
+              const TxPagination &pagination));
       MOCK_METHOD1(getTxByHashSync,
                    boost::optional<wTransaction>(
                        const shared_model::crypto::Hash &hash));
-      MOCK_METHOD2(
+      MOCK_METHOD3(
           getAccountAssetTransactions,
           rxcpp::observable<wTransaction>(
               const shared_model::interface::types::AccountIdType &account_id,
-              const shared_model::interface::types::AssetIdType &asset_id));
+              const shared_model::interface::types::AssetIdType &asset_id,
+              const TxPagination &pagination));
       MOCK_METHOD1(
           getTransactions,
           rxcpp::observable<boost::optional<wTransaction>>(
@@ -163,6 +193,9 @@ namespace iroha {
                    rxcpp::observable<wBlock>(
                        shared_model::interface::types::HeightType));
       MOCK_METHOD1(getTopBlocks, rxcpp::observable<wBlock>(uint32_t));
+      MOCK_METHOD1(getBlockByHashSync,
+                   boost::optional<wBlock>(
+                       const shared_model::crypto::Hash &hash));
     };
 
     class MockTemporaryFactory : public TemporaryFactory {
@@ -172,6 +205,15 @@ namespace iroha {
           expected::Result<std::unique_ptr<TemporaryWsv>, std::string>(void));
     };
 
+    class MockTemporaryWsv : public TemporaryWsv {
+     public:
+      MOCK_METHOD2(
+          apply,
+          bool(const shared_model::interface::Transaction &,
+               std::function<bool(const shared_model::interface::Transaction &,
+                                  WsvQuery &)>));
+    };
+
     class MockMutableStorage : public MutableStorage {
      public:
       MOCK_METHOD2(
@@ -217,7 +259,8 @@ namespace iroha {
 
     class MockStorage : public Storage {
      public:
-      MOCK_CONST_METHOD0(getWsvQuery, std::shared_ptr<WsvQuery>(void));
+      MOCK_CONST_METHOD0(getWsvQuery,
+                         boost::optional<std::shared_ptr<WsvQuery>>(void));
       MOCK_CONST_METHOD0(getBlockQuery, std::shared_ptr<BlockQuery>(void));
       MOCK_METHOD0(
           createTemporaryWsv,
@@ -231,6 +274,10 @@ namespace iroha {
                    bool(const std::vector<
                         std::shared_ptr<shared_model::interface::Block>> &));
       MOCK_METHOD0(dropStorage, void(void));
+      MOCK_METHOD0(dropWsv, void(void));
+      MOCK_METHOD0(
+          restoreWsvSnapshot,
+          boost::optional<shared_model::interface::types::HeightType>());
 
       void commit(std::unique_ptr<MutableStorage> storage) override {
         doCommit(storage.get());
@@ -21,6 +21,7 @@
 #include "ametsuchi/impl/postgres_ordering_service_persistent_state.hpp"
 #include "ametsuchi/impl/postgres_wsv_query.hpp"
 #include "ametsuchi/impl/wsv_restorer_impl.hpp"
+#include "ametsuchi/impl/wsv_snapshot_store.hpp"
 #include "ametsuchi/mutable_storage.hpp"
 #include "builders/protobuf/transaction.hpp"
 #include "framework/test_subscriber.hpp"
@@ -70,7 +71,7 @@ void validateAccountTransactions(B &&blocks,
                                  int call_count,
                                  int command_count) {
   validateCalls(
-      blocks->getAccountTransactions(account),
+      blocks->getAccountTransactions(account, TxPagination{}),
       [&](const auto &tx) { EXPECT_EQ(tx->commands().size(), command_count); },
       call_count,
       " for " + account);
@@ -92,7 +93,7 @@ void validateAccountAssetTransactions(B &&blocks,
                                       int call_count,
                                       int command_count) {
   validateCalls(
-      blocks->getAccountAssetTransactions(account, asset),
+      blocks->getAccountAssetTransactions(account, asset, TxPagination{}),
       [&](const auto &tx) { EXPECT_EQ(tx->commands().size(), command_count); },
       call_count,
       " for " + account + " " + asset);
@@ -173,9 +174,39 @@ TEST_F(AmetsuchiTest, GetBlocksCompletedWhenCalled) {
   ASSERT_TRUE(completed_wrapper.validate());
 }
 
+/**
+ * @given initialized storage
+ * @when the same block is applied twice
+ * @then the second apply fails since the block hash is already indexed
+ */
+TEST_F(AmetsuchiTest, ApplyFailsOnIndexError) {
+  ASSERT_TRUE(storage);
+  auto block = TestBlockBuilder().height(1).prevHash(fake_hash).build();
+
+  std::unique_ptr<MutableStorage> ms;
+  auto storage_result = storage->createMutableStorage();
+  storage_result.match(
+      [&](iroha::expected::Value<std::unique_ptr<MutableStorage>> &_storage) {
+        ms = std::move(_storage.value);
+      },
+      [](iroha::expected::Error<std::string> &error) {
+        FAIL() << "MutableStorage: " << error.error;
+      });
+  auto apply_block = [&ms, &block] {
+    return ms->apply(block,
+                     [](const auto &, auto &, const auto &) { return true; });
+  };
+  ASSERT_TRUE(apply_block());
+  ASSERT_FALSE(apply_block());
+
+  // failed block is undone, the first one is committed
+  storage->commit(std::move(ms));
+  ASSERT_TRUE(storage->getBlockQuery()->getBlockByHashSync(block.hash()));
+}
+
 TEST_F(AmetsuchiTest, SampleTest) {
   ASSERT_TRUE(storage);
-  auto wsv = storage->getWsvQuery();
+  auto wsv = storage->getWsvQuery().value();
   auto blocks = storage->getBlockQuery();
 
   const auto domain = "ru", user1name = "userone", user2name = "usertwo",
@@ -251,7 +282,7 @@ TEST_F(AmetsuchiTest, SampleTest) {
 }
 
 TEST_F(AmetsuchiTest, PeerTest) {
-  auto wsv = storage->getWsvQuery();
+  auto wsv = storage->getWsvQuery().value();
 
   auto txn = TestTransactionBuilder()
                  .addPeer("192.168.9.1:50051", fake_pubkey)
@@ -275,7 +306,7 @@ TEST_F(AmetsuchiTest, PeerTest) {
 
 TEST_F(AmetsuchiTest, queryGetAccountAssetTransactionsTest) {
   ASSERT_TRUE(storage);
-  auto wsv = storage->getWsvQuery();
+  auto wsv = storage->getWsvQuery().value();
   auto blocks = storage->getBlockQuery();
 
   const auto admin = "admin", domain = "domain", user1name = "userone",
@@ -400,7 +431,7 @@ TEST_F(AmetsuchiTest, queryGetAccountAssetTransactionsTest) {
 
 TEST_F(AmetsuchiTest, AddSignatoryTest) {
   ASSERT_TRUE(storage);
-  auto wsv = storage->getWsvQuery();
+  auto wsv = storage->getWsvQuery().value();
 
   shared_model::crypto::PublicKey pubkey1(std::string("1", 32));
   shared_model::crypto::PublicKey pubkey2(std::string("2", 32));
@@ -610,7 +641,7 @@ TEST_F(AmetsuchiTest, TestingStorageWhenInsertBlock) {
       "=> insert block "
       "=> assert that inserted");
   ASSERT_TRUE(storage);
-  auto wsv = storage->getWsvQuery();
+  auto wsv = storage->getWsvQuery().value();
   ASSERT_EQ(0, wsv->getPeers().value().size());
 
   log->info("Try insert block");
@@ -651,7 +682,7 @@ TEST_F(AmetsuchiTest, TestingStorageWhenDropAll) {
         FAIL() << "StorageImpl: " << error.error;
       });
   ASSERT_TRUE(storage);
-  auto wsv = storage->getWsvQuery();
+  auto wsv = storage->getWsvQuery().value();
   ASSERT_EQ(0, wsv->getPeers().value().size());
 
   log->info("Try insert block");
@@ -890,7 +921,7 @@ TEST_F(AmetsuchiTest, TestRestoreWSV) {
 
   apply(storage, genesis_block);
 
-  auto res = storage->getWsvQuery()->getDomain("test");
+  auto res = storage->getWsvQuery().value()->getDomain("test");
   EXPECT_TRUE(res);
 
   // spoil WSV
@@ -901,7 +932,7 @@ DELETE FROM domain;
   txn.commit();
 
   // check there is no data in WSV
-  res = storage->getWsvQuery()->getDomain("test");
+  res = storage->getWsvQuery().value()->getDomain("test");
   EXPECT_FALSE(res);
 
   // recover storage and check it is recovered
@@ -912,6 +943,174 @@ DELETE FROM domain;
         FAIL() << "Failed to recover WSV";
       });
 
-  res = storage->getWsvQuery()->getDomain("test");
+  res = storage->getWsvQuery().value()->getDomain("test");
   EXPECT_TRUE(res);
 }
+
+/**
+ * @given storage with several blocks and spoiled WSV
+ * @when WSV is restored with short queues and intermediate commits
+ * @then WSV is valid and the block store is kept
+ */
+TEST_F(AmetsuchiTest, TestRestoreWSVWithIntermediateCommits) {
+  const auto domain = "ru", user1name = "userone", user2name = "usertwo",
+             user1id = "userone@ru", user2id = "usertwo@ru";
+
+  auto block1 =
+      TestBlockBuilder()
+          .transactions(std::vector<shared_model::proto::Transaction>(
+              {TestTransactionBuilder()
+                   .creatorAccountId("admin1")
+                   .createRole(
+                       "user",
+                       shared_model::interface::types::PermissionSetType{
+                           iroha::model::can_create_asset})
+                   .createDomain(domain, "user")
+                   .build()}))
+          .height(1)
+          .prevHash(fake_hash)
+          .build();
+  apply(storage, block1);
+
+  auto block2 =
+      TestBlockBuilder()
+          .transactions(std::vector<shared_model::proto::Transaction>(
+              {TestTransactionBuilder()
+                   .creatorAccountId("admin1")
+                   .createAccount(user1name, domain, fake_pubkey)
+                   .build()}))
+          .height(2)
+          .prevHash(block1.hash())
+          .build();
+  apply(storage, block2);
+
+  auto block3 =
+      TestBlockBuilder()
+          .transactions(std::vector<shared_model::proto::Transaction>(
+              {TestTransactionBuilder()
+                   .creatorAccountId("admin1")
+                   .createAccount(user2name, domain, fake_pubkey)
+                   .build()}))
+          .height(3)
+          .prevHash(block2.hash())
+          .build();
+  apply(storage, block3);
+
+  // spoil WSV
+  pqxx::work txn(*connection);
+  txn.exec(R"(
+DELETE FROM account_has_signatory;
+DELETE FROM account_has_roles;
+DELETE FROM account;
+)");
+  txn.commit();
+  ASSERT_FALSE(storage->getWsvQuery().value()->getAccount(user1id));
+
+  // blocks 1 and 2 are committed together, block 3 separately
+  WsvRestorerImpl wsv_restorer(1, 2);
+  wsv_restorer.restoreWsv(*storage).match(
+      [](iroha::expected::Value<void>) {},
+      [&](iroha::expected::Error<std::string> &error) {
+        FAIL() << "Failed to recover WSV: " << error.error;
+      });
+
+  validateAccount(storage->getWsvQuery().value(), user1id, domain);
+  validateAccount(storage->getWsvQuery().value(), user2id, domain);
+
+  auto hashes = {block1.hash(), block2.hash(), block3.hash()};
+  validateCalls(storage->getBlockQuery()->getBlocksFrom(1),
+                [i = 0, &hashes](auto block) mutable {
+                  EXPECT_EQ(*(hashes.begin() + i), block->hash());
+                  ++i;
+                },
+                3);
+}
+
+/**
+ * @given storage which takes WSV snapshot every 2 blocks
+ * @when 3 blocks are committed, WSV is spoiled and restored
+ * @then snapshot is taken at height 2
+ * AND WSV is restored from the snapshot and block 3
+ */
+TEST_F(AmetsuchiTest, TestRestoreWSVFromSnapshot) {
+  const auto domain = "ru", user1name = "userone", user2name = "usertwo",
+             user1id = "userone@ru", user2id = "usertwo@ru";
+
+  std::shared_ptr<StorageImpl> snapshot_storage;
+  StorageImpl::create(block_store_path, pgopt_, 2)
+      .match(
+          [&](iroha::expected::Value<std::shared_ptr<StorageImpl>> &_storage) {
+            snapshot_storage = _storage.value;
+          },
+          [](iroha::expected::Error<std::string> &error) {
+            FAIL() << "StorageImpl: " << error.error;
+          });
+  ASSERT_TRUE(snapshot_storage);
+
+  auto block1 =
+      TestBlockBuilder()
+          .transactions(std::vector<shared_model::proto::Transaction>(
+              {TestTransactionBuilder()
+                   .creatorAccountId("admin1")
+                   .createRole(
+                       "user",
+                       shared_model::interface::types::PermissionSetType{
+                           iroha::model::can_create_asset})
+                   .createDomain(domain, "user")
+                   .build()}))
+          .height(1)
+          .prevHash(fake_hash)
+          .build();
+  apply(snapshot_storage, block1);
+
+  auto block2 =
+      TestBlockBuilder()
+          .transactions(std::vector<shared_model::proto::Transaction>(
+              {TestTransactionBuilder()
+                   .creatorAccountId("admin1")
+                   .createAccount(user1name, domain, fake_pubkey)
+                   .build()}))
+          .height(2)
+          .prevHash(block1.hash())
+          .build();
+  apply(snapshot_storage, block2);
+
+  auto block3 =
+      TestBlockBuilder()
+          .transactions(std::vector<shared_model::proto::Transaction>(
+              {TestTransactionBuilder()
+                   .creatorAccountId("admin1")
+                   .createAccount(user2name, domain, fake_pubkey)
+                   .build()}))
+          .height(3)
+          .prevHash(block2.hash())
+          .build();
+  apply(snapshot_storage, block3);
+
+  // spoil WSV
+  pqxx::work txn(*connection);
+  txn.exec(R"(
+DELETE FROM account_has_signatory;
+DELETE FROM account_has_roles;
+DELETE FROM account;
+)");
+  txn.commit();
+  ASSERT_FALSE(snapshot_storage->getWsvQuery().value()->getAccount(user1id));
+
+  WsvRestorerImpl wsv_restorer;
+  wsv_restorer.restoreWsv(*snapshot_storage)
+      .match([](iroha::expected::Value<void>) {},
+             [&](iroha::expected::Error<std::string> &error) {
+               FAIL() << "Failed to recover WSV: " << error.error;
+             });
+
+  auto snapshots = WsvSnapshotStore::create(block_store_path + "_snapshots");
+  ASSERT_TRUE(snapshots);
+  ASSERT_EQ(std::vector<shared_model::interface::types::HeightType>{2},
+            (*snapshots)->heights());
+
+  validateAccount(snapshot_storage->getWsvQuery().value(), user1id, domain);
+  validateAccount(snapshot_storage->getWsvQuery().value(), user2id, domain);
+
+  snapshot_storage->dropStorage();
+}
@@ -46,7 +46,9 @@ class BlockQueryTest : public AmetsuchiTest {
         *postgres_connection, "Postgres block indexes");
 
     index = std::make_shared<PostgresBlockIndex>(*transaction);
-    blocks = std::make_shared<PostgresBlockQuery>(*transaction, *file);
+    block_cache = std::make_shared<BlockCache>(block_cache_size);
+    blocks =
+        std::make_shared<PostgresBlockQuery>(*transaction, *file, block_cache);
 
     transaction->exec(init_);
 
@@ -83,14 +85,9 @@ class BlockQueryTest : public AmetsuchiTest {
             .build();
 
     for (const auto &b : {block1, block2}) {
-      // TODO IR-975 victordrobny 12.02.2018 convert from
-      // shared_model::proto::Block after FlatFile will be reworked to new
-      // model
-      auto old_block = *std::unique_ptr<iroha::model::Block>(b.makeOldModel());
-      file->add(b.height(),
-                iroha::stringToBytes(iroha::model::converters::jsonToString(
-                    iroha::model::converters::JsonBlockFactory().serialize(old_block))));
-      index->index(b);
+      file->add(b.height(), BlockSerializer().serialize(b));
+      ASSERT_TRUE(index->index(b));
+      block_hashes.push_back(b.hash());
       blocks_total++;
     }
   }
@@ -98,7 +95,10 @@ class BlockQueryTest : public AmetsuchiTest {
   std::unique_ptr<pqxx::lazyconnection> postgres_connection;
   std::unique_ptr<pqxx::nontransaction> transaction;
   std::vector<shared_model::crypto::Hash> tx_hashes;
+  std::vector<shared_model::crypto::Hash> block_hashes;
   std::shared_ptr<BlockQuery> blocks;
+  std::shared_ptr<BlockCache> block_cache;
+  const size_t block_cache_size = 2;
   std::shared_ptr<BlockIndex> index;
   std::unique_ptr<FlatFile> file;
   std::string creator1 = "user1@test";
@@ -117,7 +117,7 @@ class BlockQueryTest : public AmetsuchiTest {
 TEST_F(BlockQueryTest, GetAccountTransactionsFromSeveralBlocks) {
   // Check that creator1 has created 3 transactions
   auto getCreator1TxWrapper = make_test_subscriber<CallExact>(
-      blocks->getAccountTransactions(creator1), 3);
+      blocks->getAccountTransactions(creator1, TxPagination{}), 3);
   getCreator1TxWrapper.subscribe(
       [this](auto val) { EXPECT_EQ(val->creatorAccountId(), creator1); });
   ASSERT_TRUE(getCreator1TxWrapper.validate());
@@ -133,7 +133,7 @@ TEST_F(BlockQueryTest, GetAccountTransactionsFromSeveralBlocks) {
 TEST_F(BlockQueryTest, GetAccountTransactionsFromSingleBlock) {
   // Check that creator1 has created 1 transaction
   auto getCreator2TxWrapper = make_test_subscriber<CallExact>(
-      blocks->getAccountTransactions(creator2), 1);
+      blocks->getAccountTransactions(creator2, TxPagination{}), 1);
   getCreator2TxWrapper.subscribe(
       [this](auto val) { EXPECT_EQ(val->creatorAccountId(), creator2); });
   ASSERT_TRUE(getCreator2TxWrapper.validate());
@@ -148,11 +148,53 @@ TEST_F(BlockQueryTest, GetAccountTransactionsFromSingleBlock) {
 TEST_F(BlockQueryTest, GetAccountTransactionsNonExistingUser) {
   // Check that "nonexisting" user has no transaction
   auto getNonexistingTxWrapper = make_test_subscriber<CallExact>(
-      blocks->getAccountTransactions("nonexisting user"), 0);
+      blocks->getAccountTransactions("nonexisting user", TxPagination{}), 0);
   getNonexistingTxWrapper.subscribe();
   ASSERT_TRUE(getNonexistingTxWrapper.validate());
 }
 
+/**
+ * @given block store with 2 blocks totally containing 3 txs created by
+ * user1@test
+ * @when transactions of user1@test are requested by pages of 2 txs
+ * @then first page contains 2 txs of the first block, second page contains
+ * the remaining tx of the second block
+ */
+TEST_F(BlockQueryTest, GetAccountTransactionsByPages) {
+  TxPagination pagination;
+  pagination.page_size = 2;
+
+  auto first_page = make_test_subscriber<CallExact>(
+      blocks->getAccountTransactions(creator1, pagination), 2);
+  size_t i = 0;
+  first_page.subscribe(
+      [this, &i](auto val) { EXPECT_EQ(val->hash(), tx_hashes.at(i++)); });
+  ASSERT_TRUE(first_page.validate());
+
+  pagination.last_tx_hash = tx_hashes.at(1);
+  auto second_page = make_test_subscriber<CallExact>(
+      blocks->getAccountTransactions(creator1, pagination), 1);
+  second_page.subscribe(
+      [this](auto val) { EXPECT_EQ(val->hash(), tx_hashes.at(2)); });
+  ASSERT_TRUE(second_page.validate());
+}
+
+/**
+ * @given block store
+ * @when transactions following a transaction which is not in the ledger
+ * are requested
+ * @then query returns empty result
+ */
+TEST_F(BlockQueryTest, GetAccountTransactionsAfterNonexistentTx) {
+  TxPagination pagination;
+  pagination.last_tx_hash = shared_model::crypto::Hash(std::string(32, '0'));
+
+  auto wrapper = make_test_subscriber<CallExact>(
+      blocks->getAccountTransactions(creator1, pagination), 0);
+  wrapper.subscribe();
+  ASSERT_TRUE(wrapper.validate());
+}
+
 /**
  * @given block store with 2 blocks totally containing 3 txs created by
  * user1@test
@@ -302,21 +344,17 @@ TEST_F(BlockQueryTest, GetBlocksFrom1) {
 
 /**
  * @given block store with 2 blocks totally containing 3 txs created by
- * user1@test AND 1 tx created by user2@test. Block #1 is filled with trash data
+ * user1@test AND 1 tx created by user2@test. Block #3 is filled with trash data
  * (NOT JSON).
- * @when read block #1
+ * @when read block #3
  * @then get no blocks
  */
 TEST_F(BlockQueryTest, GetBlockButItIsNotJSON) {
-  namespace fs = boost::filesystem;
-  size_t block_n = 1;
+  size_t block_n = 3;
 
-  // write something that is NOT JSON to block #1
-  auto block_path = fs::path{block_store_path} / FlatFile::id_to_name(block_n);
-  fs::ofstream block_file(block_path);
+  // write something that is NOT JSON to block #3
   std::string content = R"(this is definitely not json)";
-  block_file << content;
-  block_file.close();
+  ASSERT_TRUE(file->add(block_n, iroha::stringToBytes(content)));
 
   auto wrapper =
       make_test_subscriber<CallExact>(blocks->getBlocks(block_n, 1), 0);
@@ -327,24 +365,20 @@ TEST_F(BlockQueryTest, GetBlockButItIsNotJSON) {
 
 /**
  * @given block store with 2 blocks totally containing 3 txs created by
- * user1@test AND 1 tx created by user2@test. Block #1 is filled with trash data
+ * user1@test AND 1 tx created by user2@test. Block #3 is filled with trash data
  * (NOT JSON).
- * @when read block #1
+ * @when read block #3
  * @then get no blocks
  */
 TEST_F(BlockQueryTest, GetBlockButItIsInvalidBlock) {
-  namespace fs = boost::filesystem;
-  size_t block_n = 1;
+  size_t block_n = 3;
 
-  // write bad block instead of block #1
-  auto block_path = fs::path{block_store_path} / FlatFile::id_to_name(block_n);
-  fs::ofstream block_file(block_path);
+  // write bad block as block #3
   std::string content = R"({
   "testcase": [],
   "description": "make sure this is valid json, but definitely not a block"
 })";
-  block_file << content;
-  block_file.close();
+  ASSERT_TRUE(file->add(block_n, iroha::stringToBytes(content)));
 
   auto wrapper =
       make_test_subscriber<CallExact>(blocks->getBlocks(block_n, 1), 0);
@@ -370,3 +404,68 @@ TEST_F(BlockQueryTest, GetTop2Blocks) {
 
   ASSERT_TRUE(wrapper.validate());
 }
+
+/**
+ * @given block store with 2 blocks
+ * @when the same block is requested twice
+ * @then block is read from block store once and then taken from cache
+ */
+TEST_F(BlockQueryTest, GetBlockFromCache) {
+  for (auto i = 0; i < 2; ++i) {
+    auto wrapper = make_test_subscriber<CallExact>(blocks->getBlocks(1, 1), 1);
+    wrapper.subscribe([](auto b) { ASSERT_EQ(b->height(), 1); });
+    ASSERT_TRUE(wrapper.validate());
+  }
+
+  ASSERT_EQ(block_cache->misses(), 1);
+  ASSERT_EQ(block_cache->hits(), 1);
+}
+
+/**
+ * @given block store with 2 blocks
+ * @when the same block is requested by hash twice
+ * @then both requests return the cached block without copying it
+ */
+TEST_F(BlockQueryTest, CachedBlockIsShared) {
+  auto first = blocks->getBlockByHashSync(block_hashes.front());
+  auto second = blocks->getBlockByHashSync(block_hashes.front());
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+  ASSERT_EQ(first->get(), second->get());
+}
+
+/**
+ * @given block store with 2 blocks
+ * @when block is requested by hash
+ * @then the block with this hash is returned
+ */
+TEST_F(BlockQueryTest, GetBlockByHash) {
+  for (size_t i = 0; i < block_hashes.size(); ++i) {
+    auto block = blocks->getBlockByHashSync(block_hashes[i]);
+    ASSERT_TRUE(block);
+    ASSERT_EQ((*block)->height(), i + 1);
+    ASSERT_EQ((*block)->hash(), block_hashes[i]);
+  }
+}
+
+/**
+ * @given block store with 2 blocks
+ * @when block is requested by a hash which is not in the ledger
+ * @then nothing is returned
+ */
+TEST_F(BlockQueryTest, GetBlockByNonexistentHash) {
+  auto block = blocks->getBlockByHashSync(
+      shared_model::crypto::Hash(std::string(32, '0')));
+  ASSERT_FALSE(block);
+}
+
+/**
+ * @given block store with 2 blocks
+ * @when one of the blocks is indexed again
+ * @then indexing fails since the block hash is already indexed
+ */
+TEST_F(BlockQueryTest, IndexDuplicateBlock) {
+  auto block = blocks->getBlockByHashSync(block_hashes.front());
+  ASSERT_TRUE(block);
+  ASSERT_FALSE(index->index(**block));
+}
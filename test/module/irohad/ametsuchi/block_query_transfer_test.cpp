@@ -53,16 +53,8 @@ namespace iroha {
       }
 
       void insert(const shared_model::interface::Block &block) {
-        // TODO IR-975 victordrobny 12.02.2018 convert from
-        // shared_model::proto::Block after FlatFile will be reworked to new
-        // model
-        auto old_block =
-            *std::unique_ptr<iroha::model::Block>(block.makeOldModel());
-        file->add(
-            block.height(),
-            iroha::stringToBytes(model::converters::jsonToString(
-                model::converters::JsonBlockFactory().serialize(old_block))));
-        index->index(block);
+        file->add(block.height(), BlockSerializer().serialize(block));
+        ASSERT_TRUE(index->index(block));
       }
 
       std::unique_ptr<pqxx::lazyconnection> postgres_connection;
@@ -142,7 +134,7 @@ namespace iroha {
       insert(block);
 
       auto wrapper = make_test_subscriber<CallExact>(
-          blocks->getAccountAssetTransactions(creator1, asset), 1);
+          blocks->getAccountAssetTransactions(creator1, asset, TxPagination{}), 1);
       wrapper.subscribe(
           [this](auto val) { ASSERT_EQ(tx_hashes.at(0), val->hash()); });
       ASSERT_TRUE(wrapper.validate());
@@ -160,7 +152,7 @@ namespace iroha {
       insert(block);
 
       auto wrapper = make_test_subscriber<CallExact>(
-          blocks->getAccountAssetTransactions(creator2, asset), 1);
+          blocks->getAccountAssetTransactions(creator2, asset, TxPagination{}), 1);
       wrapper.subscribe(
           [this](auto val) { ASSERT_EQ(tx_hashes.at(0), val->hash()); });
       ASSERT_TRUE(wrapper.validate());
@@ -178,7 +170,7 @@ namespace iroha {
       insert(block);
 
       auto wrapper = make_test_subscriber<CallExact>(
-          blocks->getAccountAssetTransactions(creator3, asset), 1);
+          blocks->getAccountAssetTransactions(creator3, asset, TxPagination{}), 1);
       wrapper.subscribe(
           [this](auto val) { ASSERT_EQ(tx_hashes.at(0), val->hash()); });
       ASSERT_TRUE(wrapper.validate());
@@ -202,7 +194,7 @@ namespace iroha {
       insert(block2);
 
       auto wrapper = make_test_subscriber<CallExact>(
-          blocks->getAccountAssetTransactions(creator1, asset), 2);
+          blocks->getAccountAssetTransactions(creator1, asset, TxPagination{}), 2);
       wrapper.subscribe([ i = 0, this ](auto val) mutable {
         ASSERT_EQ(tx_hashes.at(i), val->hash());
         ++i;
@@ -0,0 +1,179 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/block_serializer.hpp"
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include "ametsuchi/impl/block_store_migration.hpp"
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "model/converters/json_common.hpp"
+#include "module/shared_model/builders/protobuf/test_block_builder.hpp"
+#include "module/shared_model/builders/protobuf/test_transaction_builder.hpp"
+
+using namespace iroha::ametsuchi;
+namespace fs = boost::filesystem;
+
+class BlockSerializerTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    fs::remove_all(block_store_path);
+    fs::remove_all(block_store_path + ".legacy");
+  }
+
+  shared_model::proto::Block makeBlock(
+      shared_model::interface::types::HeightType height) {
+    auto tx = TestTransactionBuilder().creatorAccountId("user@test").build();
+    return TestBlockBuilder()
+        .height(height)
+        .transactions(std::vector<shared_model::proto::Transaction>({tx}))
+        .prevHash(shared_model::crypto::Hash(std::string(32, '0')))
+        .build();
+  }
+
+  std::vector<uint8_t> toJson(const shared_model::interface::Block &block) {
+    auto old_block =
+        *std::unique_ptr<iroha::model::Block>(block.makeOldModel());
+    return iroha::stringToBytes(iroha::model::converters::jsonToString(
+        iroha::model::converters::JsonBlockFactory().serialize(old_block)));
+  }
+
+  BlockSerializer serializer;
+  std::string block_store_path =
+      (fs::temp_directory_path() / fs::unique_path()).string();
+};
+
+/**
+ * @given block
+ * @when block is serialized and deserialized back
+ * @then deserialized block has the same hash
+ */
+TEST_F(BlockSerializerTest, BinaryRoundTrip) {
+  auto block = makeBlock(1);
+  auto bytes = serializer.serialize(block);
+  ASSERT_FALSE(BlockSerializer::isLegacy(bytes));
+
+  auto result = serializer.deserialize(bytes);
+  ASSERT_TRUE(result);
+  ASSERT_EQ(result->hash(), block.hash());
+}
+
+/**
+ * @given block serialized in the legacy JSON format
+ * @when record is deserialized
+ * @then block with the same content is returned
+ */
+TEST_F(BlockSerializerTest, LegacyJson) {
+  auto block = makeBlock(1);
+  auto bytes = toJson(block);
+  ASSERT_TRUE(BlockSerializer::isLegacy(bytes));
+
+  auto result = serializer.deserialize(bytes);
+  ASSERT_TRUE(result);
+  ASSERT_EQ(result->height(), block.height());
+  ASSERT_EQ(result->transactions().size(), block.transactions().size());
+}
+
+/**
+ * @given binary record with unknown format version
+ * @when record is deserialized
+ * @then deserialization fails
+ */
+TEST_F(BlockSerializerTest, UnknownVersion) {
+  auto bytes = serializer.serialize(makeBlock(1));
+  bytes[BlockSerializer::kMagic.size()] = BlockSerializer::kVersion + 1;
+
+  ASSERT_FALSE(serializer.deserialize(bytes));
+}
+
+/**
+ * @given block store with blocks in both legacy and binary formats
+ * @when block store is migrated
+ * @then all blocks are stored in binary format and can be read back
+ */
+TEST_F(BlockSerializerTest, MigrateBlockStore) {
+  auto first = makeBlock(1);
+  auto second = makeBlock(2);
+  {
+    auto store = FlatFile::create(block_store_path);
+    ASSERT_TRUE(store);
+    ASSERT_TRUE((*store)->add(1, toJson(first)));
+    ASSERT_TRUE((*store)->add(2, serializer.serialize(second)));
+  }
+
+  auto result = migrateBlockStore(block_store_path);
+  result.match(
+      [](const iroha::expected::Value<size_t> &converted) {
+        ASSERT_EQ(converted.value, 1);
+      },
+      [](const iroha::expected::Error<std::string> &error) {
+        FAIL() << error.error;
+      });
+
+  auto store = FlatFile::create(block_store_path);
+  ASSERT_TRUE(store);
+  ASSERT_EQ((*store)->last_id(), 2);
+  for (FlatFile::Identifier id = 1; id <= 2; ++id) {
+    auto bytes = (*store)->get(id);
+    ASSERT_TRUE(bytes);
+    ASSERT_FALSE(BlockSerializer::isLegacy(*bytes));
+    ASSERT_TRUE(serializer.deserialize(*bytes));
+  }
+  auto migrated = serializer.deserialize(*(*store)->get(2));
+  ASSERT_EQ(migrated->hash(), second.hash());
+
+  // original store is kept, and prevents the next migration
+  ASSERT_TRUE(fs::is_directory(block_store_path + ".legacy"));
+  ASSERT_FALSE(migrateBlockStore(block_store_path).match(
+      [](const iroha::expected::Value<size_t> &) { return true; },
+      [](const iroha::expected::Error<std::string> &) { return false; }));
+}
+
+/**
+ * @given block store in one-file-per-block layout with legacy JSON blocks
+ * @when block store is migrated
+ * @then block store is opened by FlatFile and all blocks are available
+ */
+TEST_F(BlockSerializerTest, MigrateLegacyLayout) {
+  fs::create_directory(block_store_path);
+  std::vector<shared_model::proto::Block> blocks{makeBlock(1), makeBlock(2)};
+  for (const auto &block : blocks) {
+    auto bytes = toJson(block);
+    fs::ofstream file(fs::path{block_store_path}
+                      / FlatFile::id_to_name(block.height()));
+    file.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+  }
+  ASSERT_FALSE(FlatFile::create(block_store_path));
+
+  auto result = migrateBlockStore(block_store_path);
+  result.match(
+      [](const iroha::expected::Value<size_t> &converted) {
+        ASSERT_EQ(converted.value, 2);
+      },
+      [](const iroha::expected::Error<std::string> &error) {
+        FAIL() << error.error;
+      });
+
+  auto store = FlatFile::create(block_store_path);
+  ASSERT_TRUE(store);
+  ASSERT_EQ((*store)->last_id(), 2);
+  for (const auto &block : blocks) {
+    auto migrated = serializer.deserialize(*(*store)->get(block.height()));
+    ASSERT_TRUE(migrated);
+    ASSERT_EQ(migrated->height(), block.height());
+  }
+}
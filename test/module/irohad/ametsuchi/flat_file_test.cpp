@@ -39,6 +39,11 @@ class BlStore_Test : public ::testing::Test {
   void TearDown() override {
     fs::remove_all(block_store_path);
   }
+  std::string segment_path(Identifier first_id) {
+    return (fs::path(block_store_path)
+            / (FlatFile::id_to_name(first_id) + ".seg"))
+        .string();
+  }
   std::string block_store_path =
       (fs::temp_directory_path() / fs::unique_path()).string();
   std::vector<uint8_t> block;
@@ -62,9 +67,9 @@ TEST_F(BlStore_Test, Read_Write_Test) {
   ASSERT_EQ(*res, block);
 }
 
-TEST_F(BlStore_Test, BlockStoreWhenRemoveBlock) {
-  log_->info("----------| Simulate removal of the block |----------");
-  // Remove file in the middle of the block store
+TEST_F(BlStore_Test, BlockStoreWhenTornTail) {
+  log_->info("----------| Simulate torn write of the block |----------");
+  // Cut the end of the last record in the block store
   {
     log_->info(
         "----------| create blockstore and insert 3 elements "
@@ -83,13 +88,90 @@ TEST_F(BlStore_Test, BlockStoreWhenRemoveBlock) {
     bl_store->add(id3, block);
   }
 
-  log_->info("----------| remove second and init new storage |----------");
-  fs::remove(fs::path(block_store_path) / "0000000000000002");
+  log_->info("----------| truncate third and init new storage |----------");
+  auto segment = segment_path(1);
+  fs::resize_file(segment, fs::file_size(segment) - 10);
   auto store = FlatFile::create(block_store_path);
   ASSERT_TRUE(store);
   auto bl_store = std::move(*store);
   auto res = bl_store->last_id();
-  ASSERT_EQ(res, 1);
+  ASSERT_EQ(res, 2);
+  ASSERT_EQ(*bl_store->get(2), block);
+
+  // storage can be appended after recovery
+  ASSERT_TRUE(bl_store->add(3, block));
+  ASSERT_EQ(*bl_store->get(3), block);
+}
+
+/**
+ * @given block store with three blocks
+ * @when index of segment is removed
+ * @then index is rebuilt from segment and all blocks are available
+ */
+TEST_F(BlStore_Test, BlockStoreWhenIndexIsLost) {
+  {
+    auto store = FlatFile::create(block_store_path);
+    ASSERT_TRUE(store);
+    for (auto id = 1u; id <= 3; ++id) {
+      ASSERT_TRUE((*store)->add(id, block));
+    }
+  }
+
+  fs::remove(fs::path(segment_path(1)).replace_extension(".idx"));
+  auto store = FlatFile::create(block_store_path);
+  ASSERT_TRUE(store);
+  ASSERT_EQ((*store)->last_id(), 3);
+  ASSERT_EQ(*(*store)->get(3), block);
+}
+
+/**
+ * @given block store with segment size less than size of a block
+ * @when several blocks are added
+ * @then every block is written to its own segment and all of them are
+ * available after restart
+ */
+TEST_F(BlStore_Test, SegmentRollover) {
+  {
+    auto store = FlatFile::create(block_store_path, block.size());
+    ASSERT_TRUE(store);
+    for (auto id = 1u; id <= 3; ++id) {
+      ASSERT_TRUE((*store)->add(id, block));
+      ASSERT_EQ(*(*store)->get(id), block);
+    }
+    for (auto id = 1u; id <= 3; ++id) {
+      ASSERT_TRUE(fs::exists(segment_path(id)));
+    }
+  }
+
+  auto store = FlatFile::create(block_store_path, block.size());
+  ASSERT_TRUE(store);
+  ASSERT_EQ((*store)->last_id(), 3);
+  for (auto id = 1u; id <= 3; ++id) {
+    ASSERT_EQ(*(*store)->get(id), block);
+  }
+  ASSERT_TRUE((*store)->add(4, block));
+  ASSERT_EQ(*(*store)->get(4), block);
+}
+
+/**
+ * @given block store with segments 1, 2 and 3
+ * @when second segment is removed
+ * @then segments following the gap are removed as well
+ */
+TEST_F(BlStore_Test, BlockStoreWhenRemoveSegment) {
+  {
+    auto store = FlatFile::create(block_store_path, block.size());
+    ASSERT_TRUE(store);
+    for (auto id = 1u; id <= 3; ++id) {
+      ASSERT_TRUE((*store)->add(id, block));
+    }
+  }
+
+  fs::remove(segment_path(2));
+  auto store = FlatFile::create(block_store_path, block.size());
+  ASSERT_TRUE(store);
+  ASSERT_EQ((*store)->last_id(), 1);
+  ASSERT_FALSE(fs::exists(segment_path(3)));
 }
 
 TEST_F(BlStore_Test, BlockStoreWhenAbsentFolder) {
@@ -130,6 +212,26 @@ TEST_F(BlStore_Test, BlockStoreInitializationFromNonemptyFolder) {
   ASSERT_EQ(bl_store1->last_id(), bl_store2->last_id());
 }
 
+/**
+ * @given block storage with blocks written before restart
+ * @when storage is reopened and more blocks are appended to the same segment
+ * @then all blocks are read back
+ */
+TEST_F(BlStore_Test, AppendAfterReopen) {
+  {
+    auto store = FlatFile::create(block_store_path);
+    ASSERT_TRUE(store);
+    ASSERT_TRUE((*store)->add(1u, std::vector<uint8_t>(1000, 1)));
+  }
+  auto store = FlatFile::create(block_store_path);
+  ASSERT_TRUE(store);
+  ASSERT_TRUE((*store)->add(2u, std::vector<uint8_t>(1000, 2)));
+
+  ASSERT_EQ(std::vector<uint8_t>(1000, 1), *(*store)->get(1u));
+  ASSERT_EQ(std::vector<uint8_t>(1000, 2), *(*store)->get(2u));
+  ASSERT_EQ(2u, *FlatFile::check_consistency(block_store_path));
+}
+
 /**
  * @given empty folder name
  * @then check consistency fails
@@ -167,25 +269,28 @@ TEST_F(BlStore_Test, GetDirectory) {
 
 /**
  * @given block store with one entry
- * @when user has not enough permissions
+ * @when entry is corrupted on disk
  * @then get() fails
  */
-TEST_F(BlStore_Test, GetDeniedBlock) {
+TEST_F(BlStore_Test, GetCorruptedBlock) {
   auto store = FlatFile::create(block_store_path);
   ASSERT_TRUE(store);
   auto bl_store = std::move(*store);
   auto id = 1u;
   bl_store->add(id, block);
 
-  auto filename = fs::path(block_store_path) / FlatFile::id_to_name(id);
+  std::fstream segment(segment_path(id),
+                       std::ios::in | std::ios::out | std::ios::binary);
+  segment.seekp(block.size() / 2);
+  segment.put(0);
+  segment.close();
 
-  fs::remove(filename);
   auto res = bl_store->get(id);
   ASSERT_FALSE(res);
 }
 
 /**
- * @given empty folder with one entry
+ * @given block store with one entry
  * @when tries to add an entry with an existing id
  * @then add() fails
  */
@@ -194,14 +299,26 @@ TEST_F(BlStore_Test, AddExistingId) {
   ASSERT_TRUE(store);
   auto bl_store = std::move(*store);
   auto id = 1u;
-  const auto file_name = fs::path(block_store_path) / FlatFile::id_to_name(id);
-  std::ofstream fout(file_name.string());
-  fout.close();
+  ASSERT_TRUE(bl_store->add(id, block));
 
   auto res = bl_store->add(id, block);
   ASSERT_FALSE(res);
 }
 
+/**
+ * @given folder with storage in one-file-per-block layout
+ * @when tries to create FlatFile in the folder
+ * @then FlatFile creation fails
+ */
+TEST_F(BlStore_Test, LegacyLayout) {
+  std::ofstream fout(
+      (fs::path(block_store_path) / FlatFile::id_to_name(1)).string());
+  fout.close();
+
+  ASSERT_TRUE(FlatFile::has_legacy_layout(block_store_path));
+  ASSERT_FALSE(FlatFile::create(block_store_path));
+}
+
 /**
  * @given empty folder
  * @when tries to create FlatFile with empty path
@@ -227,3 +344,44 @@ TEST_F(BlStore_Test, WriteDeniedFolder) {
   auto res = bl_store->add(id, block);
   ASSERT_FALSE(res);
 }
+
+/**
+ * @given block store with blocks in sealed and active segments
+ * @when views of blocks are requested
+ * @then views contain the same data as written blocks
+ */
+TEST_F(BlStore_Test, GetView) {
+  auto store = FlatFile::create(block_store_path, block.size());
+  ASSERT_TRUE(store);
+  auto bl_store = std::move(*store);
+  auto other = std::vector<uint8_t>(1000, 7);
+  ASSERT_TRUE(bl_store->add(1, block));
+  ASSERT_TRUE(bl_store->add(2, other));
+
+  // block 1 is in sealed segment, block 2 is in the active one
+  for (const auto &expected : {std::make_pair(1u, block),
+                               std::make_pair(2u, other)}) {
+    auto view = bl_store->getView(expected.first);
+    ASSERT_TRUE(view);
+    ASSERT_EQ(std::vector<uint8_t>(view->data(), view->data() + view->size()),
+              expected.second);
+  }
+}
+
+/**
+ * @given view of block from block store
+ * @when block store is destroyed
+ * @then view still contains block data
+ */
+TEST_F(BlStore_Test, ViewOutlivesStorage) {
+  boost::optional<FlatFile::BlobView> view;
+  {
+    auto store = FlatFile::create(block_store_path);
+    ASSERT_TRUE(store);
+    ASSERT_TRUE((*store)->add(1, block));
+    view = (*store)->getView(1);
+  }
+  ASSERT_TRUE(view);
+  ASSERT_EQ(std::vector<uint8_t>(view->data(), view->data() + view->size()),
+            block);
+}
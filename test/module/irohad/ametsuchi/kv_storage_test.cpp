@@ -53,7 +53,7 @@ class KVTest : public AmetsuchiTest {
         });
     ASSERT_TRUE(storage);
     blocks = storage->getBlockQuery();
-    wsv_query = storage->getWsvQuery();
+    wsv_query = storage->getWsvQuery().value();
 
     // First transaction in block1
     iroha::model::Transaction txn1_1;
@@ -0,0 +1,177 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/postgres_connection_pool.hpp"
+#include <thread>
+#include "module/irohad/ametsuchi/ametsuchi_fixture.hpp"
+
+using namespace iroha::ametsuchi;
+using namespace std::chrono_literals;
+
+class PostgresConnectionPoolTest : public AmetsuchiTest {
+ protected:
+  /**
+   * Checkout connection which is expected to be available
+   */
+  PooledConnection checkout(PostgresConnectionPool &pool) {
+    PooledConnection connection;
+    pool.checkout().match(
+        [&](iroha::expected::Value<PooledConnection> &v) {
+          connection = std::move(v.value);
+        },
+        [](iroha::expected::Error<std::string> &e) { FAIL() << e.error; });
+    return connection;
+  }
+};
+
+/**
+ * @given connection pool
+ * @when connection is checked out, returned and checked out again
+ * @then the same connection is reused
+ */
+TEST_F(PostgresConnectionPoolTest, ConnectionIsReused) {
+  auto pool = PostgresConnectionPool::create(pgopt_, 2);
+  auto raw = checkout(*pool).get();
+  auto connection = checkout(*pool);
+
+  ASSERT_EQ(connection.get(), raw);
+  auto statistics = pool->statistics();
+  ASSERT_EQ(statistics.opened, 1u);
+  ASSERT_EQ(statistics.checkouts, 2u);
+  ASSERT_EQ(statistics.in_use, 1u);
+}
+
+/**
+ * @given connection pool of one connection which is checked out
+ * @when another connection is requested and the first one is returned
+ * meanwhile
+ * @then the returned connection is given out after waiting
+ */
+TEST_F(PostgresConnectionPoolTest, WaitForConnection) {
+  auto pool = PostgresConnectionPool::create(pgopt_, 1);
+  auto connection = checkout(*pool);
+
+  std::thread release([&connection] {
+    std::this_thread::sleep_for(50ms);
+    connection.reset();
+  });
+  auto next = checkout(*pool);
+  release.join();
+
+  ASSERT_TRUE(next);
+  auto statistics = pool->statistics();
+  ASSERT_EQ(statistics.waits, 1u);
+  ASSERT_GT(statistics.max_wait.count(), 0);
+  ASSERT_EQ(statistics.peak_in_use, 1u);
+}
+
+/**
+ * @given saturated connection pool
+ * @when connection is requested and none is returned in time
+ * @then checkout fails
+ */
+TEST_F(PostgresConnectionPoolTest, CheckoutTimeout) {
+  auto pool = PostgresConnectionPool::create(pgopt_, 1, 10ms);
+  auto connection = checkout(*pool);
+
+  pool->checkout().match(
+      [](iroha::expected::Value<PooledConnection> &) { FAIL(); },
+      [](iroha::expected::Error<std::string> &) {});
+  ASSERT_EQ(pool->statistics().timeouts, 1u);
+}
+
+/**
+ * @given connection pool with a connection checked out
+ * @when pool is destroyed before the connection
+ * @then connection is closed without the pool
+ */
+TEST_F(PostgresConnectionPoolTest, ConnectionOutlivesPool) {
+  auto pool = PostgresConnectionPool::create(pgopt_, 1);
+  auto connection = checkout(*pool);
+  pool.reset();
+
+  pqxx::nontransaction transaction(*connection);
+  ASSERT_NO_THROW(transaction.exec("SELECT 1;"));
+}
+
+/**
+ * @given connection pool with wrong options
+ * @when connection is requested
+ * @then checkout fails and pool slot is released
+ */
+TEST_F(PostgresConnectionPoolTest, BrokenConnection) {
+  auto pool = PostgresConnectionPool::create(
+      "host=localhost port=1 user=nobody", 1);
+
+  pool->checkout().match(
+      [](iroha::expected::Value<PooledConnection> &) { FAIL(); },
+      [](iroha::expected::Error<std::string> &) {});
+  ASSERT_EQ(pool->statistics().opened, 0u);
+}
+
+/**
+ * @given connection pool
+ * @when connection with changed session settings, a temporary table and an
+ * open transaction is returned
+ * @then the reused connection has default settings, no temporary table and
+ * no open transaction
+ */
+TEST_F(PostgresConnectionPoolTest, ReturnedConnectionIsReset) {
+  auto pool = PostgresConnectionPool::create(pgopt_, 1);
+  {
+    auto connection = checkout(*pool);
+    pqxx::nontransaction transaction(*connection);
+    transaction.exec("SET statement_timeout = 1234;");
+    transaction.exec("CREATE TEMP TABLE pool_reset_test (id integer);");
+    transaction.exec("BEGIN;");
+  }
+
+  auto connection = checkout(*pool);
+  pqxx::nontransaction transaction(*connection);
+  ASSERT_EQ(transaction.exec("SHOW statement_timeout;")[0][0].as<std::string>(),
+            "0");
+  ASSERT_TRUE(transaction
+                  .exec("SELECT to_regclass('pool_reset_test') IS NULL "
+                        "AS dropped;")[0]
+                  .at("dropped")
+                  .as<bool>());
+  // the connection is outside of a transaction, so it can be started
+  ASSERT_NO_THROW(transaction.exec("BEGIN; ROLLBACK;"));
+  ASSERT_EQ(pool->statistics().opened, 1u);
+}
+
+/**
+ * @given connection pool
+ * @when connection with a prepared statement is returned and reused
+ * @then the statement can still be executed
+ */
+TEST_F(PostgresConnectionPoolTest, PreparedStatementSurvivesReset) {
+  auto pool = PostgresConnectionPool::create(pgopt_, 1);
+  {
+    auto connection = checkout(*pool);
+    connection->prepare("pool_reset_select", "SELECT $1::integer AS value");
+    pqxx::nontransaction transaction(*connection);
+    transaction.exec_prepared("pool_reset_select", 1);
+  }
+
+  auto connection = checkout(*pool);
+  pqxx::nontransaction transaction(*connection);
+  ASSERT_EQ(transaction.exec_prepared("pool_reset_select", 2)[0]
+                .at("value")
+                .as<int>(),
+            2);
+}
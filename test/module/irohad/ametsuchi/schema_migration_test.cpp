@@ -0,0 +1,189 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/schema_migration.hpp"
+#include "module/irohad/ametsuchi/ametsuchi_fixture.hpp"
+
+using namespace iroha::ametsuchi;
+
+class SchemaMigrationTest : public AmetsuchiTest {
+ protected:
+  void SetUp() override {
+    AmetsuchiTest::SetUp();
+    transaction = std::make_unique<pqxx::nontransaction>(*connection);
+  }
+
+  void TearDown() override {
+    transaction.reset();
+    AmetsuchiTest::TearDown();
+  }
+
+  /**
+   * Replace index tables with the ones created before schema versioning
+   */
+  void createLegacySchema() {
+    transaction->exec(R"(
+DROP TABLE IF EXISTS schema_version;
+DROP TABLE IF EXISTS height_by_hash;
+DROP TABLE IF EXISTS height_by_account_set;
+DROP TABLE IF EXISTS index_by_creator_height;
+DROP TABLE IF EXISTS index_by_id_height_asset;
+CREATE TABLE height_by_hash (hash bytea, height text);
+CREATE TABLE height_by_account_set (account_id text, height text);
+CREATE TABLE index_by_creator_height (
+    id serial, creator_id text, height text, index text);
+CREATE TABLE index_by_id_height_asset (
+    id text, height text, asset_id text, index text);
+INSERT INTO height_by_hash VALUES ('\x01', '10');
+INSERT INTO height_by_account_set VALUES ('user@test', '10');
+INSERT INTO index_by_creator_height(creator_id, height, index)
+    VALUES ('user@test', '10', '2');
+INSERT INTO index_by_id_height_asset VALUES ('user@test', '10', 'coin#test', '2');
+)");
+  }
+
+  /**
+   * @return type of column in the database
+   */
+  std::string columnType(const std::string &table, const std::string &column) {
+    return transaction
+        ->exec("SELECT data_type FROM information_schema.columns "
+               "WHERE table_name = "
+               + transaction->quote(table)
+               + " AND column_name = " + transaction->quote(column) + ";")[0]
+        .at("data_type")
+        .as<std::string>();
+  }
+
+  std::unique_ptr<pqxx::nontransaction> transaction;
+};
+
+/**
+ * @given database created by storage
+ * @when schema migration is run
+ * @then nothing is migrated since schema is current
+ */
+TEST_F(SchemaMigrationTest, CurrentSchema) {
+  auto result = migrateSchema(*transaction);
+  result.match(
+      [](iroha::expected::Value<int> &v) { ASSERT_EQ(v.value, kSchemaVersion); },
+      [](iroha::expected::Error<std::string> &e) { FAIL() << e.error; });
+}
+
+/**
+ * @given database with index tables created before schema versioning
+ * @when schema migration is run
+ * @then columns are converted to bigint with data preserved
+ * AND schema version is updated, so the next run does nothing
+ */
+TEST_F(SchemaMigrationTest, MigrateLegacySchema) {
+  createLegacySchema();
+
+  migrateSchema(*transaction)
+      .match([](iroha::expected::Value<int> &v) { ASSERT_EQ(v.value, 1); },
+             [](iroha::expected::Error<std::string> &e) { FAIL() << e.error; });
+
+  ASSERT_EQ(columnType("height_by_hash", "height"), "bigint");
+  ASSERT_EQ(columnType("height_by_account_set", "height"), "bigint");
+  ASSERT_EQ(columnType("index_by_creator_height", "index"), "bigint");
+  ASSERT_EQ(columnType("index_by_id_height_asset", "index"), "bigint");
+  ASSERT_EQ(transaction
+                ->exec("SELECT index FROM index_by_id_height_asset "
+                       "WHERE id = 'user@test' AND height = 10;")[0]
+                .at("index")
+                .as<int>(),
+            2);
+
+  migrateSchema(*transaction)
+      .match(
+          [](iroha::expected::Value<int> &v) {
+            ASSERT_EQ(v.value, kSchemaVersion);
+          },
+          [](iroha::expected::Error<std::string> &e) { FAIL() << e.error; });
+}
+
+/**
+ * @given database with schema version newer than supported
+ * @when schema migration is run
+ * @then error is returned
+ */
+TEST_F(SchemaMigrationTest, NewerSchema) {
+  transaction->exec("UPDATE schema_version SET version = "
+                    + transaction->quote(kSchemaVersion + 1) + ";");
+
+  migrateSchema(*transaction)
+      .match([](iroha::expected::Value<int> &) { FAIL(); },
+             [](iroha::expected::Error<std::string> &) { SUCCEED(); });
+
+  transaction->exec("UPDATE schema_version SET version = "
+                    + transaction->quote(kSchemaVersion) + ";");
+}
+
+/**
+ * @given database created before the block hash index
+ * @when schema migration is run with data migration of block hash index
+ * @then data migration is run once, after the index table is created
+ */
+TEST_F(SchemaMigrationTest, DataMigrationIsRunOnce) {
+  createLegacySchema();
+  transaction->exec("DROP TABLE height_by_block_hash;");
+
+  int runs = 0;
+  std::map<int, DataMigration> data_migrations{
+      {4, [&runs](pqxx::nontransaction &transaction) {
+         ++runs;
+         transaction.exec(
+             "INSERT INTO height_by_block_hash(hash, height) "
+             "VALUES ('\\x01', 1);");
+       }}};
+
+  for (auto i = 0; i < 2; ++i) {
+    auto result = migrateSchema(*transaction, data_migrations);
+    result.match([](iroha::expected::Value<int> &) {},
+                 [](iroha::expected::Error<std::string> &e) {
+                   FAIL() << e.error;
+                 });
+  }
+  ASSERT_EQ(runs, 1);
+  ASSERT_EQ(transaction->exec("SELECT height FROM height_by_block_hash;")
+                .size(),
+            1);
+}
+
+/**
+ * @given database created before the block hash index
+ * @when data migration fails
+ * @then error is returned and schema is not migrated, so the migration is
+ * retried on the next run
+ */
+TEST_F(SchemaMigrationTest, FailedDataMigrationIsRolledBack) {
+  createLegacySchema();
+
+  std::map<int, DataMigration> data_migrations{
+      {4, [](pqxx::nontransaction &) {
+         throw std::runtime_error("cannot read block");
+       }}};
+  auto failed = migrateSchema(*transaction, data_migrations);
+  failed.match([](iroha::expected::Value<int> &) { FAIL(); },
+               [](iroha::expected::Error<std::string> &) { SUCCEED(); });
+  ASSERT_EQ(columnType("height_by_hash", "height"), "text");
+
+  auto migrated = migrateSchema(*transaction);
+  migrated.match(
+      [](iroha::expected::Value<int> &v) { ASSERT_EQ(v.value, 1); },
+      [](iroha::expected::Error<std::string> &e) { FAIL() << e.error; });
+}
@@ -0,0 +1,95 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "ametsuchi/impl/cached_wsv_query.hpp"
+#include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
+
+using namespace iroha::ametsuchi;
+using ::testing::_;
+using ::testing::Return;
+
+class WsvCacheTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    wsv = std::make_shared<MockWsvQuery>();
+    cache = std::make_shared<WsvCache>();
+    cached_query = std::make_shared<CachedWsvQuery>(wsv, cache);
+  }
+
+  std::string account_id = "id@domain", role = "role";
+  std::vector<std::string> roles = {role};
+
+  std::shared_ptr<MockWsvQuery> wsv;
+  std::shared_ptr<WsvCache> cache;
+  std::shared_ptr<WsvQuery> cached_query;
+};
+
+/**
+ * @given cached wsv query
+ * @when the same entity is requested several times
+ * @then the underlying query is called once
+ */
+TEST_F(WsvCacheTest, RepeatedReadIsCached) {
+  EXPECT_CALL(*wsv, getAccountRoles(account_id)).WillOnce(Return(roles));
+
+  ASSERT_EQ(roles, cached_query->getAccountRoles(account_id));
+  ASSERT_EQ(roles, cached_query->getAccountRoles(account_id));
+}
+
+/**
+ * @given cached wsv query
+ * @when requested entity does not exist
+ * @then absence is not cached
+ */
+TEST_F(WsvCacheTest, MissingEntityIsNotCached) {
+  EXPECT_CALL(*wsv, getAccountRoles(account_id))
+      .WillOnce(Return(boost::none))
+      .WillOnce(Return(roles));
+
+  ASSERT_FALSE(cached_query->getAccountRoles(account_id));
+  ASSERT_EQ(roles, cached_query->getAccountRoles(account_id));
+}
+
+/**
+ * @given cached account roles
+ * @when the entry is invalidated
+ * @then roles are read again from the underlying query
+ */
+TEST_F(WsvCacheTest, InvalidatedEntryIsReadAgain) {
+  std::vector<std::string> new_roles = {role, "new_role"};
+  EXPECT_CALL(*wsv, getAccountRoles(account_id))
+      .WillOnce(Return(roles))
+      .WillOnce(Return(new_roles));
+
+  cached_query->getAccountRoles(account_id);
+  cache->account_roles.invalidate(account_id);
+  ASSERT_EQ(new_roles, cached_query->getAccountRoles(account_id));
+}
+
+/**
+ * @given cached wsv query
+ * @when account roles are written to the cache
+ * @then they are served from the cache without reading them
+ */
+TEST_F(WsvCacheTest, WrittenEntryIsCached) {
+  EXPECT_CALL(*wsv, getAccountRoles(_)).Times(0);
+
+  cache->account_roles.write(account_id, roles);
+  ASSERT_EQ(roles, cached_query->getAccountRoles(account_id));
+}
@@ -0,0 +1,639 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <functional>
+#include <map>
+
+#include "ametsuchi/impl/postgres_overlay_storage.hpp"
+#include "ametsuchi/impl/postgres_wsv_command.hpp"
+#include "ametsuchi/impl/postgres_wsv_query.hpp"
+#include "ametsuchi/impl/postgres_wsv_writer.hpp"
+#include "ametsuchi/impl/wsv_overlay.hpp"
+#include "builders/protobuf/common_objects/proto_account_asset_builder.hpp"
+#include "builders/protobuf/common_objects/proto_account_builder.hpp"
+#include "builders/protobuf/common_objects/proto_amount_builder.hpp"
+#include "builders/protobuf/common_objects/proto_asset_builder.hpp"
+#include "builders/protobuf/common_objects/proto_domain_builder.hpp"
+#include "builders/protobuf/common_objects/proto_peer_builder.hpp"
+#include "framework/result_fixture.hpp"
+#include "module/irohad/ametsuchi/ametsuchi_fixture.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    using namespace framework::expected;
+    using shared_model::interface::types::PubkeyType;
+
+    /**
+     * Fixture which applies the same commands to WsvOverlay above the
+     * storage, and to PostgresWsvCommand, and compares their results and
+     * the resulting state
+     */
+    class WsvOverlayEquivalenceTest : public AmetsuchiTest {
+     public:
+      using Command = std::function<WsvCommandResult(WsvCommand &)>;
+
+      void SetUp() override {
+        AmetsuchiTest::SetUp();
+        postgres_connection = std::make_unique<pqxx::lazyconnection>(pgopt_);
+        try {
+          postgres_connection->activate();
+        } catch (const pqxx::broken_connection &e) {
+          FAIL() << "Connection to PostgreSQL broken: " << e.what();
+        }
+        wsv_transaction =
+            std::make_unique<pqxx::nontransaction>(*postgres_connection);
+        wsv_transaction->exec(init_);
+        // overlay storage evaluates json in savepoints
+        wsv_transaction->exec("BEGIN;");
+
+        command = std::make_shared<PostgresWsvCommand>(*wsv_transaction);
+        query = std::make_shared<PostgresWsvQuery>(*wsv_transaction);
+
+        ASSERT_NO_THROW(checkValueCase(command->insertRole(role)));
+        ASSERT_NO_THROW(
+            checkValueCase(command->insertRolePermissions(role, {permission})));
+        ASSERT_NO_THROW(
+            checkValueCase(command->insertDomain(makeDomain(domain_id, role))));
+        ASSERT_NO_THROW(checkValueCase(command->insertAccount(makeAccount(
+            account_id, domain_id, 1, R"({"id@domain": {"key": "value"}})"))));
+        ASSERT_NO_THROW(checkValueCase(
+            command->insertAccount(makeAccount(other_id, domain_id, 1, "{}"))));
+        ASSERT_NO_THROW(
+            checkValueCase(command->insertAccountRole(account_id, role)));
+        ASSERT_NO_THROW(checkValueCase(command->insertSignatory(key)));
+        ASSERT_NO_THROW(
+            checkValueCase(command->insertAccountSignatory(account_id, key)));
+        ASSERT_NO_THROW(
+            checkValueCase(command->insertAsset(makeAsset(asset_id, domain_id))));
+        ASSERT_NO_THROW(
+            checkValueCase(command->insertPeer(makePeer(peer_key, address))));
+
+        overlay = std::make_shared<WsvOverlay>(
+            query, std::make_shared<PostgresOverlayStorage>(*wsv_transaction));
+      }
+
+      void TearDown() override {
+        wsv_transaction->exec("ROLLBACK;");
+        AmetsuchiTest::TearDown();
+      }
+
+      static shared_model::proto::Account makeAccount(
+          const std::string &account_id,
+          const std::string &domain_id,
+          shared_model::interface::types::QuorumType quorum,
+          const std::string &json_data) {
+        return shared_model::proto::AccountBuilder()
+            .accountId(account_id)
+            .domainId(domain_id)
+            .quorum(quorum)
+            .jsonData(json_data)
+            .build();
+      }
+
+      static shared_model::proto::Asset makeAsset(const std::string &asset_id,
+                                                  const std::string &domain_id) {
+        return shared_model::proto::AssetBuilder()
+            .assetId(asset_id)
+            .domainId(domain_id)
+            .precision(2)
+            .build();
+      }
+
+      static shared_model::proto::AccountAsset makeAccountAsset(
+          const std::string &account_id,
+          const std::string &asset_id,
+          uint64_t balance) {
+        return shared_model::proto::AccountAssetBuilder()
+            .accountId(account_id)
+            .assetId(asset_id)
+            .balance(shared_model::proto::AmountBuilder()
+                         .intValue(balance)
+                         .precision(2)
+                         .build())
+            .build();
+      }
+
+      static shared_model::proto::Domain makeDomain(
+          const std::string &domain_id, const std::string &default_role) {
+        return shared_model::proto::DomainBuilder()
+            .domainId(domain_id)
+            .defaultRole(default_role)
+            .build();
+      }
+
+      static shared_model::proto::Peer makePeer(const PubkeyType &key,
+                                                const std::string &address) {
+        return shared_model::proto::PeerBuilder()
+            .pubkey(key)
+            .address(address)
+            .build();
+      }
+
+      static bool succeeded(WsvCommandResult result) {
+        return result.match([](expected::Value<void> &) { return true; },
+                            [](expected::Error<WsvError> &) { return false; });
+      }
+
+      /**
+       * Read state of known entities in comparable form
+       */
+      std::map<std::string, std::string> readState(WsvQuery &wsv) {
+        auto join = [](std::vector<std::string> values) {
+          std::sort(values.begin(), values.end());
+          std::string joined;
+          for (const auto &value : values) {
+            joined += value + ";";
+          }
+          return joined;
+        };
+        auto join_optional = [&join](const auto &values) {
+          return values ? join(*values) : std::string("none");
+        };
+
+        std::map<std::string, std::string> state;
+        auto roles = wsv.getRoles();
+        state["roles"] = join_optional(roles);
+        for (const auto &id : roles.value_or(std::vector<std::string>{})) {
+          state["permissions " + id] =
+              join_optional(wsv.getRolePermissions(id));
+        }
+        for (const auto &id : domain_ids) {
+          auto domain = wsv.getDomain(id);
+          state["domain " + id] = domain ? (*domain)->defaultRole() : "none";
+        }
+        for (const auto &id : account_ids) {
+          auto account = wsv.getAccount(id);
+          state["account " + id] = account
+              ? (*account)->domainId() + " "
+                  + std::to_string((*account)->quorum()) + " "
+                  + (*account)->jsonData()
+              : "none";
+          state["detail " + id] = wsv.getAccountDetail(id).value_or("none");
+          state["roles " + id] = join_optional(wsv.getAccountRoles(id));
+          std::vector<std::string> signatories;
+          for (const auto &signatory :
+               wsv.getSignatories(id).value_or(std::vector<PubkeyType>{})) {
+            signatories.push_back(signatory.hex());
+          }
+          state["signatories " + id] = join(signatories);
+          for (const auto &asset : asset_ids) {
+            auto account_asset = wsv.getAccountAsset(id, asset);
+            state["balance " + id + " " + asset] = account_asset
+                ? (*account_asset)->balance().toStringRepr()
+                : "none";
+          }
+          for (const auto &permittee : account_ids) {
+            for (const auto &permission : permissions) {
+              state["grantable " + permittee + " " + id + " " + permission] =
+                  std::to_string(wsv.hasAccountGrantablePermission(
+                      permittee, id, permission));
+            }
+          }
+        }
+        for (const auto &id : asset_ids) {
+          auto asset = wsv.getAsset(id);
+          state["asset " + id] = asset
+              ? (*asset)->domainId() + " "
+                  + std::to_string((*asset)->precision())
+              : "none";
+        }
+        std::vector<std::string> peers;
+        if (auto stored = wsv.getPeers()) {
+          for (const auto &peer : *stored) {
+            peers.push_back(peer->pubkey().hex() + " " + peer->address());
+          }
+        }
+        state["peers"] = join(peers);
+        return state;
+      }
+
+      /**
+       * Apply commands to overlay, and then to the storage, where a failed
+       * command is rolled back to its savepoint. Changes of overlay are then
+       * written to the initial storage state instead of the commands
+       * @param commands - commands to apply
+       */
+      void checkEquivalence(const std::vector<Command> &commands) {
+        std::vector<bool> overlay_results;
+        for (const auto &apply : commands) {
+          overlay_results.push_back(succeeded(apply(*overlay)));
+        }
+        auto overlay_state = readState(*overlay);
+
+        wsv_transaction->exec("SAVEPOINT commands_;");
+        std::vector<bool> storage_results;
+        for (const auto &apply : commands) {
+          wsv_transaction->exec("SAVEPOINT command_;");
+          auto result = succeeded(apply(*command));
+          wsv_transaction->exec(result ? "RELEASE SAVEPOINT command_;"
+                                       : "ROLLBACK TO SAVEPOINT command_;");
+          storage_results.push_back(result);
+        }
+
+        auto storage_state = readState(*query);
+        EXPECT_EQ(storage_results, overlay_results);
+        EXPECT_EQ(storage_state, overlay_state);
+
+        wsv_transaction->exec("ROLLBACK TO SAVEPOINT commands_;");
+        PostgresWsvWriter writer(*wsv_transaction);
+        EXPECT_TRUE(succeeded(writer.write(overlay->changes())));
+        EXPECT_EQ(storage_state, readState(*query));
+      }
+
+      std::string role = "role", permission = "can_add_peer",
+                  domain_id = "domain", account_id = "id@domain",
+                  other_id = "other@domain", new_id = "new@domain",
+                  asset_id = "coin#domain", address = "127.0.0.1:50541";
+      PubkeyType key{std::string(32, '1')}, other_key{std::string(32, '2')},
+          peer_key{std::string(32, '3')};
+
+      std::vector<std::string> domain_ids{domain_id, "new_domain"},
+          account_ids{account_id, other_id, new_id},
+          asset_ids{asset_id, "new#domain"},
+          permissions{permission, "can_set_my_quorum"};
+
+      std::unique_ptr<pqxx::lazyconnection> postgres_connection;
+      std::unique_ptr<pqxx::nontransaction> wsv_transaction;
+
+      std::shared_ptr<WsvCommand> command;
+      std::shared_ptr<WsvQuery> query;
+      std::shared_ptr<WsvOverlay> overlay;
+    };
+
+    /**
+     * @given role in storage
+     * @when new, duplicate, too long and truncated roles are inserted
+     * @then overlay and storage accept the same roles
+     */
+    TEST_F(WsvOverlayEquivalenceTest, InsertRole) {
+      auto truncated = std::string(32, 's');
+      checkEquivalence({
+          [](WsvCommand &c) { return c.insertRole("new_role"); },
+          [this](WsvCommand &c) { return c.insertRole(role); },
+          [](WsvCommand &c) { return c.insertRole(std::string(33, 'r')); },
+          // excess spaces are truncated by the column
+          [&](WsvCommand &c) { return c.insertRole(truncated + "  "); },
+          [&](WsvCommand &c) { return c.insertRole(truncated); },
+      });
+    }
+
+    /**
+     * @given role with permission in storage
+     * @when new, duplicate and too long permissions are inserted, as well
+     * as permissions of missing role
+     * @then overlay and storage accept the same permissions
+     */
+    TEST_F(WsvOverlayEquivalenceTest, InsertRolePermissions) {
+      checkEquivalence({
+          [this](WsvCommand &c) {
+            return c.insertRolePermissions(role, {"can_set_my_quorum"});
+          },
+          [this](WsvCommand &c) {
+            return c.insertRolePermissions(role, {permission});
+          },
+          [this](WsvCommand &c) {
+            return c.insertRolePermissions(role,
+                                           {permission, "can_add_signatory"});
+          },
+          [this](WsvCommand &c) {
+            return c.insertRolePermissions(role, {std::string(46, 'p')});
+          },
+          [this](WsvCommand &c) {
+            return c.insertRolePermissions("missing_role", {permission});
+          },
+          [](WsvCommand &c) { return c.insertRole("new_role"); },
+          [this](WsvCommand &c) {
+            return c.insertRolePermissions("new_role", {permission});
+          },
+      });
+    }
+
+    /**
+     * @given account with role in storage
+     * @when account roles are inserted and deleted
+     * @then overlay and storage accept the same account roles
+     */
+    TEST_F(WsvOverlayEquivalenceTest, AccountRoles) {
+      checkEquivalence({
+          [this](WsvCommand &c) { return c.insertAccountRole(account_id, role); },
+          [this](WsvCommand &c) { return c.insertAccountRole(other_id, role); },
+          [this](WsvCommand &c) { return c.insertAccountRole(new_id, role); },
+          [this](WsvCommand &c) {
+            return c.insertAccountRole(other_id, "missing_role");
+          },
+          [this](WsvCommand &c) { return c.deleteAccountRole(account_id, role); },
+          [this](WsvCommand &c) { return c.deleteAccountRole(new_id, role); },
+          [this](WsvCommand &c) { return c.insertAccountRole(account_id, role); },
+      });
+    }
+
+    /**
+     * @given accounts in storage
+     * @when grantable permissions are inserted and deleted
+     * @then overlay and storage accept the same permissions
+     */
+    TEST_F(WsvOverlayEquivalenceTest, GrantablePermissions) {
+      checkEquivalence({
+          [this](WsvCommand &c) {
+            return c.insertAccountGrantablePermission(
+                other_id, account_id, permission);
+          },
+          [this](WsvCommand &c) {
+            return c.insertAccountGrantablePermission(
+                other_id, account_id, permission);
+          },
+          [this](WsvCommand &c) {
+            return c.insertAccountGrantablePermission(
+                new_id, account_id, permission);
+          },
+          [this](WsvCommand &c) {
+            return c.insertAccountGrantablePermission(
+                other_id, new_id, permission);
+          },
+          [this](WsvCommand &c) {
+            return c.insertAccountGrantablePermission(
+                other_id, account_id, std::string(46, 'p'));
+          },
+          [this](WsvCommand &c) {
+            return c.deleteAccountGrantablePermission(
+                other_id, account_id, permission);
+          },
+          [this](WsvCommand &c) {
+            return c.deleteAccountGrantablePermission(
+                account_id, other_id, permission);
+          },
+          [this](WsvCommand &c) {
+            return c.insertAccountGrantablePermission(
+                other_id, account_id, permission);
+          },
+      });
+    }
+
+    /**
+     * @given domain and accounts in storage
+     * @when accounts with valid and invalid json data, quorum, domain and
+     * identifiers are inserted
+     * @then overlay and storage accept the same accounts, and json data is
+     * stored in the same form
+     */
+    TEST_F(WsvOverlayEquivalenceTest, InsertAccount) {
+      auto truncated = std::string(288, 'a');
+      checkEquivalence({
+          [this](WsvCommand &c) {
+            return c.insertAccount(
+                makeAccount(new_id, domain_id, 1, R"({ "b" : 1, "a" : {} })"));
+          },
+          [this](WsvCommand &c) {
+            return c.insertAccount(makeAccount(account_id, domain_id, 1, "{}"));
+          },
+          [](WsvCommand &c) {
+            return c.insertAccount(
+                makeAccount("x@missing", "missing", 1, "{}"));
+          },
+          [this](WsvCommand &c) {
+            return c.insertAccount(makeAccount("x@domain", domain_id, 1, ""));
+          },
+          [this](WsvCommand &c) {
+            return c.insertAccount(makeAccount("y@domain", domain_id, 1, "{"));
+          },
+          [this](WsvCommand &c) {
+            return c.insertAccount(
+                makeAccount("z@domain", domain_id, 3000000000u, "{}"));
+          },
+          [&](WsvCommand &c) {
+            return c.insertAccount(
+                makeAccount(truncated + " ", domain_id, 1, "{}"));
+          },
+          [&](WsvCommand &c) {
+            return c.insertAccount(makeAccount(truncated, domain_id, 1, "{}"));
+          },
+      });
+    }
+
+    /**
+     * @given account in storage
+     * @when quorum of existing and missing accounts is updated
+     * @then overlay and storage update the same accounts, and reject quorum
+     * out of range of the column
+     */
+    TEST_F(WsvOverlayEquivalenceTest, UpdateAccount) {
+      checkEquivalence({
+          [this](WsvCommand &c) {
+            return c.updateAccount(makeAccount(account_id, domain_id, 2, "{}"));
+          },
+          [this](WsvCommand &c) {
+            return c.updateAccount(makeAccount(new_id, domain_id, 2, "{}"));
+          },
+          [this](WsvCommand &c) {
+            return c.updateAccount(
+                makeAccount(other_id, domain_id, 3000000000u, "{}"));
+          },
+      });
+    }
+
+    /**
+     * @given accounts with json data in storage
+     * @when details are set with plain, escaped and invalid values, and
+     * for missing account
+     * @then overlay and storage reject the same values, and store the same
+     * json data
+     */
+    TEST_F(WsvOverlayEquivalenceTest, SetAccountDetail) {
+      auto set = [](const std::string &account,
+                    const std::string &creator,
+                    const std::string &key,
+                    const std::string &val) -> Command {
+        return [=](WsvCommand &c) {
+          return c.setAccountKV(account, creator, key, val);
+        };
+      };
+      checkEquivalence({
+          set(account_id, account_id, "key", "new value"),
+          set(account_id, account_id, "other", "[val1, val2]"),
+          set(account_id, other_id, "key", "value"),
+          set(other_id, account_id, "key", "value"),
+          set(account_id, account_id, "quote", R"(a"b)"),
+          set(account_id, account_id, "escaped", R"(a\"b\né)"),
+          set(account_id, account_id, "escape", R"(a\qb)"),
+          set(account_id, account_id, "nul", R"(\u0000)"),
+          set(account_id, account_id, "control", "a\nb"),
+          set(account_id, account_id, "utf8", "\xc3\xa9"),
+          set(account_id, account_id, "NULL", "value"),
+          set(new_id, account_id, "key", "value"),
+          set(new_id, account_id, "key", R"(a"b)"),
+          set(new_id, account_id, "NULL", "value"),
+      });
+    }
+
+    /**
+     * @given domain and asset in storage
+     * @when assets and account assets are inserted
+     * @then overlay and storage accept the same assets
+     */
+    TEST_F(WsvOverlayEquivalenceTest, Assets) {
+      checkEquivalence({
+          [this](WsvCommand &c) {
+            return c.insertAsset(makeAsset("new#domain", domain_id));
+          },
+          [this](WsvCommand &c) {
+            return c.insertAsset(makeAsset(asset_id, domain_id));
+          },
+          [](WsvCommand &c) {
+            return c.insertAsset(makeAsset("x#missing", "missing"));
+          },
+          [this](WsvCommand &c) {
+            return c.insertAsset(makeAsset(std::string(289, 'x'), domain_id));
+          },
+          [this](WsvCommand &c) {
+            return c.upsertAccountAsset(
+                makeAccountAsset(account_id, asset_id, 100));
+          },
+          [this](WsvCommand &c) {
+            return c.upsertAccountAsset(
+                makeAccountAsset(account_id, asset_id, 250));
+          },
+          [this](WsvCommand &c) {
+            return c.upsertAccountAsset(
+                makeAccountAsset(other_id, "new#domain", 1));
+          },
+          [this](WsvCommand &c) {
+            return c.upsertAccountAsset(makeAccountAsset(new_id, asset_id, 1));
+          },
+          [this](WsvCommand &c) {
+            return c.upsertAccountAsset(
+                makeAccountAsset(other_id, "missing#domain", 1));
+          },
+      });
+    }
+
+    /**
+     * @given signatory of account in storage
+     * @when signatories are inserted and attached to accounts
+     * @then overlay and storage require the same signatories to exist
+     */
+    TEST_F(WsvOverlayEquivalenceTest, InsertSignatory) {
+      checkEquivalence({
+          [this](WsvCommand &c) { return c.insertSignatory(key); },
+          [this](WsvCommand &c) {
+            return c.insertAccountSignatory(other_id, other_key);
+          },
+          [this](WsvCommand &c) { return c.insertSignatory(other_key); },
+          [this](WsvCommand &c) {
+            return c.insertAccountSignatory(other_id, other_key);
+          },
+          [this](WsvCommand &c) {
+            return c.insertAccountSignatory(other_id, other_key);
+          },
+          [this](WsvCommand &c) {
+            return c.insertAccountSignatory(new_id, other_key);
+          },
+          [this](WsvCommand &c) {
+            return c.insertAccountSignatory(other_id, peer_key);
+          },
+      });
+    }
+
+    /**
+     * @given signatory of account and peer in storage
+     * @when signatories are deleted while used and after the last use
+     * @then overlay and storage remove the same signatories
+     */
+    TEST_F(WsvOverlayEquivalenceTest, DeleteSignatory) {
+      checkEquivalence({
+          [this](WsvCommand &c) { return c.deleteSignatory(key); },
+          [this](WsvCommand &c) {
+            return c.insertAccountSignatory(other_id, key);
+          },
+          [this](WsvCommand &c) {
+            return c.deleteAccountSignatory(account_id, key);
+          },
+          [this](WsvCommand &c) { return c.deleteSignatory(key); },
+          [this](WsvCommand &c) {
+            return c.deleteAccountSignatory(other_id, key);
+          },
+          [this](WsvCommand &c) { return c.deleteSignatory(key); },
+          [this](WsvCommand &c) {
+            return c.insertAccountSignatory(account_id, key);
+          },
+          // peer keeps its signatory
+          [this](WsvCommand &c) { return c.insertSignatory(peer_key); },
+          [this](WsvCommand &c) { return c.deleteSignatory(peer_key); },
+          [this](WsvCommand &c) {
+            return c.insertAccountSignatory(other_id, peer_key);
+          },
+          [this](WsvCommand &c) { return c.deleteSignatory(other_key); },
+      });
+    }
+
+    /**
+     * @given peer in storage
+     * @when peers are inserted and deleted
+     * @then overlay and storage accept the same peers
+     */
+    TEST_F(WsvOverlayEquivalenceTest, Peers) {
+      auto other_address = std::string("127.0.0.1:50542");
+      checkEquivalence({
+          [&](WsvCommand &c) {
+            return c.insertPeer(makePeer(other_key, other_address));
+          },
+          [&](WsvCommand &c) {
+            return c.insertPeer(makePeer(peer_key, other_address + "1"));
+          },
+          [this](WsvCommand &c) {
+            return c.insertPeer(makePeer(key, address));
+          },
+          [this](WsvCommand &c) {
+            return c.insertPeer(makePeer(key, std::string(262, 'a')));
+          },
+          [&](WsvCommand &c) {
+            return c.deletePeer(makePeer(peer_key, other_address));
+          },
+          [this](WsvCommand &c) {
+            return c.deletePeer(makePeer(peer_key, address));
+          },
+          [this](WsvCommand &c) {
+            return c.insertPeer(makePeer(key, address));
+          },
+      });
+    }
+
+    /**
+     * @given role and domain in storage
+     * @when domains are inserted
+     * @then overlay and storage accept the same domains
+     */
+    TEST_F(WsvOverlayEquivalenceTest, InsertDomain) {
+      checkEquivalence({
+          [this](WsvCommand &c) {
+            return c.insertDomain(makeDomain("new_domain", role));
+          },
+          [this](WsvCommand &c) {
+            return c.insertDomain(makeDomain(domain_id, role));
+          },
+          [](WsvCommand &c) {
+            return c.insertDomain(makeDomain("other_domain", "missing_role"));
+          },
+          [this](WsvCommand &c) {
+            return c.insertDomain(makeDomain(std::string(256, 'd'), role));
+          },
+      });
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,224 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "ametsuchi/impl/wsv_overlay.hpp"
+#include "builders/protobuf/common_objects/proto_account_builder.hpp"
+#include "builders/protobuf/common_objects/proto_domain_builder.hpp"
+#include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
+
+using namespace iroha::ametsuchi;
+using ::testing::_;
+using ::testing::Return;
+
+class WsvOverlayTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    wsv = std::make_shared<MockWsvQuery>();
+    storage = std::make_shared<MockOverlayStorage>();
+    overlay = std::make_shared<WsvOverlay>(wsv, storage);
+  }
+
+  /**
+   * @return true if command result is successful
+   */
+  static bool succeeded(WsvCommandResult result) {
+    return result.match([](iroha::expected::Value<void> &) { return true; },
+                        [](iroha::expected::Error<WsvError> &) {
+                          return false;
+                        });
+  }
+
+  std::string account_id = "id@domain", domain_id = "domain", role = "role",
+              new_role = "new_role";
+  std::vector<std::string> roles = {role};
+
+  std::shared_ptr<MockWsvQuery> wsv;
+  std::shared_ptr<MockOverlayStorage> storage;
+  std::shared_ptr<WsvOverlay> overlay;
+};
+
+/**
+ * @given overlay without changes
+ * @when entity is requested
+ * @then it is read from the committed state
+ */
+TEST_F(WsvOverlayTest, ReadsCommittedState) {
+  EXPECT_CALL(*wsv, getAccountRoles(account_id)).WillOnce(Return(roles));
+
+  ASSERT_EQ(roles, overlay->getAccountRoles(account_id));
+}
+
+/**
+ * @given committed role
+ * @when the same role is inserted
+ * @then insertion fails
+ */
+TEST_F(WsvOverlayTest, DuplicateRoleIsRejected) {
+  EXPECT_CALL(*wsv, getRoles()).WillOnce(Return(roles));
+
+  ASSERT_FALSE(succeeded(overlay->insertRole(role)));
+}
+
+/**
+ * @given role inserted after a savepoint
+ * @when the savepoint is rolled back
+ * @then the role is not visible anymore
+ */
+TEST_F(WsvOverlayTest, RollbackDropsChanges) {
+  EXPECT_CALL(*wsv, getRoles()).WillRepeatedly(Return(roles));
+
+  overlay->savepoint();
+  ASSERT_TRUE(succeeded(overlay->insertRole(new_role)));
+  ASSERT_EQ(std::vector<std::string>({role, new_role}), overlay->getRoles());
+  overlay->rollback();
+
+  ASSERT_EQ(roles, overlay->getRoles());
+}
+
+/**
+ * @given role inserted after a savepoint
+ * @when the savepoint is released, and the next one is rolled back
+ * @then the role is kept
+ */
+TEST_F(WsvOverlayTest, ReleaseKeepsChanges) {
+  EXPECT_CALL(*wsv, getRoles()).WillRepeatedly(Return(roles));
+
+  overlay->savepoint();
+  ASSERT_TRUE(succeeded(overlay->insertRole(new_role)));
+  overlay->release();
+  overlay->savepoint();
+  overlay->rollback();
+
+  ASSERT_EQ(std::vector<std::string>({role, new_role}), overlay->getRoles());
+  ASSERT_FALSE(succeeded(overlay->insertRole(new_role)));
+}
+
+/**
+ * @given committed account roles
+ * @when role is appended to the account twice
+ * @then committed roles are read once, and the second append fails
+ */
+TEST_F(WsvOverlayTest, AccountRolesAreCopiedOnWrite) {
+  auto account = std::make_shared<shared_model::proto::Account>(
+      shared_model::proto::AccountBuilder()
+          .accountId(account_id)
+          .domainId(domain_id)
+          .quorum(1)
+          .build());
+  EXPECT_CALL(*wsv, getAccount(account_id))
+      .WillRepeatedly(Return(
+          boost::make_optional<
+              std::shared_ptr<shared_model::interface::Account>>(account)));
+  EXPECT_CALL(*wsv, getRoles())
+      .WillOnce(Return(std::vector<std::string>({role, new_role})));
+  EXPECT_CALL(*wsv, getAccountRoles(account_id)).WillOnce(Return(roles));
+
+  ASSERT_TRUE(succeeded(overlay->insertAccountRole(account_id, new_role)));
+  ASSERT_FALSE(succeeded(overlay->insertAccountRole(account_id, new_role)));
+  ASSERT_EQ(std::vector<std::string>({role, new_role}),
+            overlay->getAccountRoles(account_id));
+}
+
+/**
+ * @given committed domain
+ * @when account is inserted and its detail is set
+ * @then account and detail evaluated by the storage are served by the
+ * overlay
+ */
+TEST_F(WsvOverlayTest, InsertedAccountIsServedFromOverlay) {
+  auto domain = std::make_shared<shared_model::proto::Domain>(
+      shared_model::proto::DomainBuilder()
+          .domainId(domain_id)
+          .defaultRole(role)
+          .build());
+  EXPECT_CALL(*wsv, getDomain(domain_id))
+      .WillOnce(Return(
+          boost::make_optional<
+              std::shared_ptr<shared_model::interface::Domain>>(domain)));
+  EXPECT_CALL(*wsv, getAccount(account_id)).WillOnce(Return(boost::none));
+  EXPECT_CALL(*storage, getAccount(account_id))
+      .WillOnce(Return(iroha::expected::makeValue(boost::optional<
+                           std::shared_ptr<shared_model::interface::Account>>())));
+  EXPECT_CALL(*storage, normalizeJson("{}"))
+      .WillOnce(Return(iroha::expected::makeValue(std::string("{}"))));
+  std::string detail = R"({"id@domain": {"key": "value"}})";
+  EXPECT_CALL(*storage,
+              setAccountDetail(boost::make_optional(std::string("{}")),
+                               account_id,
+                               "key",
+                               "value"))
+      .WillOnce(Return(iroha::expected::makeValue(detail)));
+  EXPECT_CALL(*wsv, getAccountDetail(_)).Times(0);
+
+  auto account = shared_model::proto::AccountBuilder()
+                     .accountId(account_id)
+                     .domainId(domain_id)
+                     .quorum(1)
+                     .jsonData("{}")
+                     .build();
+  ASSERT_TRUE(succeeded(overlay->insertAccount(account)));
+  ASSERT_TRUE(
+      succeeded(overlay->setAccountKV(account_id, account_id, "key", "value")));
+
+  auto stored = overlay->getAccount(account_id);
+  ASSERT_TRUE(stored);
+  ASSERT_EQ(account_id, (*stored)->accountId());
+  ASSERT_EQ(boost::make_optional(detail), overlay->getAccountDetail(account_id));
+}
+
+/**
+ * @given role inserted into overlay, and overlays created above it
+ * @when roles are inserted into child overlays, and one of them is merged
+ * @then children see the parent's role, and only the merged role is kept
+ */
+TEST_F(WsvOverlayTest, ChildOverlayIsMerged) {
+  EXPECT_CALL(*wsv, getRoles()).WillRepeatedly(Return(roles));
+  std::string merged_role = "merged_role", dropped_role = "dropped_role";
+
+  ASSERT_TRUE(succeeded(overlay->insertRole(new_role)));
+  WsvOverlay merged(wsv, storage, *overlay), dropped(wsv, storage, *overlay);
+  ASSERT_FALSE(succeeded(merged.insertRole(new_role)));
+  ASSERT_TRUE(succeeded(merged.insertRole(merged_role)));
+  ASSERT_TRUE(succeeded(dropped.insertRole(dropped_role)));
+  overlay->merge(std::move(merged));
+
+  ASSERT_EQ(std::vector<std::string>({role, new_role, merged_role}),
+            overlay->getRoles());
+}
+
+/**
+ * @given roles inserted into overlay
+ * @when changes are committed, and then other changes are discarded
+ * @then committed roles stay visible without reading the storage again,
+ * and discarded ones are dropped
+ */
+TEST_F(WsvOverlayTest, CommittedChangesBecomeCommittedState) {
+  EXPECT_CALL(*wsv, getRoles()).WillOnce(Return(roles));
+
+  ASSERT_TRUE(succeeded(overlay->insertRole(new_role)));
+  ASSERT_EQ(std::vector<std::string>({new_role}), overlay->changes().roles);
+  overlay->commitChanges();
+  ASSERT_TRUE(overlay->changes().roles.empty());
+  ASSERT_FALSE(succeeded(overlay->insertRole(new_role)));
+
+  ASSERT_TRUE(succeeded(overlay->insertRole("discarded_role")));
+  overlay->discardChanges();
+  ASSERT_TRUE(overlay->changes().roles.empty());
+  ASSERT_TRUE(succeeded(overlay->insertRole("discarded_role")));
+}
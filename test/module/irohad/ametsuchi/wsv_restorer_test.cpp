@@ -0,0 +1,132 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/wsv_restorer_impl.hpp"
+
+#include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
+#include "module/shared_model/builders/protobuf/test_block_builder.hpp"
+
+using namespace iroha::ametsuchi;
+
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::_;
+
+using wBlock = std::shared_ptr<const shared_model::interface::Block>;
+
+class WsvRestorerTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    block_query = std::make_shared<MockBlockQuery>();
+    mutable_storage = new MockMutableStorage();
+
+    EXPECT_CALL(storage, getBlockQuery()).WillRepeatedly(Return(block_query));
+    EXPECT_CALL(storage, restoreWsvSnapshot())
+        .WillOnce(Return(boost::none));
+    EXPECT_CALL(storage, dropWsv()).Times(1);
+    EXPECT_CALL(storage, createMutableStorage()).WillOnce(Invoke([this] {
+      return iroha::expected::makeValue<std::unique_ptr<MutableStorage>>(
+          std::unique_ptr<MutableStorage>(mutable_storage));
+    }));
+  }
+
+  /**
+   * @return empty block at given height
+   */
+  wBlock makeBlock(shared_model::interface::types::HeightType height) {
+    return clone(TestBlockBuilder()
+                     .height(height)
+                     .prevHash(shared_model::crypto::Hash(std::string(32, '0')))
+                     .build());
+  }
+
+  /**
+   * Make block store readable up to given height, where only given blocks
+   * can be read
+   */
+  void readableBlocks(shared_model::interface::types::HeightType top_height,
+                      std::vector<wBlock> blocks) {
+    EXPECT_CALL(*block_query, getTopBlocks(1))
+        .WillOnce(Return(rxcpp::observable<>::just(makeBlock(top_height))));
+    EXPECT_CALL(*block_query, getBlocks(1, _))
+        .WillOnce(Return(rxcpp::observable<>::iterate(blocks)));
+  }
+
+  MockStorage storage;
+  std::shared_ptr<MockBlockQuery> block_query;
+  /// owned by restorer after it is created
+  MockMutableStorage *mutable_storage;
+};
+
+/**
+ * @given block store with 3 blocks, where block 2 cannot be read
+ * @when WSV is restored
+ * @then restore fails
+ * AND block 3 is not applied AND nothing is committed
+ */
+TEST_F(WsvRestorerTest, MissingBlockStopsRestore) {
+  readableBlocks(3, {makeBlock(1), makeBlock(3)});
+
+  EXPECT_CALL(*mutable_storage, apply(_, _)).WillOnce(Return(true));
+  EXPECT_CALL(storage, doCommit(_)).Times(0);
+
+  auto result = WsvRestorerImpl().restoreWsv(storage);
+  result.match([](iroha::expected::Value<void> &) { FAIL(); },
+               [](iroha::expected::Error<std::string> &e) {
+                 ASSERT_EQ(e.error, "cannot read block 2");
+               });
+}
+
+/**
+ * @given block store with 3 blocks, where block 3 cannot be read
+ * @when WSV is restored
+ * @then restore fails AND applied blocks are not committed
+ */
+TEST_F(WsvRestorerTest, MissingTopBlockStopsRestore) {
+  readableBlocks(3, {makeBlock(1), makeBlock(2)});
+
+  EXPECT_CALL(*mutable_storage, apply(_, _))
+      .Times(2)
+      .WillRepeatedly(Return(true));
+  EXPECT_CALL(storage, doCommit(_)).Times(0);
+
+  auto result = WsvRestorerImpl().restoreWsv(storage);
+  result.match([](iroha::expected::Value<void> &) { FAIL(); },
+               [](iroha::expected::Error<std::string> &e) {
+                 ASSERT_EQ(e.error, "cannot read block 3");
+               });
+}
+
+/**
+ * @given block store with 3 readable blocks
+ * @when WSV is restored
+ * @then all blocks are applied and committed
+ */
+TEST_F(WsvRestorerTest, AllBlocksAreRestored) {
+  readableBlocks(3, {makeBlock(1), makeBlock(2), makeBlock(3)});
+
+  EXPECT_CALL(*mutable_storage, apply(_, _))
+      .Times(3)
+      .WillRepeatedly(Return(true));
+  EXPECT_CALL(storage, doCommit(mutable_storage)).Times(1);
+
+  auto result = WsvRestorerImpl().restoreWsv(storage);
+  result.match([](iroha::expected::Value<void> &) {},
+               [](iroha::expected::Error<std::string> &e) {
+                 FAIL() << e.error;
+               });
+}
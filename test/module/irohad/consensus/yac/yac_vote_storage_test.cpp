@@ -0,0 +1,124 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "consensus/yac/storage/yac_vote_storage.hpp"
+#include "module/irohad/consensus/yac/yac_mocks.hpp"
+
+using namespace iroha::consensus::yac;
+
+class YacVoteStorageTest : public ::testing::Test {
+ public:
+  /**
+   * Store votes of all peers for the given proposal
+   * @return answer after the last vote
+   */
+  boost::optional<Answer> voteRound(YacVoteStorage &storage,
+                                    const std::string &proposal) {
+    boost::optional<Answer> answer;
+    for (auto i = 0u; i < number_of_peers; ++i) {
+      answer = storage.store(
+          create_vote(YacHash(proposal, "commit"), std::to_string(i)),
+          number_of_peers);
+    }
+    return answer;
+  }
+
+  uint64_t number_of_peers = 4;
+};
+
+/**
+ * @given vote storage
+ * @when all peers vote for the same hash
+ * @then the hash is committed
+ */
+TEST_F(YacVoteStorageTest, RoundIsCommitted) {
+  YacVoteStorage storage;
+
+  auto answer = voteRound(storage, "proposal");
+  ASSERT_TRUE(answer);
+  ASSERT_NO_THROW(boost::get<CommitMessage>(*answer));
+  ASSERT_TRUE(storage.isHashCommitted("proposal"));
+}
+
+/**
+ * @given vote storage with window of two rounds
+ * @when three rounds are voted and processed
+ * @then the oldest round and its processing state are removed
+ */
+TEST_F(YacVoteStorageTest, OldRoundsAreRemoved) {
+  YacVoteStorage storage(2);
+
+  for (const auto &proposal : {"first", "second", "third"}) {
+    voteRound(storage, proposal);
+    storage.markAsProcessedState(proposal);
+  }
+
+  ASSERT_EQ(2u, storage.roundsNumber());
+  ASSERT_FALSE(storage.isHashCommitted("first"));
+  ASSERT_FALSE(storage.getProcessingState("first"));
+  ASSERT_TRUE(storage.isHashCommitted("second"));
+  ASSERT_TRUE(storage.getProcessingState("second"));
+  ASSERT_TRUE(storage.isHashCommitted("third"));
+  ASSERT_TRUE(storage.getProcessingState("third"));
+}
+
+/**
+ * @given vote storage with window of one round
+ * @when votes for the current round keep coming
+ * @then the round is not removed
+ */
+TEST_F(YacVoteStorageTest, CurrentRoundIsKept) {
+  YacVoteStorage storage(1);
+
+  voteRound(storage, "first");
+  voteRound(storage, "second");
+  storage.store(create_vote(YacHash("second", "commit"), "late"),
+                number_of_peers);
+
+  ASSERT_EQ(1u, storage.roundsNumber());
+  ASSERT_TRUE(storage.isHashCommitted("second"));
+}
+
+/**
+ * @given vote storage with window of two rounds and a committed round
+ * @when one peer votes for many unknown hashes, and then the next round is
+ * committed
+ * @then the committed round and its processing state are kept until the
+ * next commit, after which the storage fits into the window again
+ */
+TEST_F(YacVoteStorageTest, UnknownHashesDoNotRemoveCommittedRound) {
+  YacVoteStorage storage(2);
+
+  voteRound(storage, "first");
+  storage.markAsProcessedState("first");
+  for (auto i = 0; i < 5; ++i) {
+    storage.store(
+        create_vote(YacHash("fake" + std::to_string(i), "commit"), "0"),
+        number_of_peers);
+  }
+
+  ASSERT_TRUE(storage.isHashCommitted("first"));
+  ASSERT_TRUE(storage.getProcessingState("first"));
+
+  voteRound(storage, "second");
+
+  ASSERT_EQ(2u, storage.roundsNumber());
+  ASSERT_TRUE(storage.isHashCommitted("second"));
+  ASSERT_FALSE(storage.getProcessingState("first"));
+}
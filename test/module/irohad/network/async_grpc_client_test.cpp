@@ -0,0 +1,274 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <grpc++/grpc++.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <future>
+#include <numeric>
+
+#include "builders/protobuf/common_objects/proto_peer_builder.hpp"
+#include "consensus/yac/messages.hpp"
+#include "consensus/yac/transport/impl/network_impl.hpp"
+#include "network/impl/async_grpc_client.hpp"
+#include "ordering.grpc.pb.h"
+
+using namespace iroha::network;
+using namespace iroha::ordering;
+using namespace std::chrono_literals;
+
+/**
+ * Ordering service which holds every batch until it is released
+ */
+class BlockingOrderingService
+    : public proto::OrderingServiceTransportGrpc::Service {
+ public:
+  grpc::Status onBatch(grpc::ServerContext *context,
+                       const proto::TxBatch *request,
+                       google::protobuf::Empty *response) override {
+    ++received;
+    release.wait();
+    return grpc::Status::OK;
+  }
+
+  std::atomic<size_t> received{0};
+  std::shared_future<void> release;
+};
+
+/**
+ * YAC service which holds every vote until it is released, commits and
+ * rejects are answered immediately
+ */
+class BlockingYacService : public iroha::consensus::yac::proto::Yac::Service {
+ public:
+  grpc::Status SendVote(grpc::ServerContext *context,
+                        const iroha::consensus::yac::proto::Vote *request,
+                        google::protobuf::Empty *response) override {
+    ++votes;
+    release.wait();
+    return grpc::Status::OK;
+  }
+
+  grpc::Status SendCommit(grpc::ServerContext *context,
+                          const iroha::consensus::yac::proto::Commit *request,
+                          google::protobuf::Empty *response) override {
+    ++commits;
+    return grpc::Status::OK;
+  }
+
+  grpc::Status SendReject(grpc::ServerContext *context,
+                          const iroha::consensus::yac::proto::Reject *request,
+                          google::protobuf::Empty *response) override {
+    ++rejects;
+    return grpc::Status::OK;
+  }
+
+  std::atomic<size_t> votes{0}, commits{0}, rejects{0};
+  std::shared_future<void> release;
+};
+
+/**
+ * Client which sends empty batches to the ordering service
+ */
+class TestClient : public AsyncGrpcClient<google::protobuf::Empty> {
+ public:
+  TestClient(const std::string &address, size_t max_in_flight)
+      : AsyncGrpcClient(1, max_in_flight),
+        stub_(proto::OrderingServiceTransportGrpc::NewStub(grpc::CreateChannel(
+            address, grpc::InsecureChannelCredentials()))),
+        address_(address) {}
+
+  /**
+   * @return true if the batch is sent, false if it is dropped
+   */
+  bool send() {
+    auto call = newCall(address_, "batch");
+    if (not call) {
+      return false;
+    }
+    call->response_reader =
+        stub_->AsynconBatch(&call->context, proto::TxBatch(), &cq_);
+    call->response_reader->Finish(&call->reply, &call->status, call);
+    return true;
+  }
+
+  /**
+   * @return statistics of sent batches
+   */
+  AsyncCallStatistics batchStatistics() const {
+    auto statistics = this->statistics();
+    auto it = statistics.find("batch");
+    return it == statistics.end() ? AsyncCallStatistics() : it->second;
+  }
+
+ private:
+  std::unique_ptr<proto::OrderingServiceTransportGrpc::Stub> stub_;
+  std::string address_;
+};
+
+class AsyncGrpcClientTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    service.release = release.get_future().share();
+    yac_service.release = service.release;
+
+    int port = 0;
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort(
+        "127.0.0.1:0", grpc::InsecureServerCredentials(), &port);
+    builder.RegisterService(&service);
+    builder.RegisterService(&yac_service);
+    server = builder.BuildAndStart();
+    ASSERT_TRUE(server);
+    ASSERT_NE(port, 0);
+    address = "127.0.0.1:" + std::to_string(port);
+  }
+
+  void TearDown() override {
+    releaseCalls();
+    server->Shutdown();
+  }
+
+  void releaseCalls() {
+    if (not released) {
+      release.set_value();
+      released = true;
+    }
+  }
+
+  /**
+   * Wait until predicate is satisfied, at most 10 seconds
+   */
+  template <typename Predicate>
+  bool waitFor(Predicate predicate) {
+    for (auto deadline = std::chrono::steady_clock::now() + 10s;
+         std::chrono::steady_clock::now() < deadline;) {
+      if (predicate()) {
+        return true;
+      }
+      std::this_thread::sleep_for(10ms);
+    }
+    return predicate();
+  }
+
+  BlockingOrderingService service;
+  BlockingYacService yac_service;
+  std::promise<void> release;
+  bool released = false;
+  std::unique_ptr<grpc::Server> server;
+  std::string address;
+};
+
+/**
+ * @given async client and running server
+ * @when 3 calls are sent and completed
+ * @then statistics contain 3 calls without failures
+ *       AND every call is put into latency histogram
+ */
+TEST_F(AsyncGrpcClientTest, CompletedCallsAreCounted) {
+  releaseCalls();
+  TestClient client(address, 10);
+
+  for (size_t i = 0; i < 3; ++i) {
+    ASSERT_TRUE(client.send());
+  }
+
+  ASSERT_TRUE(
+      waitFor([&client] { return client.batchStatistics().calls == 3; }));
+  auto statistics = client.batchStatistics();
+  ASSERT_EQ(statistics.failures, 0u);
+  ASSERT_EQ(statistics.dropped, 0u);
+  ASSERT_EQ(std::accumulate(
+                statistics.latency.begin(), statistics.latency.end(), 0u),
+            3u);
+}
+
+/**
+ * @given async client with limit of 1 call in flight
+ * @when one call is not completed by server
+ * @then next call to the same peer is dropped
+ *       AND calls are sent again after the first one is completed
+ */
+TEST_F(AsyncGrpcClientTest, InFlightLimitIsRespected) {
+  TestClient client(address, 1);
+
+  ASSERT_TRUE(client.send());
+  ASSERT_TRUE(waitFor([this] { return service.received == 1; }));
+
+  ASSERT_FALSE(client.send());
+  ASSERT_EQ(client.batchStatistics().dropped, 1u);
+
+  releaseCalls();
+  ASSERT_TRUE(
+      waitFor([&client] { return client.batchStatistics().calls == 1; }));
+  ASSERT_TRUE(client.send());
+}
+
+/**
+ * @given async client and unreachable peer
+ * @when call is sent
+ * @then call is completed as failed
+ */
+TEST_F(AsyncGrpcClientTest, FailedCallsAreCounted) {
+  server->Shutdown();
+  TestClient client(address, 10);
+
+  ASSERT_TRUE(client.send());
+
+  ASSERT_TRUE(
+      waitFor([&client] { return client.batchStatistics().calls == 1; }));
+  ASSERT_EQ(client.batchStatistics().failures, 1u);
+}
+
+/**
+ * @given YAC network with limit of 1 call in flight to a peer
+ * @when a vote is not completed by the peer
+ * @then next vote to the peer is dropped
+ *       AND commit and reject are sent regardless of the limit
+ */
+TEST_F(AsyncGrpcClientTest, YacCommitAndRejectAreNotDropped) {
+  using namespace iroha::consensus::yac;
+  NetworkImpl network(1);
+  auto peer = shared_model::proto::PeerBuilder()
+                  .address(address)
+                  .pubkey(shared_model::interface::types::PubkeyType(
+                      std::string(32, '0')))
+                  .build();
+  VoteMessage vote;
+  vote.hash.proposal_hash = "proposal";
+  vote.hash.block_hash = "block";
+
+  network.send_vote(peer, vote);
+  ASSERT_TRUE(waitFor([this] { return yac_service.votes == 1; }));
+
+  network.send_vote(peer, vote);
+  network.send_commit(peer, CommitMessage(std::vector<VoteMessage>{vote}));
+  network.send_reject(peer, RejectMessage(std::vector<VoteMessage>{vote}));
+  ASSERT_TRUE(waitFor([this] {
+    return yac_service.commits == 1 and yac_service.rejects == 1;
+  }));
+
+  auto statistics = network.statistics();
+  ASSERT_EQ(statistics["vote"].dropped, 1u);
+  ASSERT_EQ(statistics["commit"].dropped, 0u);
+  ASSERT_EQ(statistics["reject"].dropped, 0u);
+
+  releaseCalls();
+  ASSERT_TRUE(waitFor(
+      [&network] { return network.statistics()["vote"].calls == 1; }));
+  ASSERT_EQ(yac_service.votes.load(), 1u);
+}
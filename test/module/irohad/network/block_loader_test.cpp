@@ -44,7 +44,7 @@ using testing::A;
 using testing::Return;
 
 using wPeer = std::shared_ptr<shared_model::interface::Peer>;
-using wBlock = std::shared_ptr<shared_model::interface::Block>;
+using wBlock = std::shared_ptr<const shared_model::interface::Block>;
 
 class BlockLoaderTest : public testing::Test {
  public:
@@ -197,9 +197,8 @@ TEST_F(BlockLoaderTest, ValidWhenBlockPresent) {
 
   EXPECT_CALL(*peer_query, getLedgerPeers())
       .WillOnce(Return(std::vector<wPeer>{peer}));
-  EXPECT_CALL(*storage, getBlocksFrom(1))
-      .WillOnce(Return(rxcpp::observable<>::just(requested).map(
-          [](auto &&x) { return wBlock(clone(x)); })));
+  EXPECT_CALL(*storage, getBlockByHashSync(requested.hash()))
+      .WillOnce(Return(boost::make_optional(wBlock(clone(requested)))));
   auto block = loader->retrieveBlock(peer_key, requested.hash());
 
   ASSERT_TRUE(block);
@@ -207,20 +206,19 @@ TEST_F(BlockLoaderTest, ValidWhenBlockPresent) {
 }
 
 /**
- * @given block loader and a block
- * @when retrieveBlock is called with a different hash
+ * @given block loader and storage without requested block
+ * @when retrieveBlock is called with its hash
  * @then nothing is returned
  */
 TEST_F(BlockLoaderTest, ValidWhenBlockMissing) {
   // Request nonexisting block => failure
-  auto present = getBaseBlockBuilder().build();
+  Hash missing(std::string(32, '0'));
 
   EXPECT_CALL(*peer_query, getLedgerPeers())
       .WillOnce(Return(std::vector<wPeer>{peer}));
-  EXPECT_CALL(*storage, getBlocksFrom(1))
-      .WillOnce(Return(rxcpp::observable<>::just(present).map(
-          [](auto &&x) { return wBlock(clone(x)); })));
-  auto block = loader->retrieveBlock(peer_key, Hash(std::string(32, '0')));
+  EXPECT_CALL(*storage, getBlockByHashSync(missing))
+      .WillOnce(Return(boost::none));
+  auto block = loader->retrieveBlock(peer_key, missing);
 
   ASSERT_FALSE(block);
 }
@@ -38,6 +38,11 @@ namespace iroha {
           propagate_transaction,
           void(std::shared_ptr<const shared_model::interface::Transaction>));
 
+      MOCK_METHOD1(
+          propagate_batch,
+          void(std::vector<
+               std::shared_ptr<const shared_model::interface::Transaction>>));
+
       MOCK_CONST_METHOD0(
           on_proposal,
           rxcpp::observable<
@@ -66,6 +71,11 @@ namespace iroha {
           void(std::shared_ptr<const shared_model::interface::Transaction>
                    transaction));
 
+      MOCK_METHOD1(
+          propagateBatch,
+          void(std::vector<
+               std::shared_ptr<const shared_model::interface::Transaction>>));
+
       MOCK_METHOD0(on_proposal,
                    rxcpp::observable<
                        std::shared_ptr<shared_model::interface::Proposal>>());
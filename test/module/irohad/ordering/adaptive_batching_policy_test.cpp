@@ -0,0 +1,142 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ordering/impl/adaptive_batching_policy.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace iroha::ordering;
+using namespace std::chrono_literals;
+
+class AdaptiveBatchingPolicyTest : public ::testing::Test {
+ public:
+  /**
+   * Report arrival of count transactions during each of rounds intervals
+   */
+  void load(size_t count, std::chrono::milliseconds interval, size_t rounds) {
+    for (size_t i = 0; i < rounds; ++i) {
+      policy.onTransactions(count);
+      now += interval;
+      policy.sample(now);
+    }
+  }
+
+  /**
+   * Report proposal which is committed after latency
+   */
+  void commit(std::chrono::milliseconds latency) {
+    policy.onPublish(now);
+    now += latency;
+    policy.onCommit(now);
+  }
+
+  AdaptiveBatchingPolicy::Clock::time_point now =
+      AdaptiveBatchingPolicy::Clock::now();
+  AdaptiveBatchingPolicy::Bounds bounds{1, 100, 10ms, 1000ms};
+  AdaptiveBatchingPolicy policy{bounds, now};
+};
+
+/**
+ * @given policy without observations
+ * @when proposal size and delay are requested
+ * @then minimal size and maximal delay are returned
+ */
+TEST_F(AdaptiveBatchingPolicyTest, InitialState) {
+  ASSERT_EQ(1u, policy.proposalSize());
+  ASSERT_EQ(1000ms, policy.proposalDelay());
+}
+
+/**
+ * @given policy with long commit latency
+ * @when transactions arrive rarely
+ * @then proposal is emitted for each transaction
+ */
+TEST_F(AdaptiveBatchingPolicyTest, LowLoad) {
+  commit(500ms);
+  load(1, 1000ms, 10);
+
+  ASSERT_EQ(1u, policy.proposalSize());
+}
+
+/**
+ * @given policy with long commit latency
+ * @when transactions arrive faster than proposals are committed
+ * @then proposal size is maximal, and delay is minimal
+ */
+TEST_F(AdaptiveBatchingPolicyTest, HighLoad) {
+  for (size_t i = 0; i < 10; ++i) {
+    commit(500ms);
+  }
+  load(10000, 100ms, 10);
+
+  ASSERT_EQ(100u, policy.proposalSize());
+  ASSERT_EQ(10ms, policy.proposalDelay());
+}
+
+/**
+ * @given policy with commit latency 100 ms
+ * @when transactions arrive with rate 1 tx/ms
+ * @then proposal size is the number of transactions during commit, and delay
+ * is the time to collect them
+ */
+TEST_F(AdaptiveBatchingPolicyTest, ModerateLoad) {
+  for (size_t i = 0; i < 50; ++i) {
+    commit(100ms);
+  }
+  load(100, 100ms, 50);
+
+  ASSERT_EQ(100u, policy.proposalSize());
+  ASSERT_EQ(100ms, policy.proposalDelay());
+
+  for (size_t i = 0; i < 50; ++i) {
+    commit(50ms);
+  }
+
+  ASSERT_EQ(50u, policy.proposalSize());
+  ASSERT_EQ(50ms, policy.proposalDelay());
+}
+
+/**
+ * @given policy
+ * @when commit is reported without published proposal
+ * @then the commit is ignored
+ */
+TEST_F(AdaptiveBatchingPolicyTest, CommitWithoutProposal) {
+  load(100, 100ms, 50);
+  policy.onCommit(now + 10s);
+
+  ASSERT_EQ(1u, policy.proposalSize());
+}
+
+/**
+ * @given policy with equal lower and upper bounds
+ * @when any load is observed
+ * @then proposal size and delay are fixed
+ */
+TEST_F(AdaptiveBatchingPolicyTest, FixedBounds) {
+  AdaptiveBatchingPolicy fixed({5, 5, 400ms, 400ms}, now);
+  for (size_t i = 0; i < 10; ++i) {
+    fixed.onPublish(now);
+    fixed.onTransactions(10000);
+    now += 100ms;
+    fixed.onCommit(now);
+    fixed.sample(now);
+  }
+
+  ASSERT_EQ(5u, fixed.proposalSize());
+  ASSERT_EQ(400ms, fixed.proposalDelay());
+}
@@ -35,6 +35,8 @@ using namespace framework::test_subscriber;
 using namespace std::chrono_literals;
 
 using ::testing::_;
+using ::testing::AtLeast;
+using ::testing::Invoke;
 using ::testing::InvokeWithoutArgs;
 using ::testing::Return;
 
@@ -45,6 +47,10 @@ class MockOrderingGateTransportGrpcService
                ::grpc::Status(::grpc::ServerContext *,
                               const iroha::protocol::Transaction *,
                               ::google::protobuf::Empty *));
+  MOCK_METHOD3(onBatch,
+               ::grpc::Status(::grpc::ServerContext *,
+                              const proto::TxBatch *,
+                              ::google::protobuf::Empty *));
 };
 
 class MockOrderingGateTransport : public OrderingGateTransport {
@@ -52,6 +58,10 @@ class MockOrderingGateTransport : public OrderingGateTransport {
   MOCK_METHOD1(
       propagateTransaction,
       void(std::shared_ptr<const shared_model::interface::Transaction>));
+  MOCK_METHOD1(
+      propagateBatch,
+      void(std::vector<
+           std::shared_ptr<const shared_model::interface::Transaction>>));
 };
 
 class OrderingGateTest : public ::testing::Test {
@@ -106,14 +116,15 @@ class OrderingGateTest : public ::testing::Test {
 /**
  * @given Initialized OrderingGate
  * @when  Send 5 transactions to Ordering Gate
- * @then  Check that transactions are received
+ * @then  Check that transactions are received in batches
  */
 TEST_F(OrderingGateTest, TransactionReceivedByServerWhenSent) {
-  size_t call_count = 0;
-  EXPECT_CALL(*fake_service, onTransaction(_, _, _))
-      .Times(5)
-      .WillRepeatedly(InvokeWithoutArgs([&] {
-        ++call_count;
+  std::atomic<size_t> tx_count{0};
+  EXPECT_CALL(*fake_service, onTransaction(_, _, _)).Times(0);
+  EXPECT_CALL(*fake_service, onBatch(_, _, _))
+      .Times(AtLeast(1))
+      .WillRepeatedly(Invoke([&](auto, auto batch, auto) {
+        tx_count += batch->transactions_size();
         cv.notify_one();
         return grpc::Status::OK;
       }));
@@ -125,7 +136,35 @@ TEST_F(OrderingGateTest, TransactionReceivedByServerWhenSent) {
   }
 
   std::unique_lock<std::mutex> lock(m);
-  cv.wait_for(lock, 10s, [&] { return call_count == 5; });
+  cv.wait_for(lock, 10s, [&] { return tx_count == 5; });
+  ASSERT_EQ(tx_count.load(), 5u);
+}
+
+/**
+ * @given Initialized OrderingGate
+ * @when  Send batch of 5 transactions to Ordering Gate
+ * @then  Check that the batch is received with single call
+ */
+TEST_F(OrderingGateTest, BatchReceivedByServerWhenSent) {
+  std::atomic<size_t> tx_count{0};
+  EXPECT_CALL(*fake_service, onBatch(_, _, _))
+      .WillOnce(Invoke([&](auto, auto batch, auto) {
+        tx_count += batch->transactions_size();
+        cv.notify_one();
+        return grpc::Status::OK;
+      }));
+
+  std::vector<std::shared_ptr<const shared_model::interface::Transaction>>
+      batch;
+  for (size_t i = 0; i < 5; ++i) {
+    batch.push_back(std::make_shared<shared_model::proto::Transaction>(
+        TestTransactionBuilder().txCounter(i + 1).build()));
+  }
+  gate_impl->propagateBatch(std::move(batch));
+
+  std::unique_lock<std::mutex> lock(m);
+  cv.wait_for(lock, 10s, [&] { return tx_count == 5; });
+  ASSERT_EQ(tx_count.load(), 5u);
 }
 
 /**
@@ -224,3 +263,49 @@ TEST(OrderingGateQueueBehaviour, SendManyProposals) {
 
   ASSERT_TRUE(wrapper_after.validate());
 }
+
+/**
+ * @given OrderingGate in pipelined mode
+ *        AND MockPeerCommunicationService
+ * @when  Send three proposals
+ *        AND one commit in node
+ * @then  Check that two rounds are sent before commit
+ *        AND the third round appears after commit
+ */
+TEST(OrderingGateQueueBehaviour, PipelinedSendsTwoRoundsBeforeCommit) {
+  std::shared_ptr<OrderingGateTransport> transport =
+      std::make_shared<MockOrderingGateTransport>();
+
+  std::shared_ptr<MockPeerCommunicationService> pcs =
+      std::make_shared<MockPeerCommunicationService>();
+  rxcpp::subjects::subject<Commit> commit_subject;
+  EXPECT_CALL(*pcs, on_commit())
+      .WillOnce(Return(commit_subject.get_observable()));
+
+  OrderingGateImpl ordering_gate(transport, true);
+  ordering_gate.setPcs(*pcs);
+
+  auto wrapper_before =
+      make_test_subscriber<CallExact>(ordering_gate.on_proposal(), 2);
+  wrapper_before.subscribe();
+  auto wrapper_after =
+      make_test_subscriber<CallExact>(ordering_gate.on_proposal(), 3);
+  wrapper_after.subscribe();
+
+  for (size_t i = 0; i < 3; ++i) {
+    ordering_gate.onProposal(std::make_shared<shared_model::proto::Proposal>(
+        TestProposalBuilder()
+            .height(i + 2)
+            .createdTime(iroha::time::now())
+            .build()));
+  }
+
+  ASSERT_TRUE(wrapper_before.validate());
+
+  std::shared_ptr<shared_model::interface::Block> block =
+      std::make_shared<shared_model::proto::Block>(TestBlockBuilder().build());
+
+  commit_subject.get_subscriber().on_next(rxcpp::observable<>::just(block));
+
+  ASSERT_TRUE(wrapper_after.validate());
+}
@@ -210,6 +210,47 @@ TEST_F(OrderingServiceTest, ValidWhenTimerStrategy) {
   cv.wait_for(lk, 10s);
 }
 
+/**
+ * @given Ordering service with proposal size 5
+ * @when batch of 10 transactions is received with single onBatch call
+ * @then 2 proposals are published
+ */
+TEST_F(OrderingServiceTest, ValidWhenBatchReceived) {
+  const size_t max_proposal = 5;
+  const size_t commit_delay = 1000;
+
+  EXPECT_CALL(*fake_persistent_state, saveProposalHeight(_))
+      .Times(2)
+      .WillRepeatedly(Return(true));
+  EXPECT_CALL(*fake_persistent_state, loadProposalHeight())
+      .Times(1)
+      .WillOnce(Return(boost::optional<size_t>(2)));
+
+  auto ordering_service = std::make_shared<OrderingServiceImpl>(
+      wsv, max_proposal, commit_delay, fake_transport, fake_persistent_state);
+  fake_transport->subscribe(ordering_service);
+
+  size_t call_count = 0;
+  EXPECT_CALL(*fake_transport, publishProposalProxy(_, _))
+      .Times(2)
+      .WillRepeatedly(InvokeWithoutArgs([&] {
+        ++call_count;
+        cv.notify_one();
+      }));
+
+  EXPECT_CALL(*wsv, getLedgerPeers())
+      .WillRepeatedly(Return(std::vector<decltype(peer)>{peer}));
+
+  std::vector<std::shared_ptr<shared_model::interface::Transaction>> batch;
+  for (size_t i = 0; i < 10; ++i) {
+    batch.push_back(getTx());
+  }
+  ordering_service->onBatch(std::move(batch));
+
+  std::unique_lock<std::mutex> lock(m);
+  cv.wait_for(lock, 10s, [&] { return call_count == 2; });
+}
+
 /**
  * @given Ordering service and the persistent state that cannot save proposals
  * @when onTransaction is called
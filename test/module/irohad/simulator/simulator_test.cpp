@@ -35,11 +35,13 @@ using namespace iroha::network;
 using namespace framework::test_subscriber;
 
 using ::testing::A;
+using ::testing::Invoke;
+using ::testing::NiceMock;
 using ::testing::Return;
 using ::testing::ReturnArg;
 using ::testing::_;
 
-using wBlock = std::shared_ptr<shared_model::interface::Block>;
+using wBlock = std::shared_ptr<const shared_model::interface::Block>;
 
 class SimulatorTest : public ::testing::Test {
  public:
@@ -238,3 +240,126 @@ TEST_F(SimulatorTest, FailWhenSameAsProposalHeight) {
   ASSERT_TRUE(proposal_wrapper.validate());
   ASSERT_TRUE(block_wrapper.validate());
 }
+
+/**
+ * Create temporary wsv which accepts everything
+ */
+expected::Result<std::unique_ptr<TemporaryWsv>, std::string>
+makeTemporaryWsv() {
+  return expected::makeValue(std::unique_ptr<TemporaryWsv>(
+      std::make_unique<NiceMock<MockTemporaryWsv>>()));
+}
+
+/**
+ * @given pipelined simulator
+ * @when proposal arrives while the previous block is not committed
+ *       AND the previous block is committed
+ * @then the proposal is validated on top of the previous block
+ *       AND block is created only after commit, on top of committed block
+ */
+TEST_F(SimulatorTest, PipelinedProposalReleasedWhenPendingBlockCommitted) {
+  auto proposal2 = std::make_shared<shared_model::proto::Proposal>(
+      makeProposal(2));
+  auto proposal3 = std::make_shared<shared_model::proto::Proposal>(
+      makeProposal(3));
+  wBlock top_block = wBlock(clone(makeBlock(1)));
+
+  EXPECT_CALL(*query, getTopBlocks(1)).WillRepeatedly(Invoke([&top_block] {
+    return rxcpp::observable<>::just(top_block);
+  }));
+  EXPECT_CALL(*factory, createTemporaryWsv())
+      .Times(2)
+      .WillRepeatedly(Invoke(makeTemporaryWsv));
+  EXPECT_CALL(*validator, validate(_, _))
+      .WillOnce(Return(proposal2))
+      .WillOnce(Return(proposal3));
+  EXPECT_CALL(*ordering_gate, on_proposal())
+      .WillOnce(Return(rxcpp::observable<>::empty<
+                       std::shared_ptr<shared_model::interface::Proposal>>()));
+  EXPECT_CALL(*shared_model::crypto::crypto_signer_expecter,
+              sign(A<shared_model::interface::Block &>()))
+      .Times(2);
+
+  auto pcs = std::make_shared<MockPeerCommunicationService>();
+  rxcpp::subjects::subject<Commit> commit_subject;
+  EXPECT_CALL(*pcs, on_commit())
+      .WillOnce(Return(commit_subject.get_observable()));
+
+  simulator = std::make_shared<Simulator>(
+      ordering_gate, validator, factory, query, crypto_signer, true);
+  simulator->setPcs(*pcs);
+
+  std::vector<wBlock> blocks;
+  simulator->on_block().subscribe(
+      [&blocks](auto block) { blocks.push_back(block); });
+
+  simulator->process_proposal(*proposal2);
+  ASSERT_EQ(blocks.size(), 1u);
+
+  // block 2 is not committed, proposal 3 is held back
+  simulator->process_proposal(*proposal3);
+  ASSERT_EQ(blocks.size(), 1u);
+
+  top_block = blocks.front();
+  commit_subject.get_subscriber().on_next(rxcpp::observable<>::just(top_block));
+
+  ASSERT_EQ(blocks.size(), 2u);
+  ASSERT_EQ(blocks.back()->height(), 3u);
+  ASSERT_EQ(blocks.back()->prevHash(), blocks.front()->hash());
+}
+
+/**
+ * @given pipelined simulator
+ * @when proposal arrives while the previous block is not committed
+ *       AND other block is committed instead of the previous one
+ * @then the speculative result is discarded
+ *       AND the proposal is validated again on top of committed block
+ */
+TEST_F(SimulatorTest, PipelinedProposalRevalidatedWhenOtherBlockCommitted) {
+  auto proposal2 = std::make_shared<shared_model::proto::Proposal>(
+      makeProposal(2));
+  auto proposal3 = std::make_shared<shared_model::proto::Proposal>(
+      makeProposal(3));
+  wBlock top_block = wBlock(clone(makeBlock(1)));
+
+  EXPECT_CALL(*query, getTopBlocks(1)).WillRepeatedly(Invoke([&top_block] {
+    return rxcpp::observable<>::just(top_block);
+  }));
+  EXPECT_CALL(*factory, createTemporaryWsv())
+      .Times(3)
+      .WillRepeatedly(Invoke(makeTemporaryWsv));
+  EXPECT_CALL(*validator, validate(_, _))
+      .WillOnce(Return(proposal2))
+      .WillRepeatedly(Return(proposal3));
+  EXPECT_CALL(*ordering_gate, on_proposal())
+      .WillOnce(Return(rxcpp::observable<>::empty<
+                       std::shared_ptr<shared_model::interface::Proposal>>()));
+  EXPECT_CALL(*shared_model::crypto::crypto_signer_expecter,
+              sign(A<shared_model::interface::Block &>()))
+      .Times(2);
+
+  auto pcs = std::make_shared<MockPeerCommunicationService>();
+  rxcpp::subjects::subject<Commit> commit_subject;
+  EXPECT_CALL(*pcs, on_commit())
+      .WillOnce(Return(commit_subject.get_observable()));
+
+  simulator = std::make_shared<Simulator>(
+      ordering_gate, validator, factory, query, crypto_signer, true);
+  simulator->setPcs(*pcs);
+
+  std::vector<wBlock> blocks;
+  simulator->on_block().subscribe(
+      [&blocks](auto block) { blocks.push_back(block); });
+
+  simulator->process_proposal(*proposal2);
+  simulator->process_proposal(*proposal3);
+  ASSERT_EQ(blocks.size(), 1u);
+
+  // other block with height 2 is committed
+  top_block = wBlock(clone(makeBlock(2)));
+  commit_subject.get_subscriber().on_next(rxcpp::observable<>::just(top_block));
+
+  ASSERT_EQ(blocks.size(), 2u);
+  ASSERT_EQ(blocks.back()->height(), 3u);
+  ASSERT_EQ(blocks.back()->prevHash(), top_block->hash());
+}
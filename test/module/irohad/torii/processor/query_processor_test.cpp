@@ -93,7 +93,9 @@ TEST_F(QueryProcessorTest, QueryProcessorWhereInvokeInvalidQuery) {
   std::vector<std::string> roles = {role};
   std::vector<std::string> perms = {iroha::model::can_get_my_account};
 
-  EXPECT_CALL(*storage, getWsvQuery()).WillRepeatedly(Return(wsv_queries));
+  EXPECT_CALL(*storage, getWsvQuery())
+      .WillRepeatedly(Return(
+          boost::make_optional<std::shared_ptr<WsvQuery>>(wsv_queries)));
   EXPECT_CALL(*storage, getBlockQuery()).WillRepeatedly(Return(block_queries));
   EXPECT_CALL(*wsv_queries, getAccount(account_id))
       .WillOnce(Return(shared_account));
@@ -149,7 +151,9 @@ TEST_F(QueryProcessorTest, QueryProcessorWithWrongKey) {
   std::vector<std::string> roles = {role};
   std::vector<std::string> perms = {iroha::model::can_get_my_account};
 
-  EXPECT_CALL(*storage, getWsvQuery()).WillRepeatedly(Return(wsv_queries));
+  EXPECT_CALL(*storage, getWsvQuery())
+      .WillRepeatedly(Return(
+          boost::make_optional<std::shared_ptr<WsvQuery>>(wsv_queries)));
   EXPECT_CALL(*storage, getBlockQuery()).WillRepeatedly(Return(block_queries));
   EXPECT_CALL(*wsv_queries, getSignatories(account_id))
       .WillRepeatedly(Return(signatories));
@@ -166,3 +170,36 @@ TEST_F(QueryProcessorTest, QueryProcessorWithWrongKey) {
       std::make_shared<shared_model::proto::Query>(query.getTransport()));
   ASSERT_TRUE(wrapper.validate());
 }
+
+/**
+ * @given storage without available database connections
+ * @when query is handled
+ * @then Query Processor should return StatefulFailed
+ */
+TEST_F(QueryProcessorTest, QueryProcessorWithoutWsvQuery) {
+  auto storage = std::make_shared<MockStorage>();
+
+  iroha::torii::QueryProcessorImpl qpi(storage);
+
+  auto query = TestUnsignedQueryBuilder()
+                   .createdTime(created_time)
+                   .creatorAccountId(account_id)
+                   .getAccount(account_id)
+                   .queryCounter(counter)
+                   .build()
+                   .signAndAddSignature(keypair);
+
+  EXPECT_CALL(*storage, getWsvQuery()).WillRepeatedly(Return(boost::none));
+
+  auto wrapper = make_test_subscriber<CallExact>(qpi.queryNotifier(), 1);
+  wrapper.subscribe([](auto response) {
+    auto resp = boost::get<shared_model::detail::PolymorphicWrapper<
+        shared_model::interface::ErrorQueryResponse>>(response->get());
+    ASSERT_NO_THROW(boost::get<shared_model::detail::PolymorphicWrapper<
+                        shared_model::interface::StatefulFailedErrorResponse>>(
+        resp->get()));
+  });
+  qpi.queryHandle(
+      std::make_shared<shared_model::proto::Query>(query.getTransport()));
+  ASSERT_TRUE(wrapper.validate());
+}
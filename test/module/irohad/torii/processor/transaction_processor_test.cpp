@@ -32,6 +32,7 @@ using namespace framework::test_subscriber;
 
 using ::testing::_;
 using ::testing::Return;
+using ::testing::SizeIs;
 
 class TransactionProcessorTest : public ::testing::Test {
  public:
@@ -93,6 +94,33 @@ class TransactionProcessorTest : public ::testing::Test {
   const size_t block_size = 3;
 };
 
+/**
+ * @given transaction processor
+ * @when list of transactions is passed to processor
+ * @then the whole list is propagated to peer communication service at once
+ */
+TEST_F(TransactionProcessorTest, TransactionProcessorBatchHandleTest) {
+  std::vector<std::shared_ptr<shared_model::interface::Transaction>> txs;
+  for (size_t i = 0; i < proposal_size; i++) {
+    auto &&tx = shared_model::proto::TransactionBuilder()
+                    .txCounter(i + 1)
+                    .createdTime(iroha::time::now())
+                    .creatorAccountId("admin@ru")
+                    .addAssetQuantity("admin@tu", "coin#coin", "1.0")
+                    .build()
+                    .signAndAddSignature(
+                        shared_model::crypto::DefaultCryptoAlgorithmType::
+                            generateKeypair());
+    txs.push_back(
+        std::shared_ptr<shared_model::interface::Transaction>(clone(tx)));
+  }
+
+  EXPECT_CALL(*pcs, propagate_transaction(_)).Times(0);
+  EXPECT_CALL(*pcs, propagate_batch(SizeIs(proposal_size))).Times(1);
+
+  tp->batchHandle(txs);
+}
+
 /**
  * @given transaction processor
  * @when transactions passed to processor compose proposal which is sent to peer
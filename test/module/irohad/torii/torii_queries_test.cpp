@@ -63,7 +63,9 @@ class ToriiQueriesTest : public testing::Test {
 
     auto qpi = std::make_shared<iroha::torii::QueryProcessorImpl>(storage);
 
-    EXPECT_CALL(*storage, getWsvQuery()).WillRepeatedly(Return(wsv_query));
+    EXPECT_CALL(*storage, getWsvQuery())
+        .WillRepeatedly(Return(
+            boost::make_optional<std::shared_ptr<WsvQuery>>(wsv_query)));
     EXPECT_CALL(*storage, getBlockQuery()).WillRepeatedly(Return(block_query));
 
     //----------- Server run ----------------
@@ -484,7 +486,7 @@ TEST_F(ToriiQueriesTest, FindTransactionsWhenValid) {
   EXPECT_CALL(*wsv_query, getAccountRoles(creator)).WillOnce(Return(roles));
   std::vector<std::string> perm = {iroha::model::can_get_my_acc_txs};
   EXPECT_CALL(*wsv_query, getRolePermissions("test")).WillOnce(Return(perm));
-  EXPECT_CALL(*block_query, getAccountTransactions(creator))
+  EXPECT_CALL(*block_query, getAccountTransactions(creator, _))
       .WillOnce(Return(txs_observable));
 
   iroha::protocol::QueryResponse response;
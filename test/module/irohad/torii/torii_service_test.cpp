@@ -58,6 +58,10 @@ class CustomPeerCommunicationServiceMock : public PeerCommunicationService {
       std::shared_ptr<const shared_model::interface::Transaction> transaction)
       override {}
 
+  void propagate_batch(
+      std::vector<std::shared_ptr<const shared_model::interface::Transaction>>
+          transactions) override {}
+
   rxcpp::observable<std::shared_ptr<shared_model::interface::Proposal>>
   on_proposal() const override {
     return prop_notifier_.get_observable();
@@ -295,6 +299,47 @@ TEST_F(ToriiServiceTest, StatusWhenBlocking) {
             iroha::protocol::TxStatus::STATEFUL_VALIDATION_FAILED);
 }
 
+/**
+ * @given torii service and a list of transactions
+ * @when sending the list via ListTorii
+ * @then ListTorii returns ok status
+ *       AND every transaction of the list passes stateless validation
+ */
+TEST_F(ToriiServiceTest, ListToriiBlocking) {
+  iroha::protocol::TxList tx_list;
+  std::vector<std::string> tx_hashes;
+
+  // create transactions and put them into the list
+  std::string account_id = "some@account";
+  for (size_t i = 0; i < TimesToriiBlocking; ++i) {
+    auto shm_tx = shared_model::proto::TransactionBuilder()
+                      .creatorAccountId(account_id)
+                      .txCounter(i + 1)
+                      .createdTime(iroha::time::now())
+                      .setAccountQuorum(account_id, 2)
+                      .build()
+                      .signAndAddSignature(
+                          shared_model::crypto::DefaultCryptoAlgorithmType::
+                              generateKeypair());
+    *tx_list.add_transactions() = shm_tx.getTransport();
+    tx_hashes.push_back(shared_model::crypto::toBinaryString(shm_tx.hash()));
+  }
+
+  auto client = torii::CommandSyncClient(Ip, Port);
+  ASSERT_TRUE(client.ListTorii(tx_list).ok());
+
+  // check if stateless validation passed
+  for (const auto &hash : tx_hashes) {
+    iroha::protocol::TxStatusRequest tx_request;
+    tx_request.set_tx_hash(hash);
+    iroha::protocol::ToriiResponse toriiResponse;
+    client.Status(tx_request, toriiResponse);
+
+    ASSERT_EQ(toriiResponse.tx_status(),
+              iroha::protocol::TxStatus::STATELESS_VALIDATION_SUCCESS);
+  }
+}
+
 /**
  * @given torii service and some number of transactions with hashes
  * @when sending request on this txs
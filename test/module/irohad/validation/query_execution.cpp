@@ -788,7 +788,7 @@ TEST_F(GetAccountTransactionsTest, MyAccountValidCase) {
 
   txs_observable = getDefaultTransactions(admin_id, N);
 
-  EXPECT_CALL(*block_query, getAccountTransactions(admin_id))
+  EXPECT_CALL(*block_query, getAccountTransactions(admin_id, _))
       .WillOnce(Return(txs_observable));
 
   auto response = validateAndExecute(query);
@@ -819,7 +819,7 @@ TEST_F(GetAccountTransactionsTest, AllAccountValidCase) {
   EXPECT_CALL(*wsv_query, getRolePermissions(admin_role))
       .WillOnce(Return(role_permissions));
 
-  EXPECT_CALL(*block_query, getAccountTransactions(account_id))
+  EXPECT_CALL(*block_query, getAccountTransactions(account_id, _))
       .WillOnce(Return(txs_observable));
 
   auto response = validateAndExecute(query);
@@ -850,7 +850,7 @@ TEST_F(GetAccountTransactionsTest, DomainAccountValidCase) {
   EXPECT_CALL(*wsv_query, getRolePermissions(admin_role))
       .WillOnce(Return(role_permissions));
 
-  EXPECT_CALL(*block_query, getAccountTransactions(account_id))
+  EXPECT_CALL(*block_query, getAccountTransactions(account_id, _))
       .WillOnce(Return(txs_observable));
 
   auto response = validateAndExecute(query);
@@ -885,7 +885,7 @@ TEST_F(GetAccountTransactionsTest, GrantAccountValidCase) {
       hasAccountGrantablePermission(admin_id, account_id, can_get_my_acc_txs))
       .WillOnce(Return(true));
 
-  EXPECT_CALL(*block_query, getAccountTransactions(account_id))
+  EXPECT_CALL(*block_query, getAccountTransactions(account_id, _))
       .WillOnce(Return(txs_observable));
 
   auto response = validateAndExecute(query);
@@ -947,7 +947,7 @@ TEST_F(GetAccountTransactionsTest, NoAccountExist) {
   EXPECT_CALL(*wsv_query, getRolePermissions(admin_role))
       .WillOnce(Return(role_permissions));
 
-  EXPECT_CALL(*block_query, getAccountTransactions("none"))
+  EXPECT_CALL(*block_query, getAccountTransactions("none", _))
       .WillOnce(Return(rxcpp::observable<>::empty<wTransaction>()));
 
   auto response = validateAndExecute(query);
@@ -986,7 +986,8 @@ TEST_F(GetAccountAssetsTransactionsTest, MyAccountValidCase) {
 
   txs_observable = getDefaultTransactions(admin_id, N);
 
-  EXPECT_CALL(*block_query, getAccountAssetTransactions(admin_id, asset_id))
+  EXPECT_CALL(*block_query,
+              getAccountAssetTransactions(admin_id, asset_id, _))
       .WillOnce(Return(txs_observable));
 
   auto response = validateAndExecute(query);
@@ -1017,7 +1018,8 @@ TEST_F(GetAccountAssetsTransactionsTest, AllAccountValidCase) {
   EXPECT_CALL(*wsv_query, getRolePermissions(admin_role))
       .WillOnce(Return(role_permissions));
 
-  EXPECT_CALL(*block_query, getAccountAssetTransactions(account_id, asset_id))
+  EXPECT_CALL(*block_query,
+              getAccountAssetTransactions(account_id, asset_id, _))
       .WillOnce(Return(txs_observable));
 
   auto response = validateAndExecute(query);
@@ -1048,7 +1050,8 @@ TEST_F(GetAccountAssetsTransactionsTest, DomainAccountValidCase) {
   EXPECT_CALL(*wsv_query, getRolePermissions(admin_role))
       .WillOnce(Return(role_permissions));
 
-  EXPECT_CALL(*block_query, getAccountAssetTransactions(account_id, asset_id))
+  EXPECT_CALL(*block_query,
+              getAccountAssetTransactions(account_id, asset_id, _))
       .WillOnce(Return(txs_observable));
 
   auto response = validateAndExecute(query);
@@ -1083,7 +1086,8 @@ TEST_F(GetAccountAssetsTransactionsTest, GrantAccountValidCase) {
                   admin_id, account_id, can_get_my_acc_ast_txs))
       .WillOnce(Return(true));
 
-  EXPECT_CALL(*block_query, getAccountAssetTransactions(account_id, asset_id))
+  EXPECT_CALL(*block_query,
+              getAccountAssetTransactions(account_id, asset_id, _))
       .WillOnce(Return(txs_observable));
 
   auto response = validateAndExecute(query);
@@ -1145,7 +1149,8 @@ TEST_F(GetAccountAssetsTransactionsTest, NoAccountExist) {
   EXPECT_CALL(*wsv_query, getRolePermissions(admin_role))
       .WillOnce(Return(role_permissions));
 
-  EXPECT_CALL(*block_query, getAccountAssetTransactions("none", asset_id))
+  EXPECT_CALL(*block_query,
+              getAccountAssetTransactions("none", asset_id, _))
       .WillOnce(Return(rxcpp::observable<>::empty<wTransaction>()));
 
   auto response = validateAndExecute(query);
@@ -1171,7 +1176,8 @@ TEST_F(GetAccountAssetsTransactionsTest, NoAssetExist) {
   EXPECT_CALL(*wsv_query, getRolePermissions(admin_role))
       .WillOnce(Return(role_permissions));
 
-  EXPECT_CALL(*block_query, getAccountAssetTransactions(account_id, "none"))
+  EXPECT_CALL(*block_query,
+              getAccountAssetTransactions(account_id, "none", _))
       .WillOnce(Return(rxcpp::observable<>::empty<wTransaction>()));
 
   auto response = validateAndExecute(query);
@@ -0,0 +1,113 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "module/shared_model/builders/protobuf/test_transaction_builder.hpp"
+#include "validation/impl/transaction_scheduler.hpp"
+
+using namespace iroha::validation;
+
+using Batches = std::vector<std::vector<size_t>>;
+
+/**
+ * @given transactions which access different keys
+ * @when batches are scheduled
+ * @then all transactions are in one batch
+ */
+TEST(TransactionSchedulerTest, IndependentTransactionsInOneBatch) {
+  std::vector<AccessSet> access_sets{
+      {{"a"}, {"x"}}, {{"a"}, {"y"}}, {{"b"}, {"z"}}};
+  ASSERT_EQ(Batches({{0, 1, 2}}), scheduleBatches(access_sets));
+}
+
+/**
+ * @given transactions where later ones read or write the keys written by
+ * earlier ones
+ * @when batches are scheduled
+ * @then dependent transactions are placed into later batches
+ */
+TEST(TransactionSchedulerTest, ReadAfterWriteIsOrdered) {
+  std::vector<AccessSet> access_sets{
+      {{}, {"x"}}, {{"x"}, {"y"}}, {{}, {"z"}}, {{}, {"x"}}};
+  ASSERT_EQ(Batches({{0, 2}, {1}, {3}}), scheduleBatches(access_sets));
+}
+
+/**
+ * @given transaction which writes the key read by earlier transactions
+ * @when batches are scheduled
+ * @then writer goes after all readers
+ */
+TEST(TransactionSchedulerTest, WriteAfterReadIsOrdered) {
+  std::vector<AccessSet> access_sets{
+      {{"x"}, {}}, {{"x"}, {}}, {{}, {"x"}}, {{"x"}, {}}};
+  ASSERT_EQ(Batches({{0, 1}, {2}, {3}}), scheduleBatches(access_sets));
+}
+
+/**
+ * @given transaction which writes the whole state between independent ones
+ * @when batches are scheduled
+ * @then it is applied alone and separates earlier and later transactions
+ */
+TEST(TransactionSchedulerTest, WholeStateIsBarrier) {
+  std::vector<AccessSet> access_sets{
+      {{}, {"x"}}, {{}, {"y"}}, {{}, {kWholeState}}, {{}, {"z"}}};
+  ASSERT_EQ(Batches({{0, 1}, {2}, {3}}), scheduleBatches(access_sets));
+}
+
+/**
+ * @given transfers between disjoint pairs of accounts and a transfer which
+ * shares an account with the first one
+ * @when access sets are collected and batches are scheduled
+ * @then only the transfer sharing an account is placed into the next batch
+ */
+TEST(TransactionSchedulerTest, TransfersOfDisjointAccounts) {
+  auto transfer = [](const std::string &src, const std::string &dest) {
+    return TestTransactionBuilder()
+        .creatorAccountId(src)
+        .transferAsset(src, dest, "coin#test", "", "1.0")
+        .build();
+  };
+  std::vector<AccessSet> access_sets{
+      accessSet(transfer("a@test", "b@test")),
+      accessSet(transfer("c@test", "d@test")),
+      accessSet(transfer("b@test", "e@test"))};
+  ASSERT_EQ(Batches({{0, 1}, {2}}), scheduleBatches(access_sets));
+}
+
+/**
+ * @given signatory added to one account and removed from another one
+ * @when access sets are collected and batches are scheduled
+ * @then removal goes after addition, which keeps the shared signatory row
+ */
+TEST(TransactionSchedulerTest, SharedSignatoryIsOrdered) {
+  shared_model::interface::types::PubkeyType key(std::string(32, '1'));
+  std::vector<AccessSet> access_sets{
+      accessSet(TestTransactionBuilder()
+                    .creatorAccountId("b@test")
+                    .addSignatory("b@test", key)
+                    .build()),
+      accessSet(TestTransactionBuilder()
+                    .creatorAccountId("a@test")
+                    .removeSignatory("a@test", key)
+                    .build()),
+      accessSet(TestTransactionBuilder()
+                    .creatorAccountId("c@test")
+                    .addPeer("127.0.0.1:50541", key)
+                    .build())};
+  ASSERT_EQ(Batches({{0}, {1}, {2}}), scheduleBatches(access_sets));
+}
@@ -0,0 +1,86 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "cache/lru_cache.hpp"
+
+using namespace iroha::cache;
+
+/**
+ * @given cache with capacity 2 holding items 1 and 2
+ * @when item 1 is accessed and item 3 is added
+ * @then item 2, which is the least recently used one, is evicted
+ */
+TEST(LruCacheTest, EvictsLeastRecentlyUsed) {
+  LruCache<int, std::string> cache(2);
+  cache.addItem(1, "one");
+  cache.addItem(2, "two");
+  ASSERT_EQ(*cache.findItem(1), "one");
+
+  cache.addItem(3, "three");
+
+  ASSERT_EQ(cache.getCacheItemCount(), 2);
+  ASSERT_FALSE(cache.findItem(2));
+  ASSERT_EQ(*cache.findItem(1), "one");
+  ASSERT_EQ(*cache.findItem(3), "three");
+}
+
+/**
+ * @given cache with one item
+ * @when item with the same key is added
+ * @then value is replaced and amount of items is not changed
+ */
+TEST(LruCacheTest, ReplacesExistingItem) {
+  LruCache<int, std::string> cache(2);
+  cache.addItem(1, "one");
+  cache.addItem(1, "uno");
+
+  ASSERT_EQ(cache.getCacheItemCount(), 1);
+  ASSERT_EQ(*cache.findItem(1), "uno");
+}
+
+/**
+ * @given cache with one item
+ * @when existing and missing items are requested
+ * @then hits and misses are counted
+ */
+TEST(LruCacheTest, CountsHitsAndMisses) {
+  LruCache<int, std::string> cache(2);
+  cache.addItem(1, "one");
+
+  cache.findItem(1);
+  cache.findItem(1);
+  cache.findItem(2);
+
+  ASSERT_EQ(cache.hits(), 2);
+  ASSERT_EQ(cache.misses(), 1);
+}
+
+/**
+ * @given cache with items
+ * @when cache is cleared
+ * @then no items are found
+ */
+TEST(LruCacheTest, Clear) {
+  LruCache<int, std::string> cache(2);
+  cache.addItem(1, "one");
+  cache.clear();
+
+  ASSERT_EQ(cache.getCacheItemCount(), 0);
+  ASSERT_FALSE(cache.findItem(1));
+}
@@ -0,0 +1,92 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <set>
+
+#include "timer/executor.hpp"
+
+using namespace std::chrono_literals;
+
+/**
+ * @given executor
+ * @when tasks are submitted and the executor is destroyed
+ * @then all of the tasks are executed
+ */
+TEST(ExecutorTest, AllTasksAreExecuted) {
+  std::atomic<int> executed(0);
+  {
+    iroha::timer::Executor executor(4, 2);
+    for (auto i = 0; i < 100; ++i) {
+      executor.submit([&executed] { ++executed; });
+    }
+  }
+  ASSERT_EQ(100, executed);
+}
+
+/**
+ * @given executor with several workers
+ * @when blocking tasks are submitted
+ * @then they are executed by different threads
+ */
+TEST(ExecutorTest, TasksAreExecutedInParallel) {
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  {
+    iroha::timer::Executor executor(2, 2);
+    for (auto i = 0; i < 2; ++i) {
+      executor.submit([&] {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          threads.insert(std::this_thread::get_id());
+        }
+        std::this_thread::sleep_for(100ms);
+      });
+    }
+  }
+  ASSERT_EQ(2u, threads.size());
+}
+
+/**
+ * @given executor with a single worker and queue of one task
+ * @when worker is busy and the queue is full
+ * @then submission waits until a task is taken from the queue
+ */
+TEST(ExecutorTest, SubmitWaitsForFreeSlot) {
+  std::atomic<bool> released(false);
+  iroha::timer::Executor executor(1, 1);
+  executor.submit([&released] {
+    while (not released) {
+      std::this_thread::sleep_for(1ms);
+    }
+  });
+  // fills the queue either now or as soon as the first task is taken
+  executor.submit([] {});
+
+  std::atomic<bool> submitted(false);
+  std::thread submitter([&] {
+    executor.submit([] {});
+    submitted = true;
+  });
+  std::this_thread::sleep_for(50ms);
+  ASSERT_FALSE(submitted);
+
+  released = true;
+  submitter.join();
+  ASSERT_TRUE(submitted);
+}
@@ -0,0 +1,132 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2018 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "timer/timer_wheel.hpp"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <future>
+
+using namespace iroha::timer;
+using namespace std::chrono_literals;
+
+class TimerWheelTest : public ::testing::Test {
+ public:
+  std::shared_ptr<Executor> executor = std::make_shared<Executor>(2);
+  TimerWheel wheel{executor};
+};
+
+/**
+ * @given timer wheel
+ * @when task is scheduled
+ * @then it is run not earlier than after the delay
+ */
+TEST_F(TimerWheelTest, TaskRunsAfterDelay) {
+  std::promise<TimerWheel::Clock::time_point> fired;
+  auto start = TimerWheel::Clock::now();
+  wheel.schedule(50ms, [&] { fired.set_value(TimerWheel::Clock::now()); });
+
+  auto future = fired.get_future();
+  ASSERT_EQ(std::future_status::ready, future.wait_for(5s));
+  ASSERT_GE(future.get() - start, 50ms);
+}
+
+/**
+ * @given timer wheel
+ * @when tasks with delays from different levels of the wheel are scheduled
+ * @then they are run in order of expiration
+ */
+TEST_F(TimerWheelTest, TasksRunInOrder) {
+  std::mutex mutex;
+  std::vector<int> order;
+  std::promise<void> done;
+  auto append = [&](int value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    order.push_back(value);
+    if (order.size() == 4) {
+      done.set_value();
+    }
+  };
+
+  wheel.schedule(300ms, [&] { append(4); });
+  wheel.schedule(5ms, [&] { append(1); });
+  wheel.schedule(150ms, [&] { append(3); });
+  wheel.schedule(70ms, [&] { append(2); });
+
+  ASSERT_EQ(std::future_status::ready, done.get_future().wait_for(5s));
+  ASSERT_EQ((std::vector<int>{1, 2, 3, 4}), order);
+}
+
+/**
+ * @given timer wheel with scheduled task
+ * @when the timer is cancelled before expiration
+ * @then the task is not run
+ */
+TEST_F(TimerWheelTest, CancelledTaskIsNotRun) {
+  std::atomic<bool> fired{false};
+  auto id = wheel.schedule(100ms, [&] { fired = true; });
+
+  ASSERT_TRUE(wheel.cancel(id));
+  ASSERT_FALSE(wheel.cancel(id));
+
+  std::this_thread::sleep_for(200ms);
+  ASSERT_FALSE(fired);
+  ASSERT_EQ(1u, wheel.statistics().cancelled);
+  ASSERT_EQ(0u, wheel.statistics().pending);
+}
+
+/**
+ * @given timer wheel with running task
+ * @when the timer is cancelled with waiting
+ * @then cancellation returns after the task is finished
+ */
+TEST_F(TimerWheelTest, CancelAndWaitForRunningTask) {
+  std::promise<void> started;
+  std::atomic<bool> finished{false};
+  auto id = wheel.schedule(1ms, [&] {
+    started.set_value();
+    std::this_thread::sleep_for(100ms);
+    finished = true;
+  });
+
+  started.get_future().wait();
+  ASSERT_FALSE(wheel.cancelAndWait(id));
+  ASSERT_TRUE(finished);
+}
+
+/**
+ * @given timer wheel
+ * @when many timers are fired
+ * @then no threads are started except the workers of executor
+ */
+TEST_F(TimerWheelTest, NoThreadPerTimer) {
+  const size_t timers = 1000;
+  std::atomic<size_t> fired{0};
+  std::promise<void> done;
+  for (size_t i = 0; i < timers; ++i) {
+    wheel.schedule(std::chrono::milliseconds(i % 20), [&] {
+      if (++fired == timers) {
+        done.set_value();
+      }
+    });
+  }
+
+  ASSERT_EQ(std::future_status::ready, done.get_future().wait_for(5s));
+  ASSERT_EQ(timers, wheel.statistics().scheduled);
+  ASSERT_EQ(timers, wheel.statistics().fired);
+  ASSERT_EQ(2u, wheel.executorStatistics().threads_started);
+}
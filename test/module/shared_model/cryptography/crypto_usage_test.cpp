@@ -104,6 +104,25 @@ TEST_F(CryptoUsageTest, RawSignAndVerifyTest) {
   ASSERT_TRUE(verified);
 }
 
+/**
+ * @given data signed with two keypairs, and a signature of other data
+ * @when signatures are verified in a batch
+ * @then validity of each signature is reported in the order of the batch
+ */
+TEST_F(CryptoUsageTest, RawBatchVerifyTest) {
+  auto other_keypair = DefaultCryptoAlgorithmType::generateKeypair();
+  auto first = DefaultCryptoAlgorithmType::sign(data, keypair);
+  auto second = DefaultCryptoAlgorithmType::sign(data, other_keypair);
+  auto wrong = DefaultCryptoAlgorithmType::sign(Blob("wrong payload"), keypair);
+
+  auto verified = CryptoVerifier<>::verifyBatch(
+      {{&first, &keypair.publicKey()},
+       {&wrong, &keypair.publicKey()},
+       {&second, &other_keypair.publicKey()}},
+      data);
+  ASSERT_EQ(std::vector<bool>({true, false, true}), verified);
+}
+
 /**
  * @given unsigned block
  * @when verify block